@@ -0,0 +1,316 @@
+#!/usr/bin/env python3
+"""
+Superinstructions for the SOM++ interpreter.
+
+The set of superinstructions is derived from a profile of how often sequences
+of two or three bytecodes execute. The profile is recorded with a build that
+has BYTECODE_HEATMAP enabled, which writes <benchmark>_bytecode_sequences.csv
+when the VM shuts down.
+
+    # 1. record the profile with a BYTECODE_HEATMAP build over the rebench suites
+    ./scripts/superinstructions.py record build-heatmap/SOM++ \\
+        > scripts/superinstruction_profile.csv
+
+    # 2. generate the header with the superinstructions from the profile
+    ./scripts/superinstructions.py generate scripts/superinstruction_profile.csv \\
+        > src/interpreter/Superinstructions.h
+
+Step 2 only depends on the checked-in profile, and always produces the same
+header for it.
+"""
+import argparse
+import glob
+import os
+import re
+import shlex
+import subprocess
+import sys
+
+BASE_PATH = os.path.abspath(os.path.join(os.path.dirname(__file__), ".."))
+
+# the first bytecode number that is free for superinstructions
+FIRST_SUPERINSTRUCTION = 89
+
+# Bytecodes that can be anywhere in a superinstruction. They do not call into
+# the runtime in a way that may change the frame, and their opcode is never
+# rewritten after a method is assembled. The value is the bytecode length.
+ANYWHERE = {
+    "DUP": 1,
+    "DUP_SECOND": 1,
+    "PUSH_LOCAL": 3,
+    "PUSH_LOCAL_0": 1,
+    "PUSH_LOCAL_1": 1,
+    "PUSH_LOCAL_2": 1,
+    "PUSH_SELF": 1,
+    "PUSH_ARG_1": 1,
+    "PUSH_ARG_2": 1,
+    "PUSH_FIELD": 2,
+    "PUSH_FIELD_0": 1,
+    "PUSH_FIELD_1": 1,
+    "PUSH_CONSTANT": 2,
+    "PUSH_CONSTANT_0": 1,
+    "PUSH_CONSTANT_1": 1,
+    "PUSH_CONSTANT_2": 1,
+    "PUSH_0": 1,
+    "PUSH_1": 1,
+    "PUSH_NIL": 1,
+    "POP": 1,
+    "POP_LOCAL": 3,
+    "POP_LOCAL_0": 1,
+    "POP_LOCAL_1": 1,
+    "POP_LOCAL_2": 1,
+    "POP_FIELD": 2,
+    "POP_FIELD_0": 1,
+    "POP_FIELD_1": 1,
+    "INC": 1,
+    "DEC": 1,
+    "INC_FIELD": 2,
+    "INC_FIELD_PUSH": 2,
+}
+
+# Bytecodes that can only end a superinstruction, because they may push or
+# pop frames. Normal sends are left out, since they are quickened in place.
+LAST_ONLY = {
+    "PUSH_BLOCK": 2,
+    "PUSH_GLOBAL": 2,
+    "SUPER_SEND": 3,
+    "ADD": 2,
+    "SUB": 2,
+    "MUL": 2,
+    "LT": 2,
+    "GT": 2,
+    "LE": 2,
+    "GE": 2,
+    "EQ": 2,
+    "EQ_EQ": 2,
+    "RETURN_LOCAL": 1,
+    "RETURN_NON_LOCAL": 1,
+    "RETURN_SELF": 1,
+    "RETURN_FIELD_0": 1,
+    "RETURN_FIELD_1": 1,
+    "RETURN_FIELD_2": 1,
+}
+
+# Bytecodes that allocate or call into the runtime, and thus need to be
+# followed by a GC check.
+NEEDS_GC_CHECK = {
+    "INC",
+    "PUSH_BLOCK",
+    "PUSH_GLOBAL",
+    "SUPER_SEND",
+    "ADD",
+    "SUB",
+    "MUL",
+    "LT",
+    "GT",
+    "LE",
+    "GE",
+    "EQ",
+    "EQ_EQ",
+}
+
+REBENCH_SUITES = ["macro", "micro"]
+
+
+def read_profile(path):
+    counts = {}
+    with open(path) as f:
+        for line in f:
+            line = line.strip()
+            if not line or line.startswith("#"):
+                continue
+            sequence, count = line.rsplit(",", 1)
+            key = tuple(sequence.split())
+            counts[key] = counts.get(key, 0) + int(count)
+    return counts
+
+
+def write_profile(counts, out):
+    out.write("# bytecode sequence, executions\n")
+    for key, count in sorted(counts.items(), key=lambda e: (-e[1], e[0])):
+        out.write("%s, %d\n" % (" ".join(key), count))
+
+
+def is_candidate(sequence):
+    *init, last = sequence
+    return all(bc in ANYWHERE for bc in init) and (
+        last in ANYWHERE or last in LAST_ONLY
+    )
+
+
+def select(counts, limit):
+    """Pick the sequences that save the most dispatches."""
+    assert limit < 255 - FIRST_SUPERINSTRUCTION, "255 is BC_INVALID"
+    candidates = [
+        (count * (len(seq) - 1), seq)
+        for seq, count in counts.items()
+        if is_candidate(seq) and count > 0
+    ]
+    candidates.sort(key=lambda c: (-c[0], c[1]))
+    return [seq for _, seq in candidates[:limit]]
+
+
+def length_of(bc):
+    return ANYWHERE.get(bc) or LAST_ONLY[bc]
+
+
+def define_name(sequence):
+    return "BC_" + "_".join(sequence)
+
+
+def macro(name, lines):
+    if not lines:
+        return "#define %s\n" % name
+    width = max(len("#define " + name), *(len(l) for l in lines)) + 1
+    body = ["#define " + name] + lines
+    return (
+        "\n".join(l.ljust(width) + "\\" for l in body[:-1])
+        + "\n"
+        + body[-1]
+        + "\n"
+    )
+
+
+def generate(counts, limit, profile_name, out):
+    selected = select(counts, limit)
+    # longer sequences first, so that the compiler fuses greedily
+    selected.sort(key=lambda seq: -len(seq))
+
+    out.write("#pragma once\n\n")
+    out.write("// Generated by scripts/superinstructions.py from\n")
+    out.write("// %s. Do not edit.\n\n" % profile_name)
+
+    out.write("// clang-format off\n")
+    width = max([len(define_name(s)) for s in selected] + [20]) + 1
+    for i, seq in enumerate(selected):
+        out.write(
+            "#define %s %d\n"
+            % (define_name(seq).ljust(width), FIRST_SUPERINSTRUCTION + i)
+        )
+    out.write("\n#define NUM_SUPERINSTRUCTIONS %d\n" % len(selected))
+    out.write("// clang-format on\n\n")
+
+    out.write(
+        "// the bytecodes each superinstruction combines, the first one also\n"
+        "// determines the superinstruction's length\n"
+    )
+    out.write(
+        macro(
+            "SUPERINSTRUCTION_COMPONENTS",
+            [
+                "    {%s},"
+                % ", ".join(
+                    ["BC_" + bc for bc in seq]
+                    + ["BC_INVALID"] * (3 - len(seq))
+                )
+                for seq in selected
+            ],
+        )
+    )
+    out.write("\n")
+    out.write(
+        macro(
+            "SUPERINSTRUCTION_LENGTHS",
+            ["    %d," % length_of(seq[0]) for seq in selected],
+        )
+    )
+    out.write("\n")
+    out.write(
+        macro(
+            "SUPERINSTRUCTION_NAMES",
+            ['    "%s",' % "+".join(seq) for seq in selected],
+        )
+    )
+    out.write("\n")
+    out.write(
+        macro(
+            "SUPERINSTRUCTION_LOOP_TARGETS",
+            ["    &&LABEL_%s," % define_name(seq) for seq in selected],
+        )
+    )
+    out.write("\n")
+
+    handlers = []
+    for seq in selected:
+        handlers.append("LABEL_%s:" % define_name(seq))
+        for bc in seq:
+            handlers.append("    PROLOGUE(%d);" % length_of(bc))
+            handlers.append("    OP_%s();" % bc)
+        if any(bc in NEEDS_GC_CHECK for bc in seq):
+            handlers.append("    DISPATCH_GC();")
+        else:
+            handlers.append("    DISPATCH_NOGC();")
+    out.write(macro("SUPERINSTRUCTION_HANDLERS", handlers))
+
+
+def rebench_runs():
+    """The command lines of the benchmarks in rebench.conf's suites."""
+    with open(os.path.join(BASE_PATH, "rebench.conf")) as f:
+        conf = f.read()
+
+    for suite in REBENCH_SUITES:
+        section = re.search(
+            r"^    %s:\n(.*?)(?=^    \S|\Z)" % suite, conf, re.M | re.S
+        ).group(1)
+        command = re.search(r'command: "(.*)"', section).group(1)
+        for name, settings in re.findall(
+            r"^            - (\w+):\s*\{(.*)\}", section, re.M
+        ):
+            extra = re.search(r"extra_args:\s*(\d+)", settings)
+            yield shlex.split(
+                command % {"benchmark": name, "iterations": 1}
+            ) + ([extra.group(1)] if extra else [])
+
+
+def record(som, out):
+    counts = {}
+    for args in rebench_runs():
+        print(" ".join(args), file=sys.stderr)
+        subprocess.run([som] + args, cwd=BASE_PATH, check=True)
+        # the VM names the file after the benchmark harness it ran
+        pattern = os.path.join(BASE_PATH, "**", "*_bytecode_sequences.csv")
+        for path in glob.glob(pattern, recursive=True):
+            for key, count in read_profile(path).items():
+                counts[key] = counts.get(key, 0) + count
+            os.remove(path)
+    write_profile(counts, out)
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description=__doc__, formatter_class=argparse.RawTextHelpFormatter
+    )
+    sub = parser.add_subparsers(dest="command", required=True)
+
+    rec = sub.add_parser("record", help="record a profile over rebench.conf")
+    rec.add_argument("som", help="SOM++ built with BYTECODE_HEATMAP")
+
+    merge = sub.add_parser("merge", help="merge profiles")
+    merge.add_argument("profiles", nargs="+")
+
+    gen = sub.add_parser("generate", help="generate Superinstructions.h")
+    gen.add_argument("profile")
+    gen.add_argument(
+        "--limit", type=int, default=32, help="number of superinstructions"
+    )
+
+    args = parser.parse_args()
+    if args.command == "record":
+        record(args.som, sys.stdout)
+    elif args.command == "merge":
+        counts = {}
+        for p in args.profiles:
+            for key, count in read_profile(p).items():
+                counts[key] = counts.get(key, 0) + count
+        write_profile(counts, sys.stdout)
+    else:
+        generate(
+            read_profile(args.profile),
+            args.limit,
+            os.path.relpath(os.path.abspath(args.profile), BASE_PATH),
+            sys.stdout,
+        )
+
+
+if __name__ == "__main__":
+    main()
@@ -36,8 +36,10 @@
 #include "../vm/Globals.h"
 #include "../vm/IsValidObject.h"
 #include "../vm/Symbols.h"
+#include "../vm/Universe.h"
 #include "../vmobjects/ObjectFormats.h"
 #include "../vmobjects/Signature.h"
+#include "../vmobjects/VMAssociation.h"
 #include "../vmobjects/VMMethod.h"
 #include "../vmobjects/VMSymbol.h"
 #include "MethodGenerationContext.h"
@@ -224,7 +226,9 @@ void EmitPUSHGLOBAL(MethodGenerationContext& mgenc, const Parser& parser,
     } else if (global == SymbolFor("false")) {
         EmitPUSHCONSTANT(mgenc, parser, load_ptr(falseObject));
     } else {
-        const uint8_t idx = mgenc.AddLiteralIfAbsent(global, parser);
+        // the literal is the association, which holds the global's value
+        const uint8_t idx = mgenc.AddLiteralIfAbsent(
+            Universe::GetGlobalAssociation(global), parser);
         Emit2(mgenc, BC_PUSH_GLOBAL, idx, 1);
     }
 }
@@ -321,16 +325,26 @@ void EmitSEND(MethodGenerationContext& mgenc, const Parser& parser,
     const uint8_t numArgs = Signature::GetNumberOfArguments(msg);
     const int64_t stackEffect = -numArgs + 1;  // +1 for the result
 
-    Emit2(mgenc, numArgs == 1 ? BC_SEND_1 : BC_SEND, idx, stackEffect);
+    Emit2(mgenc, SendBytecodeForArguments(numArgs), idx, stackEffect);
+}
+
+void EmitSpecialSEND(MethodGenerationContext& mgenc, const Parser& parser,
+                     uint8_t bytecode, VMSymbol* msg) {
+    assert(Signature::GetNumberOfArguments(msg) == 2);
+    const uint8_t idx = mgenc.AddLiteralIfAbsent(msg, parser);
+    Emit2(mgenc, bytecode, idx, -1);
 }
 
 void EmitSUPERSEND(MethodGenerationContext& mgenc, const Parser& parser,
                    VMSymbol* msg) {
     const uint8_t idx = mgenc.AddLiteralIfAbsent(msg, parser);
+    // a literal of its own, to cache the target, see
+    // VMMethod::GetSuperSendTarget()
+    const uint8_t targetIdx = mgenc.AddLiteral(load_ptr(nilObject), parser);
     const uint8_t numArgs = Signature::GetNumberOfArguments(msg);
     const int64_t stackEffect = -numArgs + 1;  // +1 for the result
 
-    Emit2(mgenc, BC_SUPER_SEND, idx, stackEffect);
+    Emit3(mgenc, BC_SUPER_SEND, idx, targetIdx, stackEffect);
 }
 
 void EmitRETURNSELF(MethodGenerationContext& mgenc) {
@@ -437,6 +451,13 @@ size_t EmitJumpIfGreaterWithDummyOffset(MethodGenerationContext& mgenc) {
     return idx;
 }
 
+size_t EmitJumpIfLessWithDummyOffset(MethodGenerationContext& mgenc) {
+    Emit1(mgenc, BC_JUMP_IF_LESS, 0);
+    size_t const idx = mgenc.AddBytecodeArgumentAndGetIndex(0);
+    mgenc.AddBytecodeArgument(0);
+    return idx;
+}
+
 void EmitJumpBackwardWithOffset(MethodGenerationContext& mgenc,
                                 size_t jumpOffset) {
     uint8_t const jumpBytecode =
@@ -444,6 +465,26 @@ void EmitJumpBackwardWithOffset(MethodGenerationContext& mgenc,
     Emit3(mgenc, jumpBytecode, jumpOffset & 0xFFU, jumpOffset >> 8U, 0);
 }
 
+size_t EmitLoopStartWithDummyOffset(MethodGenerationContext& mgenc,
+                                    uint8_t slot) {
+    // takes the limit, the start, and the step from the stack
+    Emit1(mgenc, BC_LOOP_START, -3);
+    size_t const idx = mgenc.AddBytecodeArgumentAndGetIndex(0);
+    mgenc.AddBytecodeArgument(0);
+    mgenc.AddBytecodeArgument(slot);
+    return idx;
+}
+
+void EmitLoopNextWithOffset(MethodGenerationContext& mgenc, size_t jumpOffset,
+                            uint8_t slot) {
+    Emit3(mgenc, BC_LOOP_NEXT, jumpOffset & 0xFFU, jumpOffset >> 8U, 0);
+    mgenc.AddBytecodeArgument(slot);
+}
+
+void EmitLoopCounter(MethodGenerationContext& mgenc, uint8_t slot) {
+    Emit2(mgenc, BC_LOOP_COUNTER, slot, 1);
+}
+
 size_t Emit3WithDummy(MethodGenerationContext& mgenc, uint8_t bytecode,
                       int64_t stackEffect) {
     mgenc.AddBytecode(bytecode, stackEffect);
@@ -66,6 +66,8 @@ void EmitSEND(MethodGenerationContext& mgenc, const Parser& parser,
               VMSymbol* msg);
 void EmitSUPERSEND(MethodGenerationContext& mgenc, const Parser& parser,
                    VMSymbol* msg);
+void EmitSpecialSEND(MethodGenerationContext& mgenc, const Parser& parser,
+                     uint8_t bytecode, VMSymbol* msg);
 void EmitRETURNSELF(MethodGenerationContext& mgenc);
 void EmitRETURNLOCAL(MethodGenerationContext& mgenc, const Parser& parser);
 void EmitRETURNNONLOCAL(MethodGenerationContext& mgenc);
@@ -82,8 +84,14 @@ size_t EmitJumpOnWithDummyOffset(MethodGenerationContext& mgenc,
                                  JumpCondition condition, bool needsPop);
 size_t EmitJumpWithDumyOffset(MethodGenerationContext& mgenc);
 size_t EmitJumpIfGreaterWithDummyOffset(MethodGenerationContext& mgenc);
+size_t EmitJumpIfLessWithDummyOffset(MethodGenerationContext& mgenc);
 void EmitJumpBackwardWithOffset(MethodGenerationContext& mgenc,
                                 size_t jumpOffset);
+size_t EmitLoopStartWithDummyOffset(MethodGenerationContext& mgenc,
+                                    uint8_t slot);
+void EmitLoopNextWithOffset(MethodGenerationContext& mgenc, size_t jumpOffset,
+                            uint8_t slot);
+void EmitLoopCounter(MethodGenerationContext& mgenc, uint8_t slot);
 size_t Emit3WithDummy(MethodGenerationContext& mgenc, uint8_t bytecode,
                       int64_t stackEffect);
 
@@ -119,6 +119,11 @@ VMClass* ClassGenerationContext::Assemble() {
     result->SetName(name);
     result->SetSuperClass(superClass);
 
+#ifdef DISPATCH_TABLES
+    resultClass->GetDispatchTable();
+    result->GetDispatchTable();
+#endif
+
     return result;
 }
 
@@ -129,4 +134,9 @@ void ClassGenerationContext::AssembleSystemClass(VMClass* systemClass) {
     VMClass* superMClass = systemClass->GetClass();
     superMClass->SetInstanceInvokables(Universe::NewArrayList(classMethods));
     superMClass->SetInstanceFields(Universe::NewArrayList(classFields));
+
+#ifdef DISPATCH_TABLES
+    superMClass->GetDispatchTable();
+    systemClass->GetDispatchTable();
+#endif
 }
@@ -38,6 +38,7 @@
 #include "../vm/Universe.h"
 #include "../vmobjects/ObjectFormats.h"
 #include "../vmobjects/Signature.h"
+#include "../vmobjects/VMAssociation.h"
 #include "../vmobjects/VMBigInteger.h"
 #include "../vmobjects/VMClass.h"
 #include "../vmobjects/VMDouble.h"
@@ -175,11 +176,11 @@ void Disassembler::dumpMethod(uint8_t* bytecodes, size_t numberOfBytecodes,
     // output bytecodes
     for (size_t bc_idx = 0; bc_idx < numberOfBytecodes;
          bc_idx += Bytecode::GetBytecodeLength(bytecodes[bc_idx])) {
-        // the bytecode.
-        uint8_t const bytecode = bytecodes[bc_idx];
+        // the bytecode, superinstructions have the operands of their first
+        uint8_t const bytecode = BaseBytecode(bytecodes[bc_idx]);
         // indent, bytecode index, bytecode mnemonic
         DebugDump("%s%4d:%s  ", indent, bc_idx,
-                  Bytecode::GetBytecodeName(bytecode));
+                  Bytecode::GetBytecodeName(bytecodes[bc_idx]));
 #ifdef BYTECODE_HEATMAP
         if (method != nullptr) {
             DebugPrint("[hits: %llu] ",
@@ -265,7 +266,8 @@ void Disassembler::dumpMethod(uint8_t* bytecodes, size_t numberOfBytecodes,
                 if (method != nullptr && printObjects) {
                     vm_oop_t cst = method->GetConstant(bc_idx);
                     if (cst != nullptr) {
-                        auto* name = static_cast<VMSymbol*>(cst);
+                        auto* name =
+                            static_cast<VMAssociation*>(cst)->GetKey();
                         if (name != nullptr) {
                             DebugPrint("(index: %d) value: %s\n",
                                        bytecodes[bc_idx + 1],
@@ -312,7 +314,24 @@ void Disassembler::dumpMethod(uint8_t* bytecodes, size_t numberOfBytecodes,
                 break;
             }
             case BC_SEND:
-            case BC_SEND_1: {
+            case BC_SEND_1:
+            case BC_SEND_2:
+            case BC_SEND_3:
+            case BC_SEND_N:
+            case BC_ADD:
+            case BC_SUB:
+            case BC_MUL:
+            case BC_LT:
+            case BC_GT:
+            case BC_LE:
+            case BC_GE:
+            case BC_EQ:
+            case BC_EQ_EQ:
+            case BC_SEND_PRIM_UNARY:
+            case BC_SEND_PRIM_BINARY:
+            case BC_SEND_GETTER:
+            case BC_SEND_SETTER:
+            case BC_SEND_METHOD: {
                 if (method != nullptr && printObjects) {
                     auto* name =
                         static_cast<VMSymbol*>(method->GetConstant(bc_idx));
@@ -328,11 +347,12 @@ void Disassembler::dumpMethod(uint8_t* bytecodes, size_t numberOfBytecodes,
                 if (method != nullptr && printObjects) {
                     auto* name =
                         static_cast<VMSymbol*>(method->GetConstant(bc_idx));
-                    DebugPrint("(index: %d) signature: %s\n",
-                               bytecodes[bc_idx + 1],
+                    DebugPrint("(index: %d, target: %d) signature: %s\n",
+                               bytecodes[bc_idx + 1], bytecodes[bc_idx + 2],
                                name->GetStdString().c_str());
                 } else {
-                    DebugPrint("(index: %d)\n", bytecodes[bc_idx + 1]);
+                    DebugPrint("(index: %d, target: %d)\n",
+                               bytecodes[bc_idx + 1], bytecodes[bc_idx + 2]);
                 }
                 break;
             }
@@ -346,6 +366,7 @@ void Disassembler::dumpMethod(uint8_t* bytecodes, size_t numberOfBytecodes,
             case BC_JUMP_ON_NOT_NIL_TOP_TOP:
             case BC_JUMP_ON_NIL_TOP_TOP:
             case BC_JUMP_IF_GREATER:
+            case BC_JUMP_IF_LESS:
             case BC_JUMP_BACKWARD:
             case BC_JUMP2:
             case BC_JUMP2_ON_FALSE_POP:
@@ -357,6 +378,7 @@ void Disassembler::dumpMethod(uint8_t* bytecodes, size_t numberOfBytecodes,
             case BC_JUMP2_ON_NOT_NIL_TOP_TOP:
             case BC_JUMP2_ON_NIL_TOP_TOP:
             case BC_JUMP2_IF_GREATER:
+            case BC_JUMP2_IF_LESS:
             case BC_JUMP2_BACKWARD: {
                 uint16_t const offset =
                     ComputeOffset(bytecodes[bc_idx + 1], bytecodes[bc_idx + 2]);
@@ -372,6 +394,25 @@ void Disassembler::dumpMethod(uint8_t* bytecodes, size_t numberOfBytecodes,
                            target);
                 break;
             }
+            case BC_LOOP_START:
+            case BC_LOOP_NEXT: {
+                uint16_t const offset =
+                    ComputeOffset(bytecodes[bc_idx + 1], bytecodes[bc_idx + 2]);
+
+                int32_t target = 0;
+                if (bytecode == BC_LOOP_NEXT) {
+                    target = ((int32_t)bc_idx) - offset;
+                } else {
+                    target = ((int32_t)bc_idx) + offset;
+                }
+                DebugPrint("(slot: %d, jump offset: %d -> jump target: %d)\n",
+                           bytecodes[bc_idx + 3], offset, target);
+                break;
+            }
+            case BC_LOOP_COUNTER: {
+                DebugPrint("(slot: %d)\n", bytecodes[bc_idx + 1]);
+                break;
+            }
             default: {
                 DebugPrint("<incorrect bytecode>\n");
             }
@@ -445,7 +486,7 @@ void Disassembler::DumpBytecode(VMFrame* frame, VMMethod* method,
                                 size_t bc_idx) {
     static int64_t indentc = 0;
     static char ikind = '@';
-    uint8_t const bc = BC_0;
+    uint8_t const bc = BaseBytecode(BC_0);
     VMClass const* const cl = method->GetHolder();
 
     // Determine Context: Class or Block?
@@ -455,12 +496,12 @@ void Disassembler::DumpBytecode(VMFrame* frame, VMMethod* method,
 
         DebugTrace("%20s>>%-20s% 10lld %c %04d: %s\t",
                    cname->GetStdString().c_str(), sig->GetStdString().c_str(),
-                   indentc, ikind, bc_idx, Bytecode::GetBytecodeName(bc));
+                   indentc, ikind, bc_idx, Bytecode::GetBytecodeName(BC_0));
     } else {
         VMSymbol const* const sig = method->GetSignature();
 
         DebugTrace("%-42s% 10lld %c %04d: %s\t", sig->GetStdString().c_str(),
-                   indentc, ikind, bc_idx, Bytecode::GetBytecodeName(bc));
+                   indentc, ikind, bc_idx, Bytecode::GetBytecodeName(BC_0));
     }
     // reset send indicator
     if (ikind != '@') {
@@ -586,8 +627,10 @@ void Disassembler::DumpBytecode(VMFrame* frame, VMMethod* method,
             break;
         }
         case BC_PUSH_GLOBAL: {
-            auto* name = static_cast<VMSymbol*>(method->GetConstant(bc_idx));
-            vm_oop_t o = Universe::GetGlobal(name);
+            auto* association =
+                static_cast<VMAssociation*>(method->GetConstant(bc_idx));
+            VMSymbol* name = association->GetKey();
+            vm_oop_t o = association->GetValue();
             VMSymbol const* cname = nullptr;
 
             const char* c_cname = nullptr;
@@ -666,7 +709,24 @@ void Disassembler::DumpBytecode(VMFrame* frame, VMMethod* method,
         }
         case BC_SUPER_SEND:
         case BC_SEND:
-        case BC_SEND_1: {
+        case BC_SEND_1:
+        case BC_SEND_2:
+        case BC_SEND_3:
+        case BC_SEND_N:
+        case BC_ADD:
+        case BC_SUB:
+        case BC_MUL:
+        case BC_LT:
+        case BC_GT:
+        case BC_LE:
+        case BC_GE:
+        case BC_EQ:
+        case BC_EQ_EQ:
+        case BC_SEND_PRIM_UNARY:
+        case BC_SEND_PRIM_BINARY:
+        case BC_SEND_GETTER:
+        case BC_SEND_SETTER:
+        case BC_SEND_METHOD: {
             auto* sel = static_cast<VMSymbol*>(method->GetConstant(bc_idx));
 
             DebugPrint("(index: %d) signature: %s (", BC_1,
@@ -704,6 +764,7 @@ void Disassembler::DumpBytecode(VMFrame* frame, VMMethod* method,
         case BC_JUMP_ON_NOT_NIL_TOP_TOP:
         case BC_JUMP_ON_NIL_TOP_TOP:
         case BC_JUMP_IF_GREATER:
+        case BC_JUMP_IF_LESS:
         case BC_JUMP_BACKWARD:
         case BC_JUMP2:
         case BC_JUMP2_ON_FALSE_POP:
@@ -715,6 +776,7 @@ void Disassembler::DumpBytecode(VMFrame* frame, VMMethod* method,
         case BC_JUMP2_ON_NOT_NIL_TOP_TOP:
         case BC_JUMP2_ON_NIL_TOP_TOP:
         case BC_JUMP2_IF_GREATER:
+        case BC_JUMP2_IF_LESS:
         case BC_JUMP2_BACKWARD: {
             uint16_t const offset =
                 ComputeOffset(method->GetBytecode(bc_idx + 1),
@@ -729,6 +791,26 @@ void Disassembler::DumpBytecode(VMFrame* frame, VMMethod* method,
             DebugPrint("(jump offset: %d -> jump target: %d)", offset, target);
             break;
         }
+        case BC_LOOP_START:
+        case BC_LOOP_NEXT: {
+            uint16_t const offset =
+                ComputeOffset(method->GetBytecode(bc_idx + 1),
+                              method->GetBytecode(bc_idx + 2));
+
+            int32_t target = 0;
+            if (bc == BC_LOOP_NEXT) {
+                target = ((int32_t)bc_idx) - offset;
+            } else {
+                target = ((int32_t)bc_idx) + offset;
+            }
+            DebugPrint("(slot: %d, jump offset: %d -> jump target: %d)",
+                       method->GetBytecode(bc_idx + 3), offset, target);
+            break;
+        }
+        case BC_LOOP_COUNTER: {
+            DebugPrint("(slot: %d)", method->GetBytecode(bc_idx + 1));
+            break;
+        }
         default:
             DebugPrint("<incorrect bytecode>\n");
             break;
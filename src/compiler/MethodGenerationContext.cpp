@@ -40,8 +40,10 @@
 #include "../misc/VectorUtil.h"
 #include "../vm/Globals.h"
 #include "../vm/Print.h"
+#include "../vm/Symbols.h"
 #include "../vm/Universe.h"
 #include "../vmobjects/ObjectFormats.h"
+#include "../vmobjects/VMAssociation.h"
 #include "../vmobjects/VMBigInteger.h"  // NOLINT(misc-include-cleaner)
 #include "../vmobjects/VMMethod.h"
 #include "../vmobjects/VMPrimitive.h"
@@ -72,7 +74,8 @@ VMInvokable* MethodGenerationContext::Assemble() {
     size_t const numLocals = locals.size();
     VMMethod* meth =
         Universe::NewMethod(signature, bytecode.size(), numLiterals, numLocals,
-                            maxStackDepth, lexicalScope, inlinedLoops);
+                            maxStackDepth, lexicalScope, inlinedLoops,
+                            numberOfLoopSlots);
 
     // copy literals into the method
     for (size_t i = 0; i < numLiterals; i++) {
@@ -85,11 +88,62 @@ VMInvokable* MethodGenerationContext::Assemble() {
     for (size_t i = 0; i < bc_size; i++) {
         meth->SetBytecode(i, bytecode[i]);
     }
+    fuseSuperinstructions(meth);
 
     // return the method - the holder field is to be set later on!
     return meth;
 }
 
+/**
+ * Replace the first bytecode of each sequence that has a superinstruction with
+ * it. The other bytecodes of the sequence stay in place, which keeps the
+ * method's layout, and thus all jump offsets, unchanged. The bytecodes of this
+ * context are not changed, since they are still inspected when the method is
+ * inlined.
+ */
+void MethodGenerationContext::fuseSuperinstructions(VMMethod* meth) const {
+    std::vector<bool> const isJumpTarget =
+        GetJumpTargets(bytecode.data(), bytecode.size());
+
+    size_t i = 0;
+    while (i < bytecode.size()) {
+        size_t next = i + Bytecode::GetBytecodeLength(bytecode[i]);
+
+        // the longer superinstructions come first, so we fuse greedily
+        for (size_t s = FIRST_SUPERINSTRUCTION; s <= _LAST_BYTECODE; s += 1) {
+            size_t const end =
+                matchSuperinstruction((uint8_t)s, i, isJumpTarget);
+            if (end != 0) {
+                meth->SetBytecode(i, (uint8_t)s);
+                next = end;
+                break;
+            }
+        }
+        i = next;
+    }
+}
+
+/**
+ * @return the index after the sequence, or 0 if the bytecodes at bcIdx do not
+ *         match the superinstruction
+ */
+size_t MethodGenerationContext::matchSuperinstruction(
+    uint8_t superinstruction, size_t bcIdx,
+    const std::vector<bool>& isJumpTarget) const {
+    const uint8_t* components =
+        GetSuperinstructionComponents(superinstruction);
+
+    for (size_t c = 0; c < 3 && components[c] != BC_INVALID; c += 1) {
+        // a jump into the middle would skip the first bytecodes
+        if (bcIdx >= bytecode.size() || bytecode[bcIdx] != components[c] ||
+            (c > 0 && isJumpTarget[bcIdx])) {
+            return 0;
+        }
+        bcIdx += Bytecode::GetBytecodeLength(components[c]);
+    }
+    return bcIdx;
+}
+
 VMTrivialMethod* MethodGenerationContext::assembleTrivialMethod() {
     if (LastBytecodeIs(0, BC_RETURN_LOCAL)) {
         uint8_t pushCandidate = lastBytecodeIsOneOf(1, &IsPushConstBytecode);
@@ -168,8 +222,8 @@ VMTrivialMethod* MethodGenerationContext::assembleGlobalReturn() {
             "reads a global. New Bytecode?");
     }
 
-    auto* globalName = (VMSymbol*)literals.at(0);
-    return MakeGlobalReturn(signature, arguments, globalName);
+    auto* global = (VMAssociation*)literals.at(0);
+    return MakeGlobalReturn(signature, arguments, global);
 }
 
 VMTrivialMethod* MethodGenerationContext::assembleFieldGetter(
@@ -494,6 +548,12 @@ bool MethodGenerationContext::hasTwoLiteralBlockArguments() {
     return LastBytecodeIs(1, BC_PUSH_BLOCK);
 }
 
+bool MethodGenerationContext::lastBlockTakesArguments(
+    uint8_t numberOfArguments) {
+    auto* block = (VMInvokable*)literals.back();
+    return block->GetNumberOfArguments() == numberOfArguments;
+}
+
 /**
  * This works only, because we have a simple forward-pass parser,
  * and inlining, where this is used, happens right after the block was added.
@@ -668,41 +728,275 @@ bool MethodGenerationContext::InlineToDo(const Parser& parser) {
     // HACK: similar to the other inlined messages.
     // HACK: We don't support anything but integer at the moment.
     assert(Bytecode::GetBytecodeLength(BC_PUSH_BLOCK) == 2);
-    if (!hasOneLiteralBlockArgument()) {
+    if (!hasOneLiteralBlockArgument() || !lastBlockTakesArguments(2)) {
+        return false;
+    }
+
+    VMInvokable* toBeInlined = extractBlockMethodAndRemoveBytecode();
+
+    isCurrentlyInliningABlock = true;
+    EmitDupSecond(*this);
+    emitCountingLoop(parser, toBeInlined, false, nullptr);
+    isCurrentlyInliningABlock = false;
+
+    return true;
+}
+
+bool MethodGenerationContext::InlineToByDo(const Parser& parser) {
+    // HACK: as for to:do:, we assume the receiver and limit to be integers
+    assert(Bytecode::GetBytecodeLength(BC_PUSH_BLOCK) == 2);
+    if (!hasOneLiteralBlockArgument() || !lastBlockTakesArguments(2)) {
+        return false;
+    }
+
+    // the step needs to be a literal, so that we know the loop's direction
+    uint8_t const stepBytecode = lastBytecodeAt(1);
+    vm_oop_t step = nullptr;
+    switch (stepBytecode) {
+        case BC_PUSH_1:
+            break;
+        case BC_PUSH_CONSTANT_0:
+        case BC_PUSH_CONSTANT_1:
+        case BC_PUSH_CONSTANT_2:
+            step = literals.at(stepBytecode - BC_PUSH_CONSTANT_0);
+            break;
+        case BC_PUSH_CONSTANT:
+            step = literals.at(bytecode.at(bytecode.size() - 3));
+            break;
+        default:
+            return false;
+    }
+    if (step != nullptr &&
+        (!IS_SMALL_INT(step) || SMALL_INT_VAL(step) == 0)) {
         return false;
     }
 
     VMInvokable* toBeInlined = extractBlockMethodAndRemoveBytecode();
 
-    toBeInlined->MergeScopeInto(*this);
+    // the step is not kept on the stack, the loop pushes it itself
+    bytecode.resize(bytecode.size() -
+                    Bytecode::GetBytecodeLength(stepBytecode));
 
-    const Variable* blockArg = toBeInlined->GetArgument(1, 0);
-    uint8_t const iVarIdx = GetInlinedLocalIdx(blockArg);
+    bool const countsDown = step != nullptr && SMALL_INT_VAL(step) < 0;
+    if (step != nullptr && SMALL_INT_VAL(step) == (countsDown ? -1 : 1)) {
+        step = nullptr;
+    }
 
     isCurrentlyInliningABlock = true;
     EmitDupSecond(*this);
+    emitCountingLoop(parser, toBeInlined, countsDown, step);
+    isCurrentlyInliningABlock = false;
 
-    size_t const loopBeginIdx = OffsetOfNextInstruction();
-    size_t const jumpOffsetIdxToEnd = EmitJumpIfGreaterWithDummyOffset(*this);
+    return true;
+}
+
+bool MethodGenerationContext::InlineDownToDo(const Parser& parser) {
+    // HACK: as for to:do:, we assume the receiver and limit to be integers
+    assert(Bytecode::GetBytecodeLength(BC_PUSH_BLOCK) == 2);
+    if (!hasOneLiteralBlockArgument() || !lastBlockTakesArguments(2)) {
+        return false;
+    }
+
+    VMInvokable* toBeInlined = extractBlockMethodAndRemoveBytecode();
+
+    isCurrentlyInliningABlock = true;
+    EmitDupSecond(*this);
+    emitCountingLoop(parser, toBeInlined, true, nullptr);
+    isCurrentlyInliningABlock = false;
+
+    return true;
+}
+
+bool MethodGenerationContext::InlineTimesRepeat(const Parser& parser) {
+    // HACK: as for to:do:, we assume the receiver to be an integer
+    assert(Bytecode::GetBytecodeLength(BC_PUSH_BLOCK) == 2);
+    if (!hasOneLiteralBlockArgument() || !lastBlockTakesArguments(1)) {
+        return false;
+    }
+
+    VMInvokable* toBeInlined = extractBlockMethodAndRemoveBytecode();
 
+    // the receiver is the limit, and the counter starts at 1
+    isCurrentlyInliningABlock = true;
     EmitDUP(*this);
+    Emit1(*this, BC_PUSH_1, 1);
+    emitCountingLoop(parser, toBeInlined, false, nullptr);
+    isCurrentlyInliningABlock = false;
 
-    EmitPOPLOCAL(*this, parser, iVarIdx, 0);
+    return true;
+}
 
-    toBeInlined->InlineInto(*this, parser, false);
+bool MethodGenerationContext::InlineWhileWithoutBody(const Parser& parser,
+                                                     bool isWhileTrue) {
+    assert(Bytecode::GetBytecodeLength(BC_PUSH_BLOCK) == 2);
+    if (!hasOneLiteralBlockArgument() || !lastBlockTakesArguments(1)) {
+        return false;
+    }
 
-    EmitPOP(*this);
-    EmitINC(*this);
+    VMInvokable* condMethod = extractBlockMethodAndRemoveBytecode();
+
+    size_t const loopBeginIdx = OffsetOfNextInstruction();
+
+    isCurrentlyInliningABlock = true;
+    condMethod->InlineInto(*this, parser);
+
+    size_t const jumpOffsetIdxToEnd = EmitJumpOnWithDummyOffset(
+        *this, isWhileTrue ? ON_FALSE : ON_TRUE, true);
 
+    resetLastBytecodeBuffer();
     EmitBackwardsJumpOffsetToTarget(loopBeginIdx);
 
     PatchJumpOffsetToPointToNextInstruction(jumpOffsetIdxToEnd);
+    EmitPUSHCONSTANT(*this, parser, load_ptr(nilObject));
+    resetLastBytecodeBuffer();
 
     isCurrentlyInliningABlock = false;
 
     return true;
 }
 
+void MethodGenerationContext::emitCountingLoop(const Parser& parser,
+                                               VMInvokable* body,
+                                               bool countsDown, vm_oop_t step) {
+    body->MergeScopeInto(*this);
+
+    // a loop needs slots for its counter, limit, and step
+    if (numberOfLoopSlots + 3 <= UINT8_MAX + 1) {
+        emitCountedLoopWithSlots(parser, body, countsDown, step);
+        return;
+    }
+
+    size_t const loopBeginIdx = OffsetOfNextInstruction();
+    size_t const jumpOffsetIdxToEnd =
+        countsDown ? EmitJumpIfLessWithDummyOffset(*this)
+                   : EmitJumpIfGreaterWithDummyOffset(*this);
+
+    if (body->GetNumberOfArguments() == 2) {
+        const Variable* blockArg = body->GetArgument(1, 0);
+        uint8_t const iVarIdx = GetInlinedLocalIdx(blockArg);
+
+        EmitDUP(*this);
+        EmitPOPLOCAL(*this, parser, iVarIdx, 0);
+    }
+
+    body->InlineInto(*this, parser, false);
+
+    EmitPOP(*this);
+    if (step != nullptr) {
+        EmitPUSHCONSTANT(*this, parser, step);
+        EmitSpecialSEND(*this, parser, BC_ADD, load_ptr(symbolPlus));
+    } else if (countsDown) {
+        EmitDEC(*this);
+    } else {
+        EmitINC(*this);
+    }
+
+    EmitBackwardsJumpOffsetToTarget(loopBeginIdx);
+
+    PatchJumpOffsetToPointToNextInstruction(jumpOffsetIdxToEnd);
+}
+
+void MethodGenerationContext::emitCountedLoopWithSlots(const Parser& parser,
+                                                       VMInvokable* body,
+                                                       bool countsDown,
+                                                       vm_oop_t step) {
+    uint8_t const slot = ReserveLoopSlots(parser, 3);
+
+    if (step != nullptr) {
+        EmitPUSHCONSTANT(*this, parser, step);
+    } else if (countsDown) {
+        EmitPUSHCONSTANT(*this, parser, NEW_INT(-1));
+    } else {
+        Emit1(*this, BC_PUSH_1, 1);
+    }
+
+    size_t const jumpOffsetIdxToEnd = EmitLoopStartWithDummyOffset(*this, slot);
+    size_t const loopBeginIdx = OffsetOfNextInstruction();
+
+    // the counter is only boxed when the loop variable is read
+    if (body->GetNumberOfArguments() == 2 && body->ReadsArgument(1)) {
+        const Variable* blockArg = body->GetArgument(1, 0);
+        uint8_t const iVarIdx = GetInlinedLocalIdx(blockArg);
+
+        EmitLoopCounter(*this, slot);
+        EmitPOPLOCAL(*this, parser, iVarIdx, 0);
+    }
+
+    body->InlineInto(*this, parser, false);
+
+    EmitPOP(*this);
+    EmitLoopNextToTarget(loopBeginIdx, slot);
+
+    PatchJumpOffsetToPointToNextInstruction(jumpOffsetIdxToEnd);
+}
+
+uint8_t MethodGenerationContext::ReserveLoopSlots(const Parser& parser,
+                                                  size_t numberOfSlots) {
+    size_t const first = numberOfLoopSlots;
+    if (first + numberOfSlots > UINT8_MAX + 1) {
+        parser.ParseError(
+            "The method has too many inlined loops. You may be able to split "
+            "up this method into multiple.");
+    }
+
+    numberOfLoopSlots += numberOfSlots;
+    return first;
+}
+
+// The iteration methods of the core library, with the classes that implement
+// them. They only evaluate their block arguments, and neither store nor return
+// them.
+static const struct {
+    const char* selector;
+    uint8_t receivers;
+} nonEscapingSends[] = {
+    {"do:", RECEIVER_ARRAY | RECEIVER_VECTOR},
+    {"doIndexes:", RECEIVER_ARRAY | RECEIVER_VECTOR},
+    {"reverseDo:", RECEIVER_ARRAY},
+    {"collect:", RECEIVER_ARRAY | RECEIVER_VECTOR},
+    {"select:", RECEIVER_ARRAY | RECEIVER_VECTOR},
+    {"reject:", RECEIVER_ARRAY | RECEIVER_VECTOR},
+    {"detect:", RECEIVER_ARRAY},
+    {"detect:ifNone:", RECEIVER_ARRAY},
+    {"timesRepeat:", RECEIVER_INTEGER},
+};
+
+void MethodGenerationContext::MarkNonEscapingBlocks(
+    const std::string& selector, uint8_t numberOfArguments) {
+    uint8_t receivers = 0;
+    for (const auto& send : nonEscapingSends) {
+        if (selector == send.selector) {
+            receivers = send.receivers;
+            break;
+        }
+    }
+    if (receivers == 0 || numberOfArguments > NUM_LAST_BYTECODES) {
+        return;
+    }
+
+    // All arguments need to be block literals, so that nothing runs between
+    // pushing the first block and the send. Blocks that create blocks
+    // themselves are excluded, since their frames could be captured by a
+    // block that escapes.
+    assert(Bytecode::GetBytecodeLength(BC_PUSH_BLOCK) == 2);
+    for (size_t i = 0; i < numberOfArguments; i += 1) {
+        if (!LastBytecodeIs(i, BC_PUSH_BLOCK)) {
+            return;
+        }
+        uint8_t const literalIdx = bytecode.at(bytecode.size() - 1 - (2 * i));
+        auto* block = dynamic_cast<VMMethod*>(AS_OBJ(literals.at(literalIdx)));
+        if (block != nullptr && block->PushesBlocks()) {
+            return;
+        }
+    }
+
+    for (size_t i = 0; i < numberOfArguments; i += 1) {
+        uint8_t const literalIdx = bytecode.at(bytecode.size() - 1 - (2 * i));
+        auto* block = static_cast<VMInvokable*>(literals.at(literalIdx));
+        block->SetNonEscaping(receivers, numberOfArguments - 1 - i);
+    }
+}
+
 void MethodGenerationContext::CompleteLexicalScope() {
     lexicalScope = new LexicalScope(
         outerGenc == nullptr ? nullptr : outerGenc->lexicalScope, arguments,
@@ -808,6 +1102,17 @@ void MethodGenerationContext::EmitBackwardsJumpOffsetToTarget(
     inlinedLoops.emplace_back(loopBeginIdx, backwardJumpIdx);
 }
 
+void MethodGenerationContext::EmitLoopNextToTarget(size_t loopBeginIdx,
+                                                   uint8_t slot) {
+    size_t const backwardJumpIdx = OffsetOfNextInstruction();
+    size_t const jumpOffset = backwardJumpIdx - loopBeginIdx;
+
+    checkJumpOffset(jumpOffset, BC_LOOP_NEXT);
+
+    EmitLoopNextWithOffset(*this, jumpOffset, slot);
+    inlinedLoops.emplace_back(loopBeginIdx, backwardJumpIdx);
+}
+
 void MethodGenerationContext::completeJumpsAndEmitReturningNil(
     const Parser& parser, size_t loopBeginIdx,
     size_t jumpOffsetIdxToSkipLoopBody) {
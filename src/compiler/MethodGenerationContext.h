@@ -108,9 +108,24 @@ public:
     bool InlineThenBranch(const Parser& parser, JumpCondition condition);
     bool InlineAndOr(const Parser& parser, bool isOr);
     bool InlineToDo(const Parser& parser);
+    bool InlineToByDo(const Parser& parser);
+    bool InlineDownToDo(const Parser& parser);
+    bool InlineTimesRepeat(const Parser& parser);
+    /// Inline the unary whileTrue and whileFalse, which have no loop body.
+    bool InlineWhileWithoutBody(const Parser& parser, bool isWhileTrue);
+
+    /// Mark the block literals that were just pushed as arguments of a send
+    /// with the given selector as non-escaping, if the send only evaluates
+    /// them.
+    void MarkNonEscapingBlocks(const std::string& selector,
+                               uint8_t numberOfArguments);
 
     inline size_t OffsetOfNextInstruction() { return bytecode.size(); }
 
+    /// Reserve frame slots for the counters of counted loops.
+    /// @return the first of the slots
+    uint8_t ReserveLoopSlots(const Parser& parser, size_t numberOfSlots);
+
     void CompleteLexicalScope();
     void MergeIntoScope(LexicalScope& scopeToBeInlined);
     void InlineAsLocals(vector<Variable>& vars);
@@ -119,6 +134,7 @@ public:
     const Variable* GetInlinedVariable(const Variable* oldVar) const;
 
     void EmitBackwardsJumpOffsetToTarget(size_t loopBeginIdx);
+    void EmitLoopNextToTarget(size_t loopBeginIdx, uint8_t slot);
     void PatchJumpOffsetToPointToNextInstruction(size_t indexOfOffset);
 
     bool OptimizeDupPopPopSequence();
@@ -137,11 +153,17 @@ private:
 
     bool optimizeIncFieldPush();
 
+    void fuseSuperinstructions(VMMethod* meth) const;
+    [[nodiscard]] size_t matchSuperinstruction(
+        uint8_t superinstruction, size_t bcIdx,
+        const std::vector<bool>& isJumpTarget) const;
+
     void removeLastBytecodes(size_t numBytecodes);
     void removeLastBytecodeAt(size_t indexFromEnd);
 
     bool hasOneLiteralBlockArgument();
     bool hasTwoLiteralBlockArguments();
+    bool lastBlockTakesArguments(uint8_t numberOfArguments);
     uint8_t lastBytecodeAt(size_t indexFromEnd);
 
     uint8_t lastBytecodeIsOneOf(size_t indexFromEnd,
@@ -155,6 +177,15 @@ private:
 
     VMInvokable* getLastBlockMethodAndFreeLiteral(uint8_t blockLiteralIdx);
 
+    /// Emit the loop of to:do: and its variants. The counter is on top of the
+    /// stack, above the limit. Without a step, the loop increments or
+    /// decrements the counter by one. As long as the method has loop slots
+    /// left, the loop keeps its counter unboxed in them.
+    void emitCountingLoop(const Parser& parser, VMInvokable* body,
+                          bool countsDown, vm_oop_t step);
+    void emitCountedLoopWithSlots(const Parser& parser, VMInvokable* body,
+                                  bool countsDown, vm_oop_t step);
+
     void completeJumpsAndEmitReturningNil(const Parser& parser,
                                           size_t loopBeginIdx,
                                           size_t jumpOffsetIdxToSkipLoopBody);
@@ -179,6 +210,7 @@ private:
 
     size_t currentStackDepth{0};
     size_t maxStackDepth{0};
+    size_t numberOfLoopSlots{0};
 
     std::array<uint8_t, NUM_LAST_BYTECODES> last4Bytecodes;
 
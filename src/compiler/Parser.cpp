@@ -36,6 +36,7 @@
 #include <string>
 #include <vector>
 
+#include "../interpreter/bytecodes.h"
 #include "../misc/ParseInteger.h"
 #include "../misc/StringUtil.h"
 #include "../misc/defs.h"
@@ -600,8 +601,17 @@ void Parser::messages(MethodGenerationContext& mgenc, bool super) {
 }
 
 void Parser::unaryMessage(MethodGenerationContext& mgenc, bool super) {
+    std::string const msgSelector(text);
     VMSymbol* msg = unarySelector();
 
+    if (!super &&
+        ((msgSelector == "whileTrue" &&
+          mgenc.InlineWhileWithoutBody(*this, true)) ||
+         (msgSelector == "whileFalse" &&
+          mgenc.InlineWhileWithoutBody(*this, false)))) {
+        return;
+    }
+
     if (super) {
         EmitSUPERSEND(mgenc, *this, msg);
     } else {
@@ -636,6 +646,39 @@ bool Parser::tryIncOrDecBytecodes(VMSymbol* msg, bool isSuperSend,
     return true;
 }
 
+/// The bytecode for binary selectors that the interpreter handles directly
+/// for integers and doubles, or BC_INVALID.
+static uint8_t specialSendBytecodeFor(const std::string& selector) {
+    if (selector == "+") {
+        return BC_ADD;
+    }
+    if (selector == "-") {
+        return BC_SUB;
+    }
+    if (selector == "*") {
+        return BC_MUL;
+    }
+    if (selector == "<") {
+        return BC_LT;
+    }
+    if (selector == ">") {
+        return BC_GT;
+    }
+    if (selector == "<=") {
+        return BC_LE;
+    }
+    if (selector == ">=") {
+        return BC_GE;
+    }
+    if (selector == "=") {
+        return BC_EQ;
+    }
+    if (selector == "==") {
+        return BC_EQ_EQ;
+    }
+    return BC_INVALID;
+}
+
 void Parser::binaryMessage(MethodGenerationContext& mgenc, bool super) {
     std::string const msgSelector(text);
     VMSymbol* msg = binarySelector();
@@ -653,6 +696,12 @@ void Parser::binaryMessage(MethodGenerationContext& mgenc, bool super) {
 
     if (super) {
         EmitSUPERSEND(mgenc, *this, msg);
+        return;
+    }
+
+    uint8_t const specialBytecode = specialSendBytecodeFor(msgSelector);
+    if (specialBytecode != BC_INVALID) {
+        EmitSpecialSEND(mgenc, *this, specialBytecode, msg);
     } else {
         EmitSEND(mgenc, *this, msg);
     }
@@ -693,7 +742,8 @@ void Parser::keywordMessage(MethodGenerationContext& mgenc, bool super) {
              (kw == "whileTrue:" && mgenc.InlineWhile(*this, true)) ||
              (kw == "whileFalse:" && mgenc.InlineWhile(*this, false)) ||
              (kw == "or:" && mgenc.InlineAndOr(*this, true)) ||
-             (kw == "and:" && mgenc.InlineAndOr(*this, false)))) {
+             (kw == "and:" && mgenc.InlineAndOr(*this, false)) ||
+             (kw == "timesRepeat:" && mgenc.InlineTimesRepeat(*this)))) {
             return;
         }
 
@@ -706,7 +756,12 @@ void Parser::keywordMessage(MethodGenerationContext& mgenc, bool super) {
               mgenc.InlineThenElseBranches(*this, JumpCondition::ON_NOT_NIL)) ||
              (kw == "ifNotNil:ifNil:" &&
               mgenc.InlineThenElseBranches(*this, JumpCondition::ON_NIL)) ||
-             (kw == "to:do:" && mgenc.InlineToDo(*this)))) {
+             (kw == "to:do:" && mgenc.InlineToDo(*this)) ||
+             (kw == "downTo:do:" && mgenc.InlineDownToDo(*this)))) {
+            return;
+        }
+
+        if (numParts == 3 && kw == "to:by:do:" && mgenc.InlineToByDo(*this)) {
             return;
         }
     }
@@ -716,6 +771,7 @@ void Parser::keywordMessage(MethodGenerationContext& mgenc, bool super) {
     if (super) {
         EmitSUPERSEND(mgenc, *this, msg);
     } else {
+        mgenc.MarkNonEscapingBlocks(kw, numParts);
         EmitSEND(mgenc, *this, msg);
     }
 }
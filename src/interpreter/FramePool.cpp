@@ -0,0 +1,38 @@
+#include "FramePool.h"
+
+#include <cstddef>
+
+#include "../vmobjects/ObjectFormats.h"
+#include "../vmobjects/VMFrame.h"
+
+VMFrame* FramePool::freeLists[FRAME_POOL_MAX_SLOTS + 1];
+
+VMFrame* FramePool::Allocate(size_t numberOfSlots) {
+    if (numberOfSlots > FRAME_POOL_MAX_SLOTS) {
+        return nullptr;
+    }
+
+    VMFrame* result = freeLists[numberOfSlots];
+    if (result != nullptr) {
+        freeLists[numberOfSlots] = load_ptr(result->previousFrame);
+    }
+    return result;
+}
+
+void FramePool::Free(VMFrame* frame) {
+    size_t const numberOfSlots =
+        (frame->GetObjectSize() - sizeof(VMFrame)) / sizeof(gc_oop_t);
+    if (numberOfSlots > FRAME_POOL_MAX_SLOTS) {
+        return;
+    }
+
+    // no write barrier, the pool is not walked by the GC
+    frame->previousFrame = store_root(freeLists[numberOfSlots]);
+    freeLists[numberOfSlots] = frame;
+}
+
+void FramePool::Clear() {
+    for (VMFrame*& freeList : freeLists) {
+        freeList = nullptr;
+    }
+}
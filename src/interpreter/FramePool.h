@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+
+#include "../vmobjects/ObjectFormats.h"
+
+// frames with more slots for arguments, locals, and the stack are not pooled
+#define FRAME_POOL_MAX_SLOTS 32
+
+/**
+ * Free lists of heap frames that can be reused for new activations.
+ *
+ * Most frames live on the FrameStack, and only frames that are allocated when
+ * it is full end up on the heap. Once they return, those that were not
+ * captured, for instance by a block, are only referenced by the interpreter,
+ * and are put on the free list for their number of slots. Universe::NewFrame()
+ * then reuses them instead of allocating a new frame.
+ *
+ * The free lists are linked through the frames' previousFrame field. They are
+ * not roots, instead they are cleared on every GC, which frees the pooled
+ * frames.
+ */
+class FramePool {
+public:
+    /// @return a frame with the given number of slots, or nullptr if there
+    ///         is none. The frame needs to be reinitialized.
+    static VMFrame* Allocate(size_t numberOfSlots);
+
+    /// Add a heap frame that returned and was not captured to the pool.
+    static void Free(VMFrame* frame);
+
+    static void Clear();
+
+private:
+    static VMFrame* freeLists[FRAME_POOL_MAX_SLOTS + 1];
+};
@@ -0,0 +1,68 @@
+#include "FrameStack.h"
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+#include "../misc/defs.h"
+#include "../vm/Universe.h"
+#include "../vmobjects/ObjectFormats.h"
+#include "../vmobjects/VMBlock.h"
+#include "../vmobjects/VMFrame.h"
+#include "../vmobjects/VMMethod.h"
+#include "../vmobjects/VMObject.h"
+
+uint8_t FrameStack::memory[FRAME_STACK_SIZE];
+uint8_t* FrameStack::top = FrameStack::memory;
+
+VMFrame* FrameStack::NewFrame(VMFrame* previousFrame, VMMethod* method) {
+    size_t const length = method->GetNumberOfArguments() +
+                          method->GetNumberOfLocals() +
+                          method->GetMaximumNumberOfStackElements() +
+                          method->GetNumberOfLoopSlots();
+
+    size_t const additionalBytes = length * sizeof(VMObject*);
+    size_t const size = sizeof(VMFrame) + additionalBytes;
+    if (unlikely(top + size > memory + FRAME_STACK_SIZE)) {
+        return nullptr;
+    }
+
+    // the global placement new, VMFrame's own operator new allocates on the
+    // heap
+    auto* result = ::new (top) VMFrame(additionalBytes, method, previousFrame);
+    top += size;
+    return result;
+}
+
+VMBlock* FrameStack::NewBlock(VMInvokable* method, VMFrame* context,
+                              uint8_t arguments) {
+    if (unlikely(top + sizeof(VMBlock) > memory + FRAME_STACK_SIZE)) {
+        return nullptr;
+    }
+
+    auto* result = ::new (top) VMBlock(method, context);
+    result->SetClass(Universe::GetBlockClassWithArgs(arguments));
+    top += sizeof(VMBlock);
+    return result;
+}
+
+void FrameStack::ReleaseAbove(VMFrame* frame) {
+    assert(Contains(frame));
+    top = (uint8_t*)frame + frame->GetObjectSize();
+}
+
+bool FrameStack::HasBlocksAbove(VMFrame* frame) {
+    return Contains(frame) &&
+           top != (uint8_t*)frame + frame->GetObjectSize();
+}
+
+void FrameStack::WalkFrames(walk_heap_fn walk) {
+    uint8_t* current = memory;
+    while (current < top) {
+        // frames and blocks, both know their size
+        auto* obj = (AbstractVMObject*)current;
+        obj->WalkObjects(walk);
+        current += obj->GetObjectSize();
+    }
+}
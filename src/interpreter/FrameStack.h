@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "../misc/defs.h"
+#include "../vmobjects/ObjectFormats.h"
+
+#define FRAME_STACK_SIZE (8 * 1024 * 1024)
+
+/**
+ * A contiguous stack segment for the frames of the interpreter.
+ *
+ * Frames are allocated here instead of on the heap, and are freed again when
+ * they return, so that sends do not create garbage. A frame is copied to the
+ * heap when it needs to outlive its activation, which is the case when a block
+ * captures it as its context.
+ *
+ * Blocks that the compiler marked as non-escaping are allocated here as well,
+ * directly above the frame that is their context, see
+ * Interpreter::doPushBlock(). They are freed together with the frame.
+ * References into the frame stack are only held by the frame stack itself, and
+ * by heap frames that do not outlive the referenced frames and blocks.
+ *
+ * The frames and blocks on the frame stack are not objects of the heap. The GC
+ * does not move or free them, but walks them as roots, see WalkFrames().
+ */
+class FrameStack {
+public:
+    /// @return the new frame, or nullptr if the frame stack is full
+    static VMFrame* NewFrame(VMFrame* previousFrame, VMMethod* method);
+
+    /// @return the new block, or nullptr if the frame stack is full
+    static VMBlock* NewBlock(VMInvokable* method, VMFrame* context,
+                             uint8_t arguments);
+
+    /// Free the frame and everything above it. Frames on the heap are ignored.
+    static inline void Release(VMFrame* frame) {
+        if (Contains(frame)) {
+            top = (uint8_t*)frame;
+        }
+    }
+
+    /// Free the blocks above the frame, which has to be the topmost frame.
+    static void ReleaseAbove(VMFrame* frame);
+
+    /// @return whether there are blocks above the frame, which has to be the
+    ///         topmost frame
+    [[nodiscard]] static bool HasBlocksAbove(VMFrame* frame);
+
+    [[nodiscard]] static inline bool Contains(void const* ptr) {
+        return (uint8_t const*)ptr >= memory &&
+               (uint8_t const*)ptr < memory + FRAME_STACK_SIZE;
+    }
+
+    /// Walk the objects referenced by all frames and blocks on the frame
+    /// stack.
+    static void WalkFrames(walk_heap_fn walk);
+
+private:
+    alignas(sizeof(void*)) static uint8_t memory[FRAME_STACK_SIZE];
+    static uint8_t* top;
+};
@@ -0,0 +1,57 @@
+#include "InlineCache.h"
+
+#include <cstddef>
+#include <cstdint>
+
+#include "../memory/Heap.h"
+#include "../misc/defs.h"
+#include "../vm/Globals.h"  // NOLINT (misc-include-cleaner)
+#include "../vmobjects/ObjectFormats.h"
+#include "../vmobjects/VMClass.h"
+#include "../vmobjects/VMInvokable.h"
+#include "../vmobjects/VMMethod.h"
+#include "../vmobjects/VMSymbol.h"
+
+size_t InlineCache::globalEpoch = 1;
+
+VMInvokable* InlineCache::LookupAndCache(VMClass* cls, VMSymbol* signature,
+                                         VMMethod* owner) {
+    VMInvokable* invokable = cls->LookupInvokable(signature);
+    if (invokable == nullptr) {
+        // #doesNotUnderstand:arguments: is not worth caching
+        return nullptr;
+    }
+
+    if (epoch != globalEpoch) {
+        epoch = globalEpoch;
+        numEntries = 0;
+        megamorphic = false;
+    }
+
+    if (numEntries == INLINE_CACHE_SIZE) {
+        megamorphic = true;
+        return invokable;
+    }
+
+    classes[numEntries] = store_with_separate_barrier(cls);
+    invokables[numEntries] = store_with_separate_barrier(invokable);
+    numEntries += 1;
+
+    write_barrier(owner, cls);
+    write_barrier(owner, invokable);
+    return invokable;
+}
+
+void InlineCache::WalkObjects(walk_heap_fn walk) {
+    if (epoch != globalEpoch) {
+        // stale entries are dropped instead of keeping them alive
+        numEntries = 0;
+        megamorphic = false;
+        return;
+    }
+
+    for (uint8_t i = 0; i < numEntries; i += 1) {
+        classes[i] = static_cast<GCClass*>(walk(classes[i]));
+        invokables[i] = static_cast<GCInvokable*>(walk(invokables[i]));
+    }
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "../misc/defs.h"
+#include "../vmobjects/ObjectFormats.h"
+
+#define INLINE_CACHE_SIZE 4
+
+/**
+ * A polymorphic inline cache for a single send site.
+ *
+ * It starts out empty, becomes monomorphic with the first receiver class, and
+ * grows to up to INLINE_CACHE_SIZE entries. Once more receiver classes are
+ * seen, the site is considered megamorphic and all further sends go straight
+ * to VMClass::LookupInvokable().
+ *
+ * All caches are invalidated together, by bumping a global epoch, whenever the
+ * methods of any class change.
+ */
+class InlineCache {
+public:
+    InlineCache() = default;
+
+    [[nodiscard]] inline VMInvokable* Lookup(VMClass* cls) const {
+        if (likely(epoch == globalEpoch)) {
+            for (uint8_t i = 0; i < numEntries; i += 1) {
+                if (load_ptr(classes[i]) == cls) {
+                    return load_ptr(invokables[i]);
+                }
+            }
+        }
+        return nullptr;
+    }
+
+    /// Look up the invokable for cls, and remember it for the next send.
+    /// The owner is the method the send site belongs to, and is needed for
+    /// the write barrier.
+    VMInvokable* LookupAndCache(VMClass* cls, VMSymbol* signature,
+                                VMMethod* owner);
+
+    void WalkObjects(walk_heap_fn walk);
+
+    [[nodiscard]] bool IsMonomorphic() const {
+        return epoch == globalEpoch && numEntries == 1;
+    }
+
+    [[nodiscard]] bool IsMegamorphic() const {
+        return epoch == globalEpoch && megamorphic;
+    }
+
+    /// Needs to be called whenever the methods of a class change.
+    static void InvalidateAll() { globalEpoch += 1; }
+
+    /// @return the current epoch, which changes with the methods of classes
+    [[nodiscard]] static size_t GetGlobalEpoch() { return globalEpoch; }
+
+private:
+    static size_t globalEpoch;
+
+    size_t epoch{0};
+    uint8_t numEntries{0};
+    bool megamorphic{false};
+    GCClass* classes[INLINE_CACHE_SIZE]{};
+    GCInvokable* invokables[INLINE_CACHE_SIZE]{};
+};
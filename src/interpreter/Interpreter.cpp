@@ -27,8 +27,10 @@
 #include "Interpreter.h"
 
 #include <cassert>
+#include <cmath>
 #include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <string>
 
 #include "../compiler/Disassembler.h"
@@ -43,6 +45,7 @@
 #include "../vmobjects/ObjectFormats.h"
 #include "../vmobjects/Signature.h"
 #include "../vmobjects/VMArray.h"
+#include "../vmobjects/VMAssociation.h"
 #include "../vmobjects/VMBigInteger.h"  // NOLINT(misc-include-cleaner)
 #include "../vmobjects/VMBlock.h"
 #include "../vmobjects/VMClass.h"
@@ -51,7 +54,12 @@
 #include "../vmobjects/VMInvokable.h"
 #include "../vmobjects/VMMethod.h"
 #include "../vmobjects/VMObject.h"
+#include "../vmobjects/VMSafePrimitive.h"
 #include "../vmobjects/VMSymbol.h"
+#include "../vmobjects/VMTrivialMethod.h"
+#include "FramePool.h"
+#include "FrameStack.h"
+#include "InlineCache.h"
 
 const std::string Interpreter::unknownGlobal = "unknownGlobal:";
 const std::string Interpreter::doesNotUnderstand =
@@ -65,628 +73,1190 @@ VMMethod* Interpreter::method = nullptr;
 // current execution context
 size_t Interpreter::bytecodeIndexGlobal;
 uint8_t* Interpreter::currentBytecodes;
+DecodedBytecode* Interpreter::currentDecodedBytecodes;
+void const* const* Interpreter::dispatchTable = nullptr;
+
+static inline bool addWithOverflow(int64_t left, int64_t right,
+                                   int64_t* result) {
+    return __builtin_add_overflow(left, right, result);
+}
+
+static inline bool subWithOverflow(int64_t left, int64_t right,
+                                   int64_t* result) {
+    return __builtin_sub_overflow(left, right, result);
+}
+
+static inline bool mulWithOverflow(int64_t left, int64_t right,
+                                   int64_t* result) {
+    return __builtin_mul_overflow(left, right, result);
+}
+
+static inline bool isSmallIntOrDouble(vm_oop_t obj) {
+    return IS_SMALL_INT(obj) || IS_DOUBLE(obj);
+}
+
+static inline double asDouble(vm_oop_t obj) {
+    return IS_SMALL_INT(obj) ? (double)SMALL_INT_VAL(obj) : AS_DOUBLE(obj);
+}
+
+static inline vm_oop_t increment(vm_oop_t val) {
+    if (IS_SMALL_INT(val)) {
+        return NEW_INT(SMALL_INT_VAL(val) + 1);
+    }
+    if (CLASS_OF(val) == load_ptr(doubleClass)) {
+        double const d = static_cast<VMDouble*>(val)->GetEmbeddedDouble();
+        return Universe::NewDouble(d + 1.0);
+    }
+    ErrorExit("unsupported");
+}
+
+static inline vm_oop_t decrement(vm_oop_t val) {
+    if (IS_SMALL_INT(val)) {
+        return NEW_INT(SMALL_INT_VAL(val) - 1);
+    }
+    if (CLASS_OF(val) == load_ptr(doubleClass)) {
+        double const d = static_cast<VMDouble*>(val)->GetEmbeddedDouble();
+        return Universe::NewDouble(d - 1.0);
+    }
+    ErrorExit("unsupported");
+}
+
+static inline bool checkIsGreater(vm_oop_t top, vm_oop_t top2) {
+    if (IS_SMALL_INT(top) && IS_SMALL_INT(top2)) {
+        return SMALL_INT_VAL(top) > SMALL_INT_VAL(top2);
+    }
+    if (IS_DOUBLE(top) && IS_DOUBLE(top2)) {
+        return AS_DOUBLE(top) > AS_DOUBLE(top2);
+    }
+
+    return false;
+}
+
+/// The limit of a counted loop as an integer that the counter reaches under
+/// the same condition as the original limit.
+static int64_t loopLimit(vm_oop_t limit, bool countsDown) {
+    if (IS_SMALL_INT(limit)) {
+        return SMALL_INT_VAL(limit);
+    }
+    if (IS_DOUBLE(limit)) {
+        double const value = countsDown ? std::ceil(AS_DOUBLE(limit))
+                                        : std::floor(AS_DOUBLE(limit));
+        if (value >= 0x1p63) {
+            return INT64_MAX;
+        }
+        if (value < -0x1p63) {
+            return INT64_MIN;
+        }
+        if (std::isnan(value)) {
+            // no counter compares with NaN, the loop does not run
+            return countsDown ? INT64_MAX : INT64_MIN;
+        }
+        return (int64_t)value;
+    }
+    if (IS_BIG_INT(limit)) {
+        const InfInt* value = AS_BIG_INT(limit)->GetEmbeddedInteger();
+        if (*value > InfInt(INT64_MAX)) {
+            return INT64_MAX;
+        }
+        if (*value < InfInt(INT64_MIN)) {
+            return INT64_MIN;
+        }
+        return value->toInt64();
+    }
+    ErrorExit("inlined counting loops only support numbers as limit");
+}
+
+/// Initialize the counter, limit, and step of a counted loop, which are kept
+/// in the frame's loop slots.
+/// @return whether the loop runs its first iteration
+static inline bool startCountedLoop(VMFrame* frame, uint8_t slot,
+                                    vm_oop_t limit, vm_oop_t start,
+                                    vm_oop_t step) {
+    // HACK: as for the other inlined loops, we assume integers
+    if (!IS_SMALL_INT(start) || !IS_SMALL_INT(step)) {
+        ErrorExit("inlined counting loops only support integers as counter");
+    }
+
+    int64_t const counter = SMALL_INT_VAL(start);
+    int64_t const stepValue = SMALL_INT_VAL(step);
+    int64_t const limitValue = loopLimit(limit, stepValue < 0);
+
+    *frame->GetLoopSlot(slot) = counter;
+    *frame->GetLoopSlot(slot + 1) = limitValue;
+    *frame->GetLoopSlot(slot + 2) = stepValue;
+    return stepValue < 0 ? counter >= limitValue : counter <= limitValue;
+}
+
+/// Advance the counter of a counted loop.
+/// @return whether the loop runs another iteration
+static inline bool continueCountedLoop(VMFrame* frame, uint8_t slot) {
+    int64_t* counter = frame->GetLoopSlot(slot);
+    int64_t const limit = *frame->GetLoopSlot(slot + 1);
+    int64_t const step = *frame->GetLoopSlot(slot + 2);
+
+    // the counter cannot overflow without passing the limit
+    if (unlikely(__builtin_add_overflow(*counter, step, counter))) {
+        return false;
+    }
+    return step < 0 ? *counter >= limit : *counter <= limit;
+}
+
+/// The fast paths of the special send bytecodes return nullptr when they do
+/// not apply, and the bytecode falls back to a normal send.
+template <typename IntOp, typename DoubleOp>
+static inline vm_oop_t tryArithmetic(vm_oop_t left, vm_oop_t right,
+                                     IntOp intOp, DoubleOp doubleOp) {
+    if (IS_SMALL_INT(left) && IS_SMALL_INT(right)) {
+        int64_t value = 0;
+        if (likely(!intOp(SMALL_INT_VAL(left), SMALL_INT_VAL(right), &value))) {
+            return NEW_INT(value);
+        }
+        // on overflow, the primitive promotes the result to a big integer
+        return nullptr;
+    }
+    if (isSmallIntOrDouble(left) && isSmallIntOrDouble(right)) {
+        return Universe::NewDouble(doubleOp(asDouble(left), asDouble(right)));
+    }
+    return nullptr;
+}
+
+template <typename Comparison>
+static inline vm_oop_t tryComparison(vm_oop_t left, vm_oop_t right,
+                                     Comparison cmp) {
+    bool result = false;
+
+    if (IS_SMALL_INT(left) && IS_SMALL_INT(right)) {
+        result = cmp(SMALL_INT_VAL(left), SMALL_INT_VAL(right));
+    } else if (isSmallIntOrDouble(left) && isSmallIntOrDouble(right)) {
+        result = cmp(asDouble(left), asDouble(right));
+    } else {
+        return nullptr;
+    }
+
+    return result ? load_ptr(trueObject) : load_ptr(falseObject);
+}
+
+static inline vm_oop_t tryEqualEqual(vm_oop_t left, vm_oop_t right) {
+    // boxed integers are compared by value, everything else may redefine #==
+    if (!IS_SMALL_INT(left) || !IS_SMALL_INT(right)) {
+        return nullptr;
+    }
+
+    bool const result = SMALL_INT_VAL(left) == SMALL_INT_VAL(right);
+    return result ? load_ptr(trueObject) : load_ptr(falseObject);
+}
+
+// The bodies of the bytecodes that can be combined into superinstructions, see
+// Superinstructions.h. They expect PROLOGUE() to have moved ip past the
+// bytecode already.
+#define OP_DUP() PUSH(load_ptr(*sp))
+#define OP_DUP_SECOND() PUSH(load_ptr(sp[-1]))
+#define OP_PUSH_LOCAL()                                        \
+    {                                                          \
+        auto const& local = ip[-3].variable;                   \
+        assert((local.index > 2 || local.contextLevel != 0) && \
+               "should have been BC_PUSH_LOCAL_0|1|2");        \
+        PUSH(fp->GetLocal(local.index, local.contextLevel));   \
+    }
+#define OP_PUSH_LOCAL_0() PUSH(fp->GetLocalInCurrentContext(0))
+#define OP_PUSH_LOCAL_1() PUSH(fp->GetLocalInCurrentContext(1))
+#define OP_PUSH_LOCAL_2() PUSH(fp->GetLocalInCurrentContext(2))
+#define OP_PUSH_ARGUMENT()                                            \
+    {                                                                 \
+        auto const& argument = ip[-3].variable;                       \
+        assert((argument.index > 2 || argument.contextLevel != 0) &&  \
+               "should have been BC_PUSH_SELF|ARG_1|ARG_2");          \
+        PUSH(fp->GetArgument(argument.index, argument.contextLevel)); \
+    }
+#define OP_PUSH_SELF() PUSH(fp->GetArgumentInCurrentContext(0))
+#define OP_PUSH_ARG_1() PUSH(fp->GetArgumentInCurrentContext(1))
+#define OP_PUSH_ARG_2() PUSH(fp->GetArgumentInCurrentContext(2))
+#define OP_PUSH_FIELD()                               \
+    {                                                 \
+        uint8_t const field = ip[-2].variable.index;  \
+        assert(field != 0 && field != 1 &&            \
+               "should have been BC_PUSH_FIELD_0|1"); \
+        PUSH(loadSelfField(field));                   \
+    }
+#define OP_PUSH_FIELD_0() PUSH(loadSelfField(0))
+#define OP_PUSH_FIELD_1() PUSH(loadSelfField(1))
+#define OP_PUSH_BLOCK() CALL(doPushBlock(bytecodeIndexGlobal - 2))
+#define OP_PUSH_CONSTANT() PUSH(load_ptr(ip[-2].literal))
+#define OP_PUSH_CONSTANT_0() PUSH(load_ptr(ip[-1].literal))
+#define OP_PUSH_CONSTANT_1() PUSH(load_ptr(ip[-1].literal))
+#define OP_PUSH_CONSTANT_2() PUSH(load_ptr(ip[-1].literal))
+#define OP_PUSH_0() PUSH(NEW_INT(0))
+#define OP_PUSH_1() PUSH(NEW_INT(1))
+#define OP_PUSH_NIL() PUSH(load_ptr(nilObject))
+#define OP_PUSH_GLOBAL()                                                \
+    {                                                                   \
+        vm_oop_t const value =                                          \
+            static_cast<VMAssociation*>(load_ptr(ip[-2].literal))       \
+                ->GetValue();                                           \
+        if (likely(value != nullptr)) {                                 \
+            PUSH(value);                                                \
+        } else {                                                        \
+            CALL(doPushGlobal(bytecodeIndexGlobal - 2));                \
+        }                                                               \
+    }
+#define OP_POP() sp -= 1
+#define OP_POP_LOCAL()                                                    \
+    {                                                                     \
+        fp->SetLocal(ip[-3].variable.index, ip[-3].variable.contextLevel, \
+                     load_ptr(*sp));                                      \
+        sp -= 1;                                                          \
+    }
+#define OP_POP_LOCAL_0()                \
+    {                                   \
+        fp->SetLocal(0, load_ptr(*sp)); \
+        sp -= 1;                        \
+    }
+#define OP_POP_LOCAL_1()                \
+    {                                   \
+        fp->SetLocal(1, load_ptr(*sp)); \
+        sp -= 1;                        \
+    }
+#define OP_POP_LOCAL_2()                \
+    {                                   \
+        fp->SetLocal(2, load_ptr(*sp)); \
+        sp -= 1;                        \
+    }
+#define OP_POP_ARGUMENT()                                                    \
+    {                                                                        \
+        fp->SetArgument(ip[-3].variable.index, ip[-3].variable.contextLevel, \
+                        load_ptr(*sp));                                      \
+        sp -= 1;                                                             \
+    }
+#define OP_POP_FIELD()                                        \
+    {                                                         \
+        storeSelfField(ip[-2].variable.index, load_ptr(*sp)); \
+        sp -= 1;                                              \
+    }
+#define OP_POP_FIELD_0()                  \
+    {                                     \
+        storeSelfField(0, load_ptr(*sp)); \
+        sp -= 1;                          \
+    }
+#define OP_POP_FIELD_1()                  \
+    {                                     \
+        storeSelfField(1, load_ptr(*sp)); \
+        sp -= 1;                          \
+    }
+#define OP_SEND() CALL(doSend(bytecodeIndexGlobal - 2))
+#define OP_SEND_1() CALL(doUnarySend(bytecodeIndexGlobal - 2))
+#define OP_SEND_2() CALL(doBinarySend(bytecodeIndexGlobal - 2))
+#define OP_SEND_3() CALL(doTernarySend(bytecodeIndexGlobal - 2))
+#define OP_SEND_N() CALL(doSend(bytecodeIndexGlobal - 2))
+#define OP_SUPER_SEND() CALL(doSuperSend(bytecodeIndexGlobal - 3))
+#define OP_SEND_PRIM_UNARY() CALL(doSendPrimUnary(bytecodeIndexGlobal - 2))
+#define OP_SEND_PRIM_BINARY() CALL(doSendPrimBinary(bytecodeIndexGlobal - 2))
+#define OP_SEND_GETTER() CALL(doSendGetter(bytecodeIndexGlobal - 2))
+#define OP_SEND_SETTER() CALL(doSendSetter(bytecodeIndexGlobal - 2))
+#define OP_SEND_METHOD() CALL(doSendMethod(bytecodeIndexGlobal - 2))
+#define OP_ADD()                                                    \
+    BINARY_FAST_PATH(tryArithmetic(load_ptr(sp[-1]), load_ptr(*sp), \
+                                   addWithOverflow, std::plus<>()))
+#define OP_SUB()                                                    \
+    BINARY_FAST_PATH(tryArithmetic(load_ptr(sp[-1]), load_ptr(*sp), \
+                                   subWithOverflow, std::minus<>()))
+#define OP_MUL()                                                    \
+    BINARY_FAST_PATH(tryArithmetic(load_ptr(sp[-1]), load_ptr(*sp), \
+                                   mulWithOverflow, std::multiplies<>()))
+#define OP_LT()       \
+    BINARY_FAST_PATH( \
+        tryComparison(load_ptr(sp[-1]), load_ptr(*sp), std::less<>()))
+#define OP_GT()       \
+    BINARY_FAST_PATH( \
+        tryComparison(load_ptr(sp[-1]), load_ptr(*sp), std::greater<>()))
+#define OP_LE()                                                     \
+    BINARY_FAST_PATH(tryComparison(load_ptr(sp[-1]), load_ptr(*sp), \
+                                   std::less_equal<>()))
+#define OP_GE()                                                     \
+    BINARY_FAST_PATH(tryComparison(load_ptr(sp[-1]), load_ptr(*sp), \
+                                   std::greater_equal<>()))
+#define OP_EQ()       \
+    BINARY_FAST_PATH( \
+        tryComparison(load_ptr(sp[-1]), load_ptr(*sp), std::equal_to<>()))
+#define OP_EQ_EQ() \
+    BINARY_FAST_PATH(tryEqualEqual(load_ptr(sp[-1]), load_ptr(*sp)))
+#define OP_RETURN_LOCAL() CALL(doReturnLocal())
+#define OP_RETURN_NON_LOCAL() CALL(doReturnNonLocal())
+#define OP_RETURN_SELF()                                                 \
+    {                                                                    \
+        assert(fp->GetContext() == nullptr &&                            \
+               "RETURN_SELF is not allowed in blocks");                  \
+        CALL(popFrameAndPushResult(fp->GetArgumentInCurrentContext(0))); \
+    }
+#define OP_RETURN_FIELD_0() CALL(popFrameAndPushResult(loadSelfField(0)))
+#define OP_RETURN_FIELD_1() CALL(popFrameAndPushResult(loadSelfField(1)))
+#define OP_RETURN_FIELD_2() CALL(popFrameAndPushResult(loadSelfField(2)))
+#define OP_INC() SET_TOP(increment(load_ptr(*sp)))
+#define OP_DEC() SET_TOP(decrement(load_ptr(*sp)))
+#define OP_INC_FIELD() incrementField(ip[-2].variable.index)
+#define OP_INC_FIELD_PUSH() PUSH(incrementField(ip[-2].variable.index))
+#define OP_LOOP_COUNTER() \
+    PUSH(NEW_INT(*fp->GetLoopSlot(ip[-2].variable.index)))
 
 template <bool PrintBytecodes>
 vm_oop_t Interpreter::Start() {
 #ifdef BYTECODE_HEATMAP
-  #define HEATMAP_INC() method->heatmap[bytecodeIndexGlobal]++
+  #define HEATMAP_INC() method->heatmap[ip - currentDecodedBytecodes]++
 #else
   #define HEATMAP_INC() ((void)0)
 #endif
-#define PROLOGUE(bcCount)                 \
-    {                                     \
-        if constexpr (PrintBytecodes) {   \
-            disassembleMethod();          \
-        }                                 \
-        HEATMAP_INC();                    \
-        bytecodeIndexGlobal += (bcCount); \
+#define PROLOGUE(bcCount)               \
+    {                                   \
+        if constexpr (PrintBytecodes) { \
+            SPILL();                    \
+            disassembleMethod();        \
+        }                               \
+        HEATMAP_INC();                  \
+        ip += (bcCount);                \
     }
 
+    // the decoded bytecodes refer to the handlers, and the table lives as long
+    // as they do
+    static void const* const loopTargets[] = {&&LABEL_BC_HALT,
+                                              &&LABEL_BC_DUP,
+                                              &&LABEL_BC_DUP_SECOND,
+                                              &&LABEL_BC_PUSH_LOCAL,
+                                              &&LABEL_BC_PUSH_LOCAL_0,
+                                              &&LABEL_BC_PUSH_LOCAL_1,
+                                              &&LABEL_BC_PUSH_LOCAL_2,
+                                              &&LABEL_BC_PUSH_ARGUMENT,
+                                              &&LABEL_BC_PUSH_SELF,
+                                              &&LABEL_BC_PUSH_ARG_1,
+                                              &&LABEL_BC_PUSH_ARG_2,
+                                              &&LABEL_BC_PUSH_FIELD,
+                                              &&LABEL_BC_PUSH_FIELD_0,
+                                              &&LABEL_BC_PUSH_FIELD_1,
+                                              &&LABEL_BC_PUSH_BLOCK,
+                                              &&LABEL_BC_PUSH_CONSTANT,
+                                              &&LABEL_BC_PUSH_CONSTANT_0,
+                                              &&LABEL_BC_PUSH_CONSTANT_1,
+                                              &&LABEL_BC_PUSH_CONSTANT_2,
+                                              &&LABEL_BC_PUSH_0,
+                                              &&LABEL_BC_PUSH_1,
+                                              &&LABEL_BC_PUSH_NIL,
+                                              &&LABEL_BC_PUSH_GLOBAL,
+                                              &&LABEL_BC_POP,
+                                              &&LABEL_BC_POP_LOCAL,
+                                              &&LABEL_BC_POP_LOCAL_0,
+                                              &&LABEL_BC_POP_LOCAL_1,
+                                              &&LABEL_BC_POP_LOCAL_2,
+                                              &&LABEL_BC_POP_ARGUMENT,
+                                              &&LABEL_BC_POP_FIELD,
+                                              &&LABEL_BC_POP_FIELD_0,
+                                              &&LABEL_BC_POP_FIELD_1,
+                                              &&LABEL_BC_SEND,
+                                              &&LABEL_BC_SEND_1,
+                                              &&LABEL_BC_SUPER_SEND,
+                                              &&LABEL_BC_RETURN_LOCAL,
+                                              &&LABEL_BC_RETURN_NON_LOCAL,
+                                              &&LABEL_BC_RETURN_SELF,
+                                              &&LABEL_BC_RETURN_FIELD_0,
+                                              &&LABEL_BC_RETURN_FIELD_1,
+                                              &&LABEL_BC_RETURN_FIELD_2,
+                                              &&LABEL_BC_INC,
+                                              &&LABEL_BC_DEC,
+                                              &&LABEL_BC_INC_FIELD,
+                                              &&LABEL_BC_INC_FIELD_PUSH,
+                                              &&LABEL_BC_JUMP,
+                                              &&LABEL_BC_JUMP_ON_FALSE_POP,
+                                              &&LABEL_BC_JUMP_ON_TRUE_POP,
+                                              &&LABEL_BC_JUMP_ON_FALSE_TOP_NIL,
+                                              &&LABEL_BC_JUMP_ON_TRUE_TOP_NIL,
+                                              &&LABEL_BC_JUMP_ON_NOT_NIL_POP,
+                                              &&LABEL_BC_JUMP_ON_NIL_POP,
+                                              &&LABEL_BC_JUMP_ON_NOT_NIL_TOP_TOP,
+                                              &&LABEL_BC_JUMP_ON_NIL_TOP_TOP,
+                                              &&LABEL_BC_JUMP_IF_GREATER,
+                                              &&LABEL_BC_JUMP_IF_LESS,
+                                              &&LABEL_BC_JUMP_BACKWARD,
+                                              &&LABEL_BC_JUMP2,
+                                              &&LABEL_BC_JUMP2_ON_FALSE_POP,
+                                              &&LABEL_BC_JUMP2_ON_TRUE_POP,
+                                              &&LABEL_BC_JUMP2_ON_FALSE_TOP_NIL,
+                                              &&LABEL_BC_JUMP2_ON_TRUE_TOP_NIL,
+                                              &&LABEL_BC_JUMP2_ON_NOT_NIL_POP,
+                                              &&LABEL_BC_JUMP2_ON_NIL_POP,
+                                              &&LABEL_BC_JUMP2_ON_NOT_NIL_TOP_TOP,
+                                              &&LABEL_BC_JUMP2_ON_NIL_TOP_TOP,
+                                              &&LABEL_BC_JUMP2_IF_GREATER,
+                                              &&LABEL_BC_JUMP2_IF_LESS,
+                                              &&LABEL_BC_JUMP2_BACKWARD,
+                                              &&LABEL_BC_LOOP_START,
+                                              &&LABEL_BC_LOOP_NEXT,
+                                              &&LABEL_BC_LOOP_COUNTER,
+                                              &&LABEL_BC_SEND_2,
+                                              &&LABEL_BC_SEND_3,
+                                              &&LABEL_BC_SEND_N,
+                                              &&LABEL_BC_ADD,
+                                              &&LABEL_BC_SUB,
+                                              &&LABEL_BC_MUL,
+                                              &&LABEL_BC_LT,
+                                              &&LABEL_BC_GT,
+                                              &&LABEL_BC_LE,
+                                              &&LABEL_BC_GE,
+                                              &&LABEL_BC_EQ,
+                                              &&LABEL_BC_EQ_EQ,
+                                              &&LABEL_BC_SEND_PRIM_UNARY,
+                                              &&LABEL_BC_SEND_PRIM_BINARY,
+                                              &&LABEL_BC_SEND_GETTER,
+                                              &&LABEL_BC_SEND_SETTER,
+                                              &&LABEL_BC_SEND_METHOD,
+                                              SUPERINSTRUCTION_LOOP_TARGETS};
+
     // initialization
     method = GetMethod();
     currentBytecodes = GetBytecodes();
+    assert((dispatchTable == nullptr || dispatchTable == loopTargets) &&
+           "the bytecodes are decoded for one interpreter loop only");
+    dispatchTable = loopTargets;
+    currentDecodedBytecodes = method->GetDecodedBytecodes(dispatchTable);
+
+    // the instruction pointer, the stack pointer, and the frame are kept in
+    // locals, and are only written back to bytecodeIndexGlobal and the frame
+    // with SPILL() before anything that may look at them
+    VMFrame* fp = nullptr;
+    DecodedBytecode* ip = nullptr;
+    gc_oop_t* sp = nullptr;
+    RELOAD();
 
-    void const* const loopTargets[] = {&&LABEL_BC_HALT,
-                                       &&LABEL_BC_DUP,
-                                       &&LABEL_BC_DUP_SECOND,
-                                       &&LABEL_BC_PUSH_LOCAL,
-                                       &&LABEL_BC_PUSH_LOCAL_0,
-                                       &&LABEL_BC_PUSH_LOCAL_1,
-                                       &&LABEL_BC_PUSH_LOCAL_2,
-                                       &&LABEL_BC_PUSH_ARGUMENT,
-                                       &&LABEL_BC_PUSH_SELF,
-                                       &&LABEL_BC_PUSH_ARG_1,
-                                       &&LABEL_BC_PUSH_ARG_2,
-                                       &&LABEL_BC_PUSH_FIELD,
-                                       &&LABEL_BC_PUSH_FIELD_0,
-                                       &&LABEL_BC_PUSH_FIELD_1,
-                                       &&LABEL_BC_PUSH_BLOCK,
-                                       &&LABEL_BC_PUSH_CONSTANT,
-                                       &&LABEL_BC_PUSH_CONSTANT_0,
-                                       &&LABEL_BC_PUSH_CONSTANT_1,
-                                       &&LABEL_BC_PUSH_CONSTANT_2,
-                                       &&LABEL_BC_PUSH_0,
-                                       &&LABEL_BC_PUSH_1,
-                                       &&LABEL_BC_PUSH_NIL,
-                                       &&LABEL_BC_PUSH_GLOBAL,
-                                       &&LABEL_BC_POP,
-                                       &&LABEL_BC_POP_LOCAL,
-                                       &&LABEL_BC_POP_LOCAL_0,
-                                       &&LABEL_BC_POP_LOCAL_1,
-                                       &&LABEL_BC_POP_LOCAL_2,
-                                       &&LABEL_BC_POP_ARGUMENT,
-                                       &&LABEL_BC_POP_FIELD,
-                                       &&LABEL_BC_POP_FIELD_0,
-                                       &&LABEL_BC_POP_FIELD_1,
-                                       &&LABEL_BC_SEND,
-                                       &&LABEL_BC_SEND_1,
-                                       &&LABEL_BC_SUPER_SEND,
-                                       &&LABEL_BC_RETURN_LOCAL,
-                                       &&LABEL_BC_RETURN_NON_LOCAL,
-                                       &&LABEL_BC_RETURN_SELF,
-                                       &&LABEL_BC_RETURN_FIELD_0,
-                                       &&LABEL_BC_RETURN_FIELD_1,
-                                       &&LABEL_BC_RETURN_FIELD_2,
-                                       &&LABEL_BC_INC,
-                                       &&LABEL_BC_DEC,
-                                       &&LABEL_BC_INC_FIELD,
-                                       &&LABEL_BC_INC_FIELD_PUSH,
-                                       &&LABEL_BC_JUMP,
-                                       &&LABEL_BC_JUMP_ON_FALSE_POP,
-                                       &&LABEL_BC_JUMP_ON_TRUE_POP,
-                                       &&LABEL_BC_JUMP_ON_FALSE_TOP_NIL,
-                                       &&LABEL_BC_JUMP_ON_TRUE_TOP_NIL,
-                                       &&LABEL_BC_JUMP_ON_NOT_NIL_POP,
-                                       &&LABEL_BC_JUMP_ON_NIL_POP,
-                                       &&LABEL_BC_JUMP_ON_NOT_NIL_TOP_TOP,
-                                       &&LABEL_BC_JUMP_ON_NIL_TOP_TOP,
-                                       &&LABEL_BC_JUMP_IF_GREATER,
-                                       &&LABEL_BC_JUMP_BACKWARD,
-                                       &&LABEL_BC_JUMP2,
-                                       &&LABEL_BC_JUMP2_ON_FALSE_POP,
-                                       &&LABEL_BC_JUMP2_ON_TRUE_POP,
-                                       &&LABEL_BC_JUMP2_ON_FALSE_TOP_NIL,
-                                       &&LABEL_BC_JUMP2_ON_TRUE_TOP_NIL,
-                                       &&LABEL_BC_JUMP2_ON_NOT_NIL_POP,
-                                       &&LABEL_BC_JUMP2_ON_NIL_POP,
-                                       &&LABEL_BC_JUMP2_ON_NOT_NIL_TOP_TOP,
-                                       &&LABEL_BC_JUMP2_ON_NIL_TOP_TOP,
-                                       &&LABEL_BC_JUMP2_IF_GREATER,
-                                       &&LABEL_BC_JUMP2_BACKWARD};
-
-    goto* loopTargets[currentBytecodes[bytecodeIndexGlobal]];
+    DISPATCH_NOGC();
 
     //
     // THIS IS THE former interpretation loop
 LABEL_BC_HALT:
     PROLOGUE(1);
-    return GetFrame()->GetStackElement(0);  // handle the halt bytecode
+    SPILL();
+    return load_ptr(*sp);  // handle the halt bytecode
 
 LABEL_BC_DUP:
     PROLOGUE(1);
-    doDup();
+    OP_DUP();
     DISPATCH_NOGC();
 
 LABEL_BC_DUP_SECOND:
     PROLOGUE(1);
-    {
-        vm_oop_t elem = GetFrame()->GetStackElement(1);
-        GetFrame()->Push(elem);
-    }
+    OP_DUP_SECOND();
     DISPATCH_NOGC();
 
 LABEL_BC_PUSH_LOCAL:
     PROLOGUE(3);
-    doPushLocal(bytecodeIndexGlobal - 3);
+    OP_PUSH_LOCAL();
     DISPATCH_NOGC();
 
 LABEL_BC_PUSH_LOCAL_0:
     PROLOGUE(1);
-    doPushLocalWithIndex(0);
+    OP_PUSH_LOCAL_0();
     DISPATCH_NOGC();
 
 LABEL_BC_PUSH_LOCAL_1:
     PROLOGUE(1);
-    doPushLocalWithIndex(1);
+    OP_PUSH_LOCAL_1();
     DISPATCH_NOGC();
 
 LABEL_BC_PUSH_LOCAL_2:
     PROLOGUE(1);
-    doPushLocalWithIndex(2);
+    OP_PUSH_LOCAL_2();
     DISPATCH_NOGC();
 
 LABEL_BC_PUSH_ARGUMENT:
     PROLOGUE(3);
-    doPushArgument(bytecodeIndexGlobal - 3);
+    OP_PUSH_ARGUMENT();
     DISPATCH_NOGC();
 
 LABEL_BC_PUSH_SELF:
     PROLOGUE(1);
-    {
-        vm_oop_t argument = GetFrame()->GetArgumentInCurrentContext(0);
-        GetFrame()->Push(argument);
-    }
+    OP_PUSH_SELF();
     DISPATCH_NOGC();
 
 LABEL_BC_PUSH_ARG_1:
     PROLOGUE(1);
-    {
-        vm_oop_t argument = GetFrame()->GetArgumentInCurrentContext(1);
-        GetFrame()->Push(argument);
-    }
+    OP_PUSH_ARG_1();
     DISPATCH_NOGC();
 
 LABEL_BC_PUSH_ARG_2:
     PROLOGUE(1);
-    {
-        vm_oop_t argument = GetFrame()->GetArgumentInCurrentContext(2);
-        GetFrame()->Push(argument);
-    }
+    OP_PUSH_ARG_2();
     DISPATCH_NOGC();
 
 LABEL_BC_PUSH_FIELD:
     PROLOGUE(2);
-    doPushField(bytecodeIndexGlobal - 2);
+    OP_PUSH_FIELD();
     DISPATCH_NOGC();
 
 LABEL_BC_PUSH_FIELD_0:
     PROLOGUE(1);
-    doPushFieldWithIndex(0);
+    OP_PUSH_FIELD_0();
     DISPATCH_NOGC();
 
 LABEL_BC_PUSH_FIELD_1:
     PROLOGUE(1);
-    doPushFieldWithIndex(1);
+    OP_PUSH_FIELD_1();
     DISPATCH_NOGC();
 
 LABEL_BC_PUSH_BLOCK:
     PROLOGUE(2);
-    doPushBlock(bytecodeIndexGlobal - 2);
+    OP_PUSH_BLOCK();
     DISPATCH_GC();
 
 LABEL_BC_PUSH_CONSTANT:
     PROLOGUE(2);
-    doPushConstant(bytecodeIndexGlobal - 2);
+    OP_PUSH_CONSTANT();
     DISPATCH_NOGC();
 
 LABEL_BC_PUSH_CONSTANT_0:
     PROLOGUE(1);
-    {
-        vm_oop_t constant = method->GetIndexableField(0);
-        GetFrame()->Push(constant);
-    }
+    OP_PUSH_CONSTANT_0();
     DISPATCH_NOGC();
 
 LABEL_BC_PUSH_CONSTANT_1:
     PROLOGUE(1);
-    {
-        vm_oop_t constant = method->GetIndexableField(1);
-        GetFrame()->Push(constant);
-    }
+    OP_PUSH_CONSTANT_1();
     DISPATCH_NOGC();
 
 LABEL_BC_PUSH_CONSTANT_2:
     PROLOGUE(1);
-    {
-        vm_oop_t constant = method->GetIndexableField(2);
-        GetFrame()->Push(constant);
-    }
+    OP_PUSH_CONSTANT_2();
     DISPATCH_NOGC();
 
 LABEL_BC_PUSH_0:
     PROLOGUE(1);
-    GetFrame()->Push(NEW_INT(0));
+    OP_PUSH_0();
     DISPATCH_NOGC();
 
 LABEL_BC_PUSH_1:
     PROLOGUE(1);
-    GetFrame()->Push(NEW_INT(1));
+    OP_PUSH_1();
     DISPATCH_NOGC();
 
 LABEL_BC_PUSH_NIL:
     PROLOGUE(1);
-    GetFrame()->Push(load_ptr(nilObject));
+    OP_PUSH_NIL();
     DISPATCH_NOGC();
 
 LABEL_BC_PUSH_GLOBAL:
     PROLOGUE(2);
-    doPushGlobal(bytecodeIndexGlobal - 2);
+    OP_PUSH_GLOBAL();
     DISPATCH_GC();
 
 LABEL_BC_POP:
     PROLOGUE(1);
-    doPop();
+    OP_POP();
     DISPATCH_NOGC();
 
 LABEL_BC_POP_LOCAL:
     PROLOGUE(3);
-    doPopLocal(bytecodeIndexGlobal - 3);
+    OP_POP_LOCAL();
     DISPATCH_NOGC();
 
 LABEL_BC_POP_LOCAL_0:
     PROLOGUE(1);
-    doPopLocalWithIndex(0);
+    OP_POP_LOCAL_0();
     DISPATCH_NOGC();
 
 LABEL_BC_POP_LOCAL_1:
     PROLOGUE(1);
-    doPopLocalWithIndex(1);
+    OP_POP_LOCAL_1();
     DISPATCH_NOGC();
 
 LABEL_BC_POP_LOCAL_2:
     PROLOGUE(1);
-    doPopLocalWithIndex(2);
+    OP_POP_LOCAL_2();
     DISPATCH_NOGC();
 
 LABEL_BC_POP_ARGUMENT:
     PROLOGUE(3);
-    doPopArgument(bytecodeIndexGlobal - 3);
+    OP_POP_ARGUMENT();
     DISPATCH_NOGC();
 
 LABEL_BC_POP_FIELD:
     PROLOGUE(2);
-    doPopField(bytecodeIndexGlobal - 2);
+    OP_POP_FIELD();
     DISPATCH_NOGC();
 
 LABEL_BC_POP_FIELD_0:
     PROLOGUE(1);
-    doPopFieldWithIndex(0);
+    OP_POP_FIELD_0();
     DISPATCH_NOGC();
 
 LABEL_BC_POP_FIELD_1:
     PROLOGUE(1);
-    doPopFieldWithIndex(1);
+    OP_POP_FIELD_1();
     DISPATCH_NOGC();
 
 LABEL_BC_SEND:
     PROLOGUE(2);
-    doSend(bytecodeIndexGlobal - 2);
+    OP_SEND();
     DISPATCH_GC();
 
 LABEL_BC_SEND_1:
     PROLOGUE(2);
-    doUnarySend(bytecodeIndexGlobal - 2);
+    OP_SEND_1();
     DISPATCH_GC();
 
-LABEL_BC_SUPER_SEND:
+LABEL_BC_SEND_2:
+    PROLOGUE(2);
+    OP_SEND_2();
+    DISPATCH_GC();
+
+LABEL_BC_SEND_3:
+    PROLOGUE(2);
+    OP_SEND_3();
+    DISPATCH_GC();
+
+LABEL_BC_SEND_N:
+    PROLOGUE(2);
+    OP_SEND_N();
+    DISPATCH_GC();
+
+LABEL_BC_ADD:
+    PROLOGUE(2);
+    OP_ADD();
+    DISPATCH_GC();
+
+LABEL_BC_SUB:
+    PROLOGUE(2);
+    OP_SUB();
+    DISPATCH_GC();
+
+LABEL_BC_MUL:
+    PROLOGUE(2);
+    OP_MUL();
+    DISPATCH_GC();
+
+LABEL_BC_LT:
+    PROLOGUE(2);
+    OP_LT();
+    DISPATCH_GC();
+
+LABEL_BC_GT:
+    PROLOGUE(2);
+    OP_GT();
+    DISPATCH_GC();
+
+LABEL_BC_LE:
+    PROLOGUE(2);
+    OP_LE();
+    DISPATCH_GC();
+
+LABEL_BC_GE:
+    PROLOGUE(2);
+    OP_GE();
+    DISPATCH_GC();
+
+LABEL_BC_EQ:
+    PROLOGUE(2);
+    OP_EQ();
+    DISPATCH_GC();
+
+LABEL_BC_EQ_EQ:
     PROLOGUE(2);
-    doSuperSend(bytecodeIndexGlobal - 2);
+    OP_EQ_EQ();
+    DISPATCH_GC();
+
+LABEL_BC_SUPER_SEND:
+    PROLOGUE(3);
+    OP_SUPER_SEND();
     DISPATCH_GC();
 
 LABEL_BC_RETURN_LOCAL:
     PROLOGUE(1);
-    doReturnLocal();
+    OP_RETURN_LOCAL();
     DISPATCH_NOGC();
 
 LABEL_BC_RETURN_NON_LOCAL:
     PROLOGUE(1);
-    doReturnNonLocal();
+    OP_RETURN_NON_LOCAL();
     DISPATCH_NOGC();
 
-LABEL_BC_RETURN_SELF: {
+LABEL_BC_RETURN_SELF:
     PROLOGUE(1);
-    assert(GetFrame()->GetContext() == nullptr &&
-           "RETURN_SELF is not allowed in blocks");
-    popFrameAndPushResult(GetFrame()->GetArgumentInCurrentContext(0));
+    OP_RETURN_SELF();
     DISPATCH_NOGC();
-}
 
 LABEL_BC_RETURN_FIELD_0:
     PROLOGUE(1);
-    doReturnFieldWithIndex(0);
+    OP_RETURN_FIELD_0();
     DISPATCH_NOGC();
 
 LABEL_BC_RETURN_FIELD_1:
     PROLOGUE(1);
-    doReturnFieldWithIndex(1);
+    OP_RETURN_FIELD_1();
     DISPATCH_NOGC();
 
 LABEL_BC_RETURN_FIELD_2:
     PROLOGUE(1);
-    doReturnFieldWithIndex(2);
+    OP_RETURN_FIELD_2();
     DISPATCH_NOGC();
 
 LABEL_BC_INC:
     PROLOGUE(1);
-    doInc();
+    OP_INC();
 #if USE_TAGGING
     DISPATCH_NOGC();
 #else
-    // without integer tagging doInc() allocates memory and the IfNil benchmark
-    // will allocate, but not reach a GC point, and run out of memory
+    // without integer tagging increment() allocates memory and the IfNil
+    // benchmark will allocate, but not reach a GC point, and run out of memory
     DISPATCH_GC();
 #endif
 
 LABEL_BC_DEC:
     PROLOGUE(1);
-    doDec();
+    OP_DEC();
     DISPATCH_NOGC();
 
 LABEL_BC_INC_FIELD:
     PROLOGUE(2);
-    doIncField(currentBytecodes[bytecodeIndexGlobal - 1]);
+    OP_INC_FIELD();
     DISPATCH_NOGC();
 
 LABEL_BC_INC_FIELD_PUSH:
     PROLOGUE(2);
-    doIncFieldPush(currentBytecodes[bytecodeIndexGlobal - 1]);
+    OP_INC_FIELD_PUSH();
     DISPATCH_NOGC();
 
-LABEL_BC_JUMP: {
-    uint8_t const offset = currentBytecodes[bytecodeIndexGlobal + 1];
-    bytecodeIndexGlobal += offset;
-}
+LABEL_BC_JUMP:
+    ip = ip->jumpTarget;
     DISPATCH_NOGC();
 
-LABEL_BC_JUMP_ON_FALSE_POP: {
-    vm_oop_t val = GetFrame()->Top();
-    if (val == load_ptr(falseObject)) {
-        uint8_t const offset = currentBytecodes[bytecodeIndexGlobal + 1];
-        bytecodeIndexGlobal += offset;
-    } else {
-        bytecodeIndexGlobal += 3;
-    }
-    GetFrame()->PopVoid();
-}
+LABEL_BC_JUMP_ON_FALSE_POP:
+    ip = load_ptr(*sp) == load_ptr(falseObject) ? ip->jumpTarget : ip + 3;
+    sp -= 1;
+    DISPATCH_NOGC();
+
+LABEL_BC_JUMP_ON_TRUE_POP:
+    ip = load_ptr(*sp) == load_ptr(trueObject) ? ip->jumpTarget : ip + 3;
+    sp -= 1;
     DISPATCH_NOGC();
 
-LABEL_BC_JUMP_ON_TRUE_POP: {
-    vm_oop_t val = GetFrame()->Top();
-    if (val == load_ptr(trueObject)) {
-        uint8_t const offset = currentBytecodes[bytecodeIndexGlobal + 1];
-        bytecodeIndexGlobal += offset;
+LABEL_BC_JUMP_ON_FALSE_TOP_NIL:
+    if (load_ptr(*sp) == load_ptr(falseObject)) {
+        ip = ip->jumpTarget;
+        *sp = nilObject;
     } else {
-        bytecodeIndexGlobal += 3;
+        ip += 3;
+        sp -= 1;
     }
-    GetFrame()->PopVoid();
-}
     DISPATCH_NOGC();
 
-LABEL_BC_JUMP_ON_FALSE_TOP_NIL: {
-    vm_oop_t val = GetFrame()->Top();
-    if (val == load_ptr(falseObject)) {
-        uint8_t const offset = currentBytecodes[bytecodeIndexGlobal + 1];
-        bytecodeIndexGlobal += offset;
-        GetFrame()->SetTop(nilObject);
+LABEL_BC_JUMP_ON_TRUE_TOP_NIL:
+    if (load_ptr(*sp) == load_ptr(trueObject)) {
+        ip = ip->jumpTarget;
+        *sp = nilObject;
     } else {
-        GetFrame()->PopVoid();
-        bytecodeIndexGlobal += 3;
+        ip += 3;
+        sp -= 1;
     }
-}
     DISPATCH_NOGC();
 
-LABEL_BC_JUMP_ON_TRUE_TOP_NIL: {
-    vm_oop_t val = GetFrame()->Top();
-    if (val == load_ptr(trueObject)) {
-        uint8_t const offset = currentBytecodes[bytecodeIndexGlobal + 1];
-        bytecodeIndexGlobal += offset;
-        GetFrame()->SetTop(nilObject);
+LABEL_BC_JUMP_ON_NOT_NIL_POP:
+    ip = load_ptr(*sp) != load_ptr(nilObject) ? ip->jumpTarget : ip + 3;
+    sp -= 1;
+    DISPATCH_NOGC();
+
+LABEL_BC_JUMP_ON_NIL_POP:
+    ip = load_ptr(*sp) == load_ptr(nilObject) ? ip->jumpTarget : ip + 3;
+    sp -= 1;
+    DISPATCH_NOGC();
+
+LABEL_BC_JUMP_ON_NOT_NIL_TOP_TOP:
+    if (load_ptr(*sp) != load_ptr(nilObject)) {
+        ip = ip->jumpTarget;
     } else {
-        GetFrame()->PopVoid();
-        bytecodeIndexGlobal += 3;
+        ip += 3;
+        sp -= 1;
     }
-}
     DISPATCH_NOGC();
 
-LABEL_BC_JUMP_ON_NOT_NIL_POP: {
-    vm_oop_t val = GetFrame()->Top();
-    if (val != load_ptr(nilObject)) {
-        uint8_t const offset = currentBytecodes[bytecodeIndexGlobal + 1];
-        bytecodeIndexGlobal += offset;
+LABEL_BC_JUMP_ON_NIL_TOP_TOP:
+    if (load_ptr(*sp) == load_ptr(nilObject)) {
+        ip = ip->jumpTarget;
     } else {
-        bytecodeIndexGlobal += 3;
+        ip += 3;
+        sp -= 1;
     }
-    GetFrame()->PopVoid();
-}
     DISPATCH_NOGC();
 
-LABEL_BC_JUMP_ON_NIL_POP: {
-    vm_oop_t val = GetFrame()->Top();
-    if (val == load_ptr(nilObject)) {
-        uint8_t const offset = currentBytecodes[bytecodeIndexGlobal + 1];
-        bytecodeIndexGlobal += offset;
+LABEL_BC_JUMP_IF_GREATER:
+    if (checkIsGreater(load_ptr(*sp), load_ptr(sp[-1]))) {
+        ip = ip->jumpTarget;
+        sp -= 2;
     } else {
-        bytecodeIndexGlobal += 3;
+        ip += 3;
     }
-    GetFrame()->PopVoid();
-}
     DISPATCH_NOGC();
 
-LABEL_BC_JUMP_ON_NOT_NIL_TOP_TOP: {
-    vm_oop_t val = GetFrame()->Top();
-    if (val != load_ptr(nilObject)) {
-        uint8_t const offset = currentBytecodes[bytecodeIndexGlobal + 1];
-        bytecodeIndexGlobal += offset;
-        // GetFrame()->SetTop(val);
+LABEL_BC_JUMP_IF_LESS:
+    if (checkIsGreater(load_ptr(sp[-1]), load_ptr(*sp))) {
+        ip = ip->jumpTarget;
+        sp -= 2;
     } else {
-        GetFrame()->PopVoid();
-        bytecodeIndexGlobal += 3;
+        ip += 3;
     }
-}
     DISPATCH_NOGC();
 
-LABEL_BC_JUMP_ON_NIL_TOP_TOP: {
-    vm_oop_t val = GetFrame()->Top();
-    if (val == load_ptr(nilObject)) {
-        uint8_t const offset = currentBytecodes[bytecodeIndexGlobal + 1];
-        bytecodeIndexGlobal += offset;
-        // GetFrame()->SetTop(val);
+LABEL_BC_JUMP_BACKWARD:
+    ip = ip->jumpTarget;
+    COUNT_LOOP_ITERATION();
+    DISPATCH_NOGC();
+
+LABEL_BC_JUMP2:
+    ip = ip->jumpTarget;
+    DISPATCH_NOGC();
+
+LABEL_BC_JUMP2_ON_FALSE_POP:
+    ip = load_ptr(*sp) == load_ptr(falseObject) ? ip->jumpTarget : ip + 3;
+    sp -= 1;
+    DISPATCH_NOGC();
+
+LABEL_BC_JUMP2_ON_TRUE_POP:
+    ip = load_ptr(*sp) == load_ptr(trueObject) ? ip->jumpTarget : ip + 3;
+    sp -= 1;
+    DISPATCH_NOGC();
+
+LABEL_BC_JUMP2_ON_FALSE_TOP_NIL:
+    if (load_ptr(*sp) == load_ptr(falseObject)) {
+        ip = ip->jumpTarget;
+        *sp = nilObject;
     } else {
-        GetFrame()->PopVoid();
-        bytecodeIndexGlobal += 3;
+        ip += 3;
+        sp -= 1;
     }
-}
     DISPATCH_NOGC();
 
-LABEL_BC_JUMP_IF_GREATER: {
-    if (checkIsGreater()) {
-        bytecodeIndexGlobal += currentBytecodes[bytecodeIndexGlobal + 1];
-        GetFrame()->Pop();
-        GetFrame()->Pop();
+LABEL_BC_JUMP2_ON_TRUE_TOP_NIL:
+    if (load_ptr(*sp) == load_ptr(trueObject)) {
+        ip = ip->jumpTarget;
+        *sp = nilObject;
     } else {
-        bytecodeIndexGlobal += 3;
+        ip += 3;
+        sp -= 1;
     }
-}
     DISPATCH_NOGC();
 
-LABEL_BC_JUMP_BACKWARD: {
-    uint8_t const offset = currentBytecodes[bytecodeIndexGlobal + 1];
-    bytecodeIndexGlobal -= offset;
-}
+LABEL_BC_JUMP2_ON_NOT_NIL_POP:
+    ip = load_ptr(*sp) != load_ptr(nilObject) ? ip->jumpTarget : ip + 3;
+    sp -= 1;
     DISPATCH_NOGC();
 
-LABEL_BC_JUMP2: {
-    uint16_t const offset =
-        ComputeOffset(currentBytecodes[bytecodeIndexGlobal + 1],
-                      currentBytecodes[bytecodeIndexGlobal + 2]);
-    bytecodeIndexGlobal += offset;
-}
+LABEL_BC_JUMP2_ON_NIL_POP:
+    ip = load_ptr(*sp) == load_ptr(nilObject) ? ip->jumpTarget : ip + 3;
+    sp -= 1;
     DISPATCH_NOGC();
 
-LABEL_BC_JUMP2_ON_FALSE_POP: {
-    vm_oop_t val = GetFrame()->Top();
-    if (val == load_ptr(falseObject)) {
-        uint16_t const offset =
-            ComputeOffset(currentBytecodes[bytecodeIndexGlobal + 1],
-                          currentBytecodes[bytecodeIndexGlobal + 2]);
-        bytecodeIndexGlobal += offset;
+LABEL_BC_JUMP2_ON_NOT_NIL_TOP_TOP:
+    if (load_ptr(*sp) != load_ptr(nilObject)) {
+        ip = ip->jumpTarget;
     } else {
-        bytecodeIndexGlobal += 3;
+        ip += 3;
+        sp -= 1;
     }
-    GetFrame()->PopVoid();
-}
     DISPATCH_NOGC();
 
-LABEL_BC_JUMP2_ON_TRUE_POP: {
-    vm_oop_t val = GetFrame()->Top();
-    if (val == load_ptr(trueObject)) {
-        uint16_t const offset =
-            ComputeOffset(currentBytecodes[bytecodeIndexGlobal + 1],
-                          currentBytecodes[bytecodeIndexGlobal + 2]);
-        bytecodeIndexGlobal += offset;
+LABEL_BC_JUMP2_ON_NIL_TOP_TOP:
+    if (load_ptr(*sp) == load_ptr(nilObject)) {
+        ip = ip->jumpTarget;
     } else {
-        bytecodeIndexGlobal += 3;
+        ip += 3;
+        sp -= 1;
     }
-    GetFrame()->PopVoid();
-}
     DISPATCH_NOGC();
 
-LABEL_BC_JUMP2_ON_FALSE_TOP_NIL: {
-    vm_oop_t val = GetFrame()->Top();
-    if (val == load_ptr(falseObject)) {
-        uint16_t const offset =
-            ComputeOffset(currentBytecodes[bytecodeIndexGlobal + 1],
-                          currentBytecodes[bytecodeIndexGlobal + 2]);
-        bytecodeIndexGlobal += offset;
-        GetFrame()->SetTop(nilObject);
+LABEL_BC_JUMP2_IF_GREATER:
+    if (checkIsGreater(load_ptr(*sp), load_ptr(sp[-1]))) {
+        ip = ip->jumpTarget;
+        sp -= 2;
     } else {
-        GetFrame()->PopVoid();
-        bytecodeIndexGlobal += 3;
+        ip += 3;
     }
-}
     DISPATCH_NOGC();
 
-LABEL_BC_JUMP2_ON_TRUE_TOP_NIL: {
-    vm_oop_t val = GetFrame()->Top();
-    if (val == load_ptr(trueObject)) {
-        uint16_t const offset =
-            ComputeOffset(currentBytecodes[bytecodeIndexGlobal + 1],
-                          currentBytecodes[bytecodeIndexGlobal + 2]);
-        bytecodeIndexGlobal += offset;
-        GetFrame()->SetTop(nilObject);
+LABEL_BC_JUMP2_IF_LESS:
+    if (checkIsGreater(load_ptr(sp[-1]), load_ptr(*sp))) {
+        ip = ip->jumpTarget;
+        sp -= 2;
     } else {
-        GetFrame()->PopVoid();
-        bytecodeIndexGlobal += 3;
+        ip += 3;
     }
-}
     DISPATCH_NOGC();
 
-LABEL_BC_JUMP2_ON_NOT_NIL_POP: {
-    vm_oop_t val = GetFrame()->Top();
-    if (val != load_ptr(nilObject)) {
-        uint16_t const offset =
-            ComputeOffset(currentBytecodes[bytecodeIndexGlobal + 1],
-                          currentBytecodes[bytecodeIndexGlobal + 2]);
-        bytecodeIndexGlobal += offset;
+LABEL_BC_JUMP2_BACKWARD:
+    ip = ip->jumpTarget;
+    COUNT_LOOP_ITERATION();
+    DISPATCH_NOGC();
+
+LABEL_BC_LOOP_START:
+    if (startCountedLoop(fp, ip[3].variable.index, load_ptr(sp[-2]),
+                         load_ptr(sp[-1]), load_ptr(*sp))) {
+        ip += 4;
     } else {
-        bytecodeIndexGlobal += 3;
+        ip = ip->jumpTarget;
     }
-    GetFrame()->PopVoid();
-}
+    sp -= 3;
     DISPATCH_NOGC();
 
-LABEL_BC_JUMP2_ON_NIL_POP: {
-    vm_oop_t val = GetFrame()->Top();
-    if (val == load_ptr(nilObject)) {
-        uint16_t const offset =
-            ComputeOffset(currentBytecodes[bytecodeIndexGlobal + 1],
-                          currentBytecodes[bytecodeIndexGlobal + 2]);
-        bytecodeIndexGlobal += offset;
+LABEL_BC_LOOP_NEXT:
+    if (continueCountedLoop(fp, ip[3].variable.index)) {
+        ip = ip->jumpTarget;
+        COUNT_LOOP_ITERATION();
     } else {
-        bytecodeIndexGlobal += 3;
+        ip += 4;
     }
-    GetFrame()->PopVoid();
-}
     DISPATCH_NOGC();
 
-LABEL_BC_JUMP2_ON_NOT_NIL_TOP_TOP: {
-    vm_oop_t val = GetFrame()->Top();
-    if (val != load_ptr(nilObject)) {
-        uint16_t const offset =
-            ComputeOffset(currentBytecodes[bytecodeIndexGlobal + 1],
-                          currentBytecodes[bytecodeIndexGlobal + 2]);
-        bytecodeIndexGlobal += offset;
-        // GetFrame()->SetTop(val);
-    } else {
-        GetFrame()->PopVoid();
-        bytecodeIndexGlobal += 3;
+LABEL_BC_LOOP_COUNTER:
+    PROLOGUE(2);
+    OP_LOOP_COUNTER();
+#if USE_TAGGING
+    DISPATCH_NOGC();
+#else
+    // only reading the loop variable boxes the counter
+    DISPATCH_GC();
+#endif
+
+LABEL_BC_SEND_PRIM_UNARY:
+    PROLOGUE(2);
+    OP_SEND_PRIM_UNARY();
+    DISPATCH_GC();
+
+LABEL_BC_SEND_PRIM_BINARY:
+    PROLOGUE(2);
+    OP_SEND_PRIM_BINARY();
+    DISPATCH_GC();
+
+LABEL_BC_SEND_GETTER:
+    PROLOGUE(2);
+    OP_SEND_GETTER();
+    DISPATCH_GC();
+
+LABEL_BC_SEND_SETTER:
+    PROLOGUE(2);
+    OP_SEND_SETTER();
+    DISPATCH_GC();
+
+LABEL_BC_SEND_METHOD:
+    PROLOGUE(2);
+    OP_SEND_METHOD();
+    DISPATCH_GC();
+
+    // generated from the bytecode sequence profile, see bytecodes.h
+    SUPERINSTRUCTION_HANDLERS
+
+#ifdef JIT
+LABEL_JIT_ENTER:
+    SPILL();
+    assert(method->GetJitEntries()[bytecodeIndexGlobal] != nullptr);
+    JitCompiler::Execute(method->GetJitEntries()[bytecodeIndexGlobal]);
+    RELOAD();
+    DISPATCH_GC();
+#endif
+}
+
+template vm_oop_t Interpreter::Start<true>();
+template vm_oop_t Interpreter::Start<false>();
+
+#ifdef JIT
+// Run the body of a bytecode on the interpreter state, the same way the
+// interpreter loop does. Compiled code calls it with its frame's stack pointer
+// spilled, see JitCompiler.
+  #define JIT_HELPER(bc)                                                \
+      case BC_##bc:                                                     \
+          return [](size_t bytecodeIndex) {                             \
+              VMFrame* const prevFrame = frame;                         \
+              size_t const next =                                       \
+                  bytecodeIndex + Bytecode::GetBytecodeLength(BC_##bc); \
+              VMFrame* fp = frame;                                      \
+              DecodedBytecode* ip = currentDecodedBytecodes + next;     \
+              gc_oop_t* sp = fp->stack_ptr;                             \
+              bytecodeIndexGlobal = next;                               \
+              OP_##bc();                                                \
+              SPILL();                                                  \
+              return continueCompiledCode(prevFrame, next);             \
+          }
+
+// Sends are quickened and deoptimized in place. The helper of a send expects
+// the kind of send the bytecode had when it was compiled, and otherwise
+// dispatches on the current one.
+  #define JIT_SEND_HELPER(bc, doSendBc)                                 \
+      case BC_##bc:                                                     \
+          return [](size_t bytecodeIndex) {                             \
+              VMFrame* const prevFrame = frame;                         \
+              size_t const next = bytecodeIndex + 2;                    \
+              bytecodeIndexGlobal = next;                               \
+              if (likely(currentBytecodes[bytecodeIndex] == BC_##bc)) { \
+                  doSendBc(bytecodeIndex);                              \
+              } else {                                                  \
+                  doAnySend(bytecodeIndex);                             \
+              }                                                         \
+              return continueCompiledCode(prevFrame, next);             \
+          }
+
+JitHelper Interpreter::getJitHelper(uint8_t bytecode) {
+    switch (bytecode) {
+        JIT_HELPER(PUSH_FIELD);
+        JIT_HELPER(PUSH_FIELD_0);
+        JIT_HELPER(PUSH_FIELD_1);
+        JIT_HELPER(PUSH_BLOCK);
+        JIT_HELPER(PUSH_0);
+        JIT_HELPER(PUSH_1);
+        JIT_HELPER(PUSH_GLOBAL);
+        JIT_HELPER(POP_FIELD);
+        JIT_HELPER(POP_FIELD_0);
+        JIT_HELPER(POP_FIELD_1);
+        JIT_HELPER(SUPER_SEND);
+        JIT_HELPER(ADD);
+        JIT_HELPER(SUB);
+        JIT_HELPER(MUL);
+        JIT_HELPER(LT);
+        JIT_HELPER(GT);
+        JIT_HELPER(LE);
+        JIT_HELPER(GE);
+        JIT_HELPER(EQ);
+        JIT_HELPER(EQ_EQ);
+        JIT_HELPER(RETURN_LOCAL);
+        JIT_HELPER(RETURN_NON_LOCAL);
+        JIT_HELPER(RETURN_SELF);
+        JIT_HELPER(RETURN_FIELD_0);
+        JIT_HELPER(RETURN_FIELD_1);
+        JIT_HELPER(RETURN_FIELD_2);
+        JIT_HELPER(INC);
+        JIT_HELPER(DEC);
+        JIT_HELPER(INC_FIELD);
+        JIT_HELPER(INC_FIELD_PUSH);
+        JIT_HELPER(LOOP_COUNTER);
+
+        JIT_SEND_HELPER(SEND, doSend);
+        JIT_SEND_HELPER(SEND_1, doUnarySend);
+        JIT_SEND_HELPER(SEND_2, doBinarySend);
+        JIT_SEND_HELPER(SEND_3, doTernarySend);
+        JIT_SEND_HELPER(SEND_N, doSend);
+        JIT_SEND_HELPER(SEND_PRIM_UNARY, doSendPrimUnary);
+        JIT_SEND_HELPER(SEND_PRIM_BINARY, doSendPrimBinary);
+        JIT_SEND_HELPER(SEND_GETTER, doSendGetter);
+        JIT_SEND_HELPER(SEND_SETTER, doSendSetter);
+        JIT_SEND_HELPER(SEND_METHOD, doSendMethod);
+
+        default:
+            return nullptr;
     }
 }
-    DISPATCH_NOGC();
 
-LABEL_BC_JUMP2_ON_NIL_TOP_TOP: {
-    vm_oop_t val = GetFrame()->Top();
-    if (val == load_ptr(nilObject)) {
-        uint16_t const offset =
-            ComputeOffset(currentBytecodes[bytecodeIndexGlobal + 1],
-                          currentBytecodes[bytecodeIndexGlobal + 2]);
-        bytecodeIndexGlobal += offset;
-        // GetFrame()->SetTop(val);
-    } else {
-        GetFrame()->PopVoid();
-        bytecodeIndexGlobal += 3;
+void Interpreter::doAnySend(size_t bytecodeIndex) {
+    switch (currentBytecodes[bytecodeIndex]) {
+        case BC_SEND_1:
+            doUnarySend(bytecodeIndex);
+            break;
+        case BC_SEND_2:
+            doBinarySend(bytecodeIndex);
+            break;
+        case BC_SEND_3:
+            doTernarySend(bytecodeIndex);
+            break;
+        case BC_SEND_PRIM_UNARY:
+            doSendPrimUnary(bytecodeIndex);
+            break;
+        case BC_SEND_PRIM_BINARY:
+            doSendPrimBinary(bytecodeIndex);
+            break;
+        case BC_SEND_GETTER:
+            doSendGetter(bytecodeIndex);
+            break;
+        case BC_SEND_SETTER:
+            doSendSetter(bytecodeIndex);
+            break;
+        case BC_SEND_METHOD:
+            doSendMethod(bytecodeIndex);
+            break;
+        default:
+            doSend(bytecodeIndex);
+            break;
     }
 }
-    DISPATCH_NOGC();
 
-LABEL_BC_JUMP2_IF_GREATER: {
-    if (checkIsGreater()) {
-        bytecodeIndexGlobal +=
-            ComputeOffset(currentBytecodes[bytecodeIndexGlobal + 1],
-                          currentBytecodes[bytecodeIndexGlobal + 2]);
-        GetFrame()->Pop();
-        GetFrame()->Pop();
-    } else {
-        bytecodeIndexGlobal += 3;
+void* Interpreter::continueCompiledCode(VMFrame* prevFrame,
+                                       size_t nextBytecodeIndex) {
+    bool const continuesInFrame =
+        frame == prevFrame && bytecodeIndexGlobal == nextBytecodeIndex;
+
+    if (GetHeap<HEAP_CLS>()->isCollectionTriggered()) {
+        startGC();
+    }
+
+    if (continuesInFrame) {
+        return nullptr;
     }
+
+    // continue directly in the compiled code of the new frame's method
+    void** entries = method->GetJitEntries();
+    if (entries != nullptr && entries[bytecodeIndexGlobal] != nullptr) {
+        return entries[bytecodeIndexGlobal];
+    }
+    return JitCompiler::GetExit();
 }
-    DISPATCH_NOGC();
 
-LABEL_BC_JUMP2_BACKWARD: {
-    uint16_t const offset =
-        ComputeOffset(currentBytecodes[bytecodeIndexGlobal + 1],
-                      currentBytecodes[bytecodeIndexGlobal + 2]);
-    bytecodeIndexGlobal -= offset;
+// The fast paths of the special send bytecodes, INC, and DEC, for compiled
+// code. They give up when a collection is due, so that the helper of the
+// bytecode reaches the GC safepoint.
+  #define JIT_FAST_PATH(bc, fastPath)                             \
+      case BC_##bc:                                               \
+          return [](vm_oop_t left, vm_oop_t right) -> vm_oop_t {  \
+              if (GetHeap<HEAP_CLS>()->isCollectionTriggered()) { \
+                  return nullptr;                                 \
+              }                                                   \
+              return (fastPath);                                  \
+          }
+
+JitFastPath Interpreter::getJitFastPath(uint8_t bytecode) {
+    switch (bytecode) {
+        JIT_FAST_PATH(ADD, tryArithmetic(left, right, addWithOverflow,
+                                         std::plus<>()));
+        JIT_FAST_PATH(SUB, tryArithmetic(left, right, subWithOverflow,
+                                         std::minus<>()));
+        JIT_FAST_PATH(MUL, tryArithmetic(left, right, mulWithOverflow,
+                                         std::multiplies<>()));
+        JIT_FAST_PATH(LT, tryComparison(left, right, std::less<>()));
+        JIT_FAST_PATH(GT, tryComparison(left, right, std::greater<>()));
+        JIT_FAST_PATH(LE, tryComparison(left, right, std::less_equal<>()));
+        JIT_FAST_PATH(GE, tryComparison(left, right, std::greater_equal<>()));
+        JIT_FAST_PATH(EQ, tryComparison(left, right, std::equal_to<>()));
+        JIT_FAST_PATH(EQ_EQ, tryEqualEqual(left, right));
+
+        // INC and DEC only use the left operand, the top of the stack
+        JIT_FAST_PATH(INC, IS_SMALL_INT(left) ? increment(left) : nullptr);
+        JIT_FAST_PATH(DEC, IS_SMALL_INT(left) ? decrement(left) : nullptr);
+
+        default:
+            return nullptr;
+    }
 }
-    DISPATCH_NOGC();
+
+bool Interpreter::jitIsGreater(vm_oop_t top, vm_oop_t top2) {
+    return checkIsGreater(top, top2);
 }
 
-template vm_oop_t Interpreter::Start<true>();
-template vm_oop_t Interpreter::Start<false>();
+bool Interpreter::jitLoopStart(VMFrame* fp, gc_oop_t* sp, uint8_t slot) {
+    return startCountedLoop(fp, slot, load_ptr(sp[-2]), load_ptr(sp[-1]),
+                            load_ptr(*sp));
+}
+
+bool Interpreter::jitLoopNext(VMFrame* fp, uint8_t slot) {
+    return continueCountedLoop(fp, slot);
+}
+#endif
 
 VMFrame* Interpreter::PushNewFrame(VMMethod* method) {
-    SetFrame(Universe::NewFrame(GetFrame(), method));
-    return GetFrame();
+#ifdef JIT
+    method->CountHotness();
+#endif
+    VMFrame* newFrame = FrameStack::NewFrame(GetFrame(), method);
+    if (unlikely(newFrame == nullptr)) {
+        newFrame = Universe::NewFrame(GetFrame(), method);
+    }
+    SetFrame(newFrame);
+    return newFrame;
 }
 
 void Interpreter::SetFrame(VMFrame* frm) {
@@ -700,6 +1270,11 @@ void Interpreter::SetFrame(VMFrame* frm) {
     method = frm->GetMethod();
     bytecodeIndexGlobal = frm->GetBytecodeIndex();
     currentBytecodes = method->GetBytecodes();
+
+    // the bytecodes are decoded once the interpreter loop runs, see Start()
+    if (dispatchTable != nullptr) {
+        currentDecodedBytecodes = method->GetDecodedBytecodes(dispatchTable);
+    }
 }
 
 vm_oop_t Interpreter::GetSelf() {
@@ -710,14 +1285,33 @@ vm_oop_t Interpreter::GetSelf() {
 VMFrame* Interpreter::popFrame() {
     VMFrame* result = GetFrame();
     SetFrame(GetFrame()->GetPreviousFrame());
+    releaseFrame(result);
+    return result;
+}
 
-    result->ClearPreviousFrame();
+void Interpreter::releaseFrame(VMFrame* frm) {
+    // a frame without previous frame has returned, see doReturnNonLocal()
+    frm->ClearPreviousFrame();
 
-#ifdef UNSAFE_FRAME_OPTIMIZATION
-    // remember this frame as free frame
-    result->GetMethod()->SetCachedFrame(result);
-#endif
-    return result;
+    // the frame stays intact until the next frame is allocated
+    if (FrameStack::Contains(frm)) {
+        FrameStack::Release(frm);
+    } else if (!frm->IsCaptured()) {
+        FramePool::Free(frm);
+    }
+}
+
+void Interpreter::unwindTo(VMFrame* target) {
+    VMFrame* current = GetFrame();
+    while (current != target) {
+        VMFrame* previous = current->GetPreviousFrame();
+        releaseFrame(current);
+        current = previous;
+    }
+
+    // the released frames do not need their bytecode index any longer
+    frame = nullptr;
+    SetFrame(target);
 }
 
 void Interpreter::popFrameAndPushResult(vm_oop_t result) {
@@ -733,8 +1327,94 @@ void Interpreter::popFrameAndPushResult(vm_oop_t result) {
     GetFrame()->Push(result);
 }
 
-void Interpreter::send(VMSymbol* signature, VMClass* receiverClass) {
-    VMInvokable* invokable = receiverClass->LookupInvokable(signature);
+VMInvokable* Interpreter::lookupWithInlineCache(VMSymbol* signature,
+                                                VMClass* receiverClass,
+                                                size_t bytecodeIndex) {
+    InlineCache* cache = method->GetInlineCache(bytecodeIndex);
+
+    VMInvokable* invokable = cache->Lookup(receiverClass);
+    if (likely(invokable != nullptr)) {
+        return invokable;
+    }
+
+    if (cache->IsMegamorphic()) {
+        return receiverClass->LookupInvokable(signature);
+    }
+
+    invokable = cache->LookupAndCache(receiverClass, signature, method);
+    if (invokable != nullptr && cache->IsMonomorphic()) {
+        quickenSend(bytecodeIndex, signature, invokable);
+    }
+    return invokable;
+}
+
+void Interpreter::rewriteBytecode(size_t bytecodeIndex, uint8_t bytecode) {
+    method->SetBytecode(bytecodeIndex, bytecode);
+    method->DecodeBytecode(bytecodeIndex, dispatchTable);
+}
+
+void Interpreter::quickenSend(size_t bytecodeIndex, VMSymbol* signature,
+                              VMInvokable* invokable) {
+    uint8_t const numOfArgs = Signature::GetNumberOfArguments(signature);
+    if (method->GetBytecode(bytecodeIndex) !=
+        SendBytecodeForArguments(numOfArgs)) {
+        // super sends are not quickened
+        return;
+    }
+
+    uint8_t quickened = BC_INVALID;
+
+    if (dynamic_cast<VMMethod*>(invokable) != nullptr) {
+        quickened = BC_SEND_METHOD;
+    } else if (numOfArgs == 1) {
+        if (dynamic_cast<VMGetter*>(invokable) != nullptr) {
+            quickened = BC_SEND_GETTER;
+        } else if (dynamic_cast<VMSafeUnaryPrimitive*>(invokable) != nullptr) {
+            quickened = BC_SEND_PRIM_UNARY;
+        }
+    } else if (numOfArgs == 2) {
+        auto* setter = dynamic_cast<VMSetter*>(invokable);
+        if (setter != nullptr && setter->GetArgIndex() == 1) {
+            quickened = BC_SEND_SETTER;
+        } else if (dynamic_cast<VMSafeBinaryPrimitive*>(invokable) !=
+                   nullptr) {
+            quickened = BC_SEND_PRIM_BINARY;
+        }
+    }
+
+    if (quickened != BC_INVALID) {
+        rewriteBytecode(bytecodeIndex, quickened);
+    }
+}
+
+void Interpreter::deoptimizeSend(size_t bytecodeIndex) {
+    auto* signature =
+        static_cast<VMSymbol*>(method->GetConstant(bytecodeIndex));
+
+    uint8_t const bc =
+        SendBytecodeForArguments(Signature::GetNumberOfArguments(signature));
+    rewriteBytecode(bytecodeIndex, bc);
+
+    switch (bc) {
+        case BC_SEND_1:
+            doUnarySend(bytecodeIndex);
+            break;
+        case BC_SEND_2:
+            doBinarySend(bytecodeIndex);
+            break;
+        case BC_SEND_3:
+            doTernarySend(bytecodeIndex);
+            break;
+        default:
+            doSend(bytecodeIndex);
+            break;
+    }
+}
+
+void Interpreter::send(VMSymbol* signature, VMClass* receiverClass,
+                       size_t bytecodeIndex) {
+    VMInvokable* invokable =
+        lookupWithInlineCache(signature, receiverClass, bytecodeIndex);
 
     if (invokable != nullptr) {
 #ifdef LOG_RECEIVER_TYPES
@@ -755,6 +1435,11 @@ void Interpreter::send(VMSymbol* signature, VMClass* receiverClass) {
 }
 
 void Interpreter::triggerDoesNotUnderstand(VMSymbol* signature) {
+    // the arguments end up in an array, and may thus escape
+    if (FrameStack::HasBlocksAbove(GetFrame())) {
+        moveFrameToHeap(0);
+    }
+
     uint8_t const numberOfArgs = Signature::GetNumberOfArguments(signature);
 
     vm_oop_t receiver = GetFrame()->GetStackElement(numberOfArgs - 1);
@@ -778,107 +1463,82 @@ void Interpreter::triggerDoesNotUnderstand(VMSymbol* signature) {
     int64_t const additionalStackSlots =
         3 - (int64_t)GetFrame()->RemainingStackSize();
     if (additionalStackSlots > 0) {
-        GetFrame()->SetBytecodeIndex(bytecodeIndexGlobal);
         // copy current frame into a bigger one and replace the current frame
-        SetFrame(VMFrame::EmergencyFrameFrom(GetFrame(), additionalStackSlots));
+        moveFrameToHeap(additionalStackSlots);
     }
 
     AS_OBJ(receiver)->Send(doesNotUnderstand, arguments, 2);
 }
 
-void Interpreter::doDup() {
-    vm_oop_t elem = GetFrame()->GetStackElement(0);
-    GetFrame()->Push(elem);
-}
-
-void Interpreter::doPushLocal(size_t bytecodeIndex) {
-    uint8_t const bc1 = method->GetBytecode(bytecodeIndex + 1);
-    uint8_t const bc2 = method->GetBytecode(bytecodeIndex + 2);
-
-    assert((bc1 != 0 || bc2 != 0) && "should have been BC_PUSH_LOCAL_0");
-    assert((bc1 != 1 || bc2 != 0) && "should have been BC_PUSH_LOCAL_1");
-    assert((bc1 != 2 || bc2 != 0) && "should have been BC_PUSH_LOCAL_2");
-
-    vm_oop_t local = GetFrame()->GetLocal(bc1, bc2);
-
-    GetFrame()->Push(local);
-}
-
-void Interpreter::doPushLocalWithIndex(uint8_t localIndex) {
-    vm_oop_t local = GetFrame()->GetLocalInCurrentContext(localIndex);
-    GetFrame()->Push(local);
-}
-
-void Interpreter::doPushArgument(size_t bytecodeIndex) {
-    uint8_t const argIndex = method->GetBytecode(bytecodeIndex + 1);
-    uint8_t const contextLevel = method->GetBytecode(bytecodeIndex + 2);
-
-    assert((argIndex != 0 || contextLevel != 0) &&
-           "should have been BC_PUSH_SELF");
-    assert((argIndex != 1 || contextLevel != 0) &&
-           "should have been BC_PUSH_ARG_1");
-    assert((argIndex != 2 || contextLevel != 0) &&
-           "should have been BC_PUSH_ARG_2");
-
-    vm_oop_t argument = GetFrame()->GetArgument(argIndex, contextLevel);
+bool Interpreter::isNonEscaping(VMInvokable* blockMethod) {
+    uint8_t const receivers = blockMethod->GetNonEscapingReceivers();
+    if (receivers == 0) {
+        return false;
+    }
 
-    GetFrame()->Push(argument);
+    // the receiver of the send is below the block arguments pushed so far
+    vm_oop_t receiver =
+        GetFrame()->GetStackElement(blockMethod->GetArgumentIndexInSend());
+    VMClass* cls = CLASS_OF(receiver);
+    return (cls == load_ptr(arrayClass) && (receivers & RECEIVER_ARRAY) != 0) ||
+           (cls == load_ptr(vectorClass) &&
+            (receivers & RECEIVER_VECTOR) != 0) ||
+           (cls == load_ptr(integerClass) &&
+            (receivers & RECEIVER_INTEGER) != 0);
 }
 
-void Interpreter::doPushField(size_t bytecodeIndex) {
-    uint8_t const fieldIndex = method->GetBytecode(bytecodeIndex + 1);
-    assert(fieldIndex != 0 && fieldIndex != 1 &&
-           "should have been BC_PUSH_FIELD_0|1");
+void Interpreter::doPushBlock(size_t bytecodeIndex) {
+    vm_oop_t block = method->GetConstant(bytecodeIndex);
+    auto* blockMethod = static_cast<VMInvokable*>(block);
 
-    doPushFieldWithIndex(fieldIndex);
-}
+    uint8_t const numOfArgs = blockMethod->GetNumberOfArguments();
 
-void Interpreter::doPushFieldWithIndex(uint8_t fieldIndex) {
-    vm_oop_t self = GetSelf();
-    vm_oop_t o = nullptr;
+    VMFrame* current = GetFrame();
+    if (FrameStack::Contains(current)) {
+        if (isNonEscaping(blockMethod)) {
+            // the blocks of earlier sends are dead by now
+            if (blockMethod->GetArgumentIndexInSend() == 0) {
+                FrameStack::ReleaseAbove(current);
+            }
+            VMBlock* result =
+                FrameStack::NewBlock(blockMethod, current, numOfArgs);
+            if (likely(result != nullptr)) {
+                current->Push(result);
+                return;
+            }
+        }
 
-    if (unlikely(IS_TAGGED(self))) {
-        o = nullptr;
-        ErrorExit("Integers do not have fields!");
-    } else {
-        o = ((VMObject*)self)->GetField(fieldIndex);
+        // the block may outlive the frame, which is its context
+        moveFrameToHeap(0);
     }
 
-    GetFrame()->Push(o);
+    // the frame must not be recycled while the block refers to it
+    GetFrame()->MarkAsCaptured();
+    GetFrame()->Push(Universe::NewBlock(blockMethod, GetFrame(), numOfArgs));
 }
 
-void Interpreter::doReturnFieldWithIndex(uint8_t fieldIndex) {
-    vm_oop_t self = GetSelf();
-    vm_oop_t o = nullptr;
+void Interpreter::moveFrameToHeap(size_t additionalStackSlots) {
+    VMFrame* current = GetFrame();
+    current->SetBytecodeIndex(bytecodeIndexGlobal);
+    VMFrame* copy = VMFrame::EmergencyFrameFrom(current, additionalStackSlots);
+    SetFrame(copy);
 
-    if (unlikely(IS_TAGGED(self))) {
-        o = nullptr;
-        ErrorExit("Integers do not have fields!");
-    } else {
-        o = ((VMObject*)self)->GetField(fieldIndex);
+    // the frame's blocks on the frame stack are freed with it
+    if (FrameStack::HasBlocksAbove(current)) {
+        copy->CopyBlocksToHeap(current);
     }
-
-    popFrameAndPushResult(o);
-}
-
-void Interpreter::doPushBlock(size_t bytecodeIndex) {
-    vm_oop_t block = method->GetConstant(bytecodeIndex);
-    auto* blockMethod = static_cast<VMInvokable*>(block);
-
-    uint8_t const numOfArgs = blockMethod->GetNumberOfArguments();
-
-    GetFrame()->Push(Universe::NewBlock(blockMethod, GetFrame(), numOfArgs));
+    FrameStack::Release(current);
 }
 
 void Interpreter::doPushGlobal(size_t bytecodeIndex) {
-    auto* globalName =
-        static_cast<VMSymbol*>(method->GetConstant(bytecodeIndex));
-    vm_oop_t global = Universe::GetGlobal(globalName);
+    auto* association =
+        static_cast<VMAssociation*>(method->GetConstant(bytecodeIndex));
+    vm_oop_t global = association->GetValue();
 
     if (global != nullptr) {
         GetFrame()->Push(global);
     } else {
-        SendUnknownGlobal(globalName);
+        SendUnknownGlobal(association->GetKey());
     }
 }
 
@@ -891,55 +1551,46 @@ void Interpreter::SendUnknownGlobal(VMSymbol* globalName) {
     int64_t const additionalStackSlots =
         2 - (int64_t)GetFrame()->RemainingStackSize();
     if (additionalStackSlots > 0) {
-        GetFrame()->SetBytecodeIndex(bytecodeIndexGlobal);
         // copy current frame into a bigger one and replace the current
         // frame
-        SetFrame(VMFrame::EmergencyFrameFrom(GetFrame(), additionalStackSlots));
+        moveFrameToHeap(additionalStackSlots);
     }
 
     AS_OBJ(self)->Send(unknownGlobal, arguments, 1);
 }
 
-void Interpreter::doPop() {
-    GetFrame()->Pop();
-}
-
-void Interpreter::doPopLocal(size_t bytecodeIndex) {
-    uint8_t const bc1 = method->GetBytecode(bytecodeIndex + 1);
-    uint8_t const bc2 = method->GetBytecode(bytecodeIndex + 2);
-
-    vm_oop_t o = GetFrame()->Pop();
+vm_oop_t Interpreter::loadSelfField(uint8_t fieldIndex) {
+    vm_oop_t self = GetSelf();
 
-    GetFrame()->SetLocal(bc1, bc2, o);
-}
+    if (unlikely(IS_TAGGED(self))) {
+        ErrorExit("Integers do not have fields!");
+    }
 
-void Interpreter::doPopLocalWithIndex(uint8_t localIndex) {
-    vm_oop_t o = GetFrame()->Pop();
-    GetFrame()->SetLocal(localIndex, o);
+    return ((VMObject*)self)->GetField(fieldIndex);
 }
 
-void Interpreter::doPopArgument(size_t bytecodeIndex) {
-    uint8_t const bc1 = method->GetBytecode(bytecodeIndex + 1);
-    uint8_t const bc2 = method->GetBytecode(bytecodeIndex + 2);
+void Interpreter::storeSelfField(uint8_t fieldIndex, vm_oop_t value) {
+    vm_oop_t self = GetSelf();
 
-    vm_oop_t o = GetFrame()->Pop();
-    GetFrame()->SetArgument(bc1, bc2, o);
-}
+    if (unlikely(IS_TAGGED(self))) {
+        ErrorExit("Integers do not have fields that can be set");
+    }
 
-void Interpreter::doPopField(size_t bytecodeIndex) {
-    uint8_t const fieldIndex = method->GetBytecode(bytecodeIndex + 1);
-    doPopFieldWithIndex(fieldIndex);
+    ((VMObject*)self)->SetField(fieldIndex, value);
 }
 
-void Interpreter::doPopFieldWithIndex(uint8_t fieldIndex) {
+vm_oop_t Interpreter::incrementField(uint8_t fieldIndex) {
     vm_oop_t self = GetSelf();
-    vm_oop_t o = GetFrame()->Pop();
 
     if (unlikely(IS_TAGGED(self))) {
-        ErrorExit("Integers do not have fields that can be set");
-    } else {
-        ((VMObject*)self)->SetField(fieldIndex, o);
+        ErrorExit("Integers do not have fields!");
     }
+
+    auto* selfObj = (VMObject*)self;
+
+    vm_oop_t val = increment(selfObj->GetField(fieldIndex));
+    selfObj->SetField(fieldIndex, val);
+    return val;
 }
 
 void Interpreter::doSend(size_t bytecodeIndex) {
@@ -962,7 +1613,7 @@ void Interpreter::doSend(size_t bytecodeIndex) {
     Universe::receiverTypes[receiverClass->GetName()->GetStdString()]++;
 #endif
 
-    send(signature, receiverClass);
+    send(signature, receiverClass, bytecodeIndex);
 }
 
 void Interpreter::doUnarySend(size_t bytecodeIndex) {
@@ -985,7 +1636,8 @@ void Interpreter::doUnarySend(size_t bytecodeIndex) {
     Universe::receiverTypes[receiverClass->GetName()->GetStdString()]++;
 #endif
 
-    VMInvokable* invokable = receiverClass->LookupInvokable(signature);
+    VMInvokable* invokable =
+        lookupWithInlineCache(signature, receiverClass, bytecodeIndex);
 
     if (invokable != nullptr) {
 #ifdef LOG_RECEIVER_TYPES
@@ -1004,16 +1656,91 @@ void Interpreter::doUnarySend(size_t bytecodeIndex) {
     }
 }
 
+void Interpreter::doBinarySend(size_t bytecodeIndex) {
+    auto* signature =
+        static_cast<VMSymbol*>(method->GetConstant(bytecodeIndex));
+
+    const int numOfArgs = 2;
+
+    vm_oop_t receiver = frame->GetStackElement(numOfArgs - 1);
+
+    assert(IsValidObject(receiver));
+    // make sure it is really a class
+    assert(dynamic_cast<VMClass*>(CLASS_OF(receiver)) != nullptr);
+
+    VMClass* receiverClass = CLASS_OF(receiver);
+
+    assert(IsValidObject(receiverClass));
+
+#ifdef LOG_RECEIVER_TYPES
+    Universe::receiverTypes[receiverClass->GetName()->GetStdString()]++;
+#endif
+
+    VMInvokable* invokable =
+        lookupWithInlineCache(signature, receiverClass, bytecodeIndex);
+
+    if (invokable != nullptr) {
+#ifdef LOG_RECEIVER_TYPES
+        std::string name = receiverClass->GetName()->GetStdString();
+        if (Universe::callStats.find(name) == Universe::callStats.end()) {
+            Universe::callStats[name] = {0, 0};
+        }
+        Universe::callStats[name].noCalls++;
+        if (invokable->IsPrimitive()) {
+            Universe::callStats[name].noPrimitiveCalls++;
+        }
+#endif
+        invokable->Invoke2(GetFrame());
+    } else {
+        triggerDoesNotUnderstand(signature);
+    }
+}
+
+void Interpreter::doTernarySend(size_t bytecodeIndex) {
+    auto* signature =
+        static_cast<VMSymbol*>(method->GetConstant(bytecodeIndex));
+
+    const int numOfArgs = 3;
+
+    vm_oop_t receiver = frame->GetStackElement(numOfArgs - 1);
+
+    assert(IsValidObject(receiver));
+    // make sure it is really a class
+    assert(dynamic_cast<VMClass*>(CLASS_OF(receiver)) != nullptr);
+
+    VMClass* receiverClass = CLASS_OF(receiver);
+
+    assert(IsValidObject(receiverClass));
+
+#ifdef LOG_RECEIVER_TYPES
+    Universe::receiverTypes[receiverClass->GetName()->GetStdString()]++;
+#endif
+
+    VMInvokable* invokable =
+        lookupWithInlineCache(signature, receiverClass, bytecodeIndex);
+
+    if (invokable != nullptr) {
+#ifdef LOG_RECEIVER_TYPES
+        std::string name = receiverClass->GetName()->GetStdString();
+        if (Universe::callStats.find(name) == Universe::callStats.end()) {
+            Universe::callStats[name] = {0, 0};
+        }
+        Universe::callStats[name].noCalls++;
+        if (invokable->IsPrimitive()) {
+            Universe::callStats[name].noPrimitiveCalls++;
+        }
+#endif
+        invokable->Invoke3(GetFrame());
+    } else {
+        triggerDoesNotUnderstand(signature);
+    }
+}
+
 void Interpreter::doSuperSend(size_t bytecodeIndex) {
     auto* signature =
         static_cast<VMSymbol*>(method->GetConstant(bytecodeIndex));
 
-    VMFrame const* const ctxt = GetFrame()->GetOuterContext();
-    VMMethod const* const realMethod = ctxt->GetMethod();
-    VMClass const* const holder = realMethod->GetHolder();
-    assert(holder->HasSuperClass());
-    auto* super = (VMClass*)holder->GetSuperClass();
-    auto* invokable = super->LookupInvokable(signature);
+    VMInvokable* invokable = method->GetSuperSendTarget(bytecodeIndex);
 
     if (invokable != nullptr) {
         invokable->Invoke(GetFrame());
@@ -1032,6 +1759,94 @@ void Interpreter::doSuperSend(size_t bytecodeIndex) {
     }
 }
 
+void Interpreter::doSendPrimUnary(size_t bytecodeIndex) {
+    vm_oop_t receiver = GetFrame()->Top();
+
+    auto* prim = static_cast<VMSafeUnaryPrimitive*>(
+        method->GetInlineCache(bytecodeIndex)->Lookup(CLASS_OF(receiver)));
+    if (unlikely(prim == nullptr)) {
+        deoptimizeSend(bytecodeIndex);
+        return;
+    }
+
+    GetFrame()->SetTop(prim->Call(receiver));
+}
+
+void Interpreter::doSendPrimBinary(size_t bytecodeIndex) {
+    vm_oop_t receiver = GetFrame()->GetStackElement(1);
+
+    auto* prim = static_cast<VMSafeBinaryPrimitive*>(
+        method->GetInlineCache(bytecodeIndex)->Lookup(CLASS_OF(receiver)));
+    if (unlikely(prim == nullptr)) {
+        deoptimizeSend(bytecodeIndex);
+        return;
+    }
+
+    vm_oop_t arg = GetFrame()->Pop();
+    GetFrame()->SetTop(prim->Call(receiver, arg));
+}
+
+void Interpreter::doSendGetter(size_t bytecodeIndex) {
+    vm_oop_t receiver = GetFrame()->Top();
+
+    auto* getter = static_cast<VMGetter*>(
+        method->GetInlineCache(bytecodeIndex)->Lookup(CLASS_OF(receiver)));
+    if (unlikely(getter == nullptr)) {
+        deoptimizeSend(bytecodeIndex);
+        return;
+    }
+
+    // the class guard makes sure we have seen an object with fields before
+    assert(!IS_TAGGED(receiver));
+    vm_oop_t value = ((VMObject*)receiver)->GetField(getter->GetFieldIndex());
+    GetFrame()->SetTop(value);
+}
+
+void Interpreter::doSendSetter(size_t bytecodeIndex) {
+    vm_oop_t receiver = GetFrame()->GetStackElement(1);
+
+    auto* setter = static_cast<VMSetter*>(
+        method->GetInlineCache(bytecodeIndex)->Lookup(CLASS_OF(receiver)));
+    if (unlikely(setter == nullptr)) {
+        deoptimizeSend(bytecodeIndex);
+        return;
+    }
+
+    // the setter returns self, which stays on the stack
+    assert(!IS_TAGGED(receiver));
+    vm_oop_t value = GetFrame()->Pop();
+    ((VMObject*)receiver)->SetField(setter->GetFieldIndex(), value);
+}
+
+void Interpreter::doSendMethod(size_t bytecodeIndex) {
+    auto* signature =
+        static_cast<VMSymbol*>(method->GetConstant(bytecodeIndex));
+    uint8_t const numOfArgs = Signature::GetNumberOfArguments(signature);
+    vm_oop_t receiver = GetFrame()->GetStackElement(numOfArgs - 1);
+
+    auto* invokable = static_cast<VMMethod*>(
+        method->GetInlineCache(bytecodeIndex)->Lookup(CLASS_OF(receiver)));
+    if (unlikely(invokable == nullptr)) {
+        deoptimizeSend(bytecodeIndex);
+        return;
+    }
+
+    switch (numOfArgs) {
+        case 1:
+            invokable->Invoke1(GetFrame());
+            break;
+        case 2:
+            invokable->Invoke2(GetFrame());
+            break;
+        case 3:
+            invokable->Invoke3(GetFrame());
+            break;
+        default:
+            invokable->Invoke(GetFrame());
+            break;
+    }
+}
+
 void Interpreter::doReturnLocal() {
     vm_oop_t result = GetFrame()->Pop();
     popFrameAndPushResult(result);
@@ -1042,6 +1857,8 @@ void Interpreter::doReturnNonLocal() {
 
     VMFrame const* const context = GetFrame()->GetOuterContext();
 
+    // the home context is still active as long as it has a previous frame,
+    // because returning clears it, see releaseFrame()
     if (!context->HasPreviousFrame()) {
         auto* block =
             static_cast<VMBlock*>(GetFrame()->GetArgumentInCurrentContext(0));
@@ -1064,125 +1881,39 @@ void Interpreter::doReturnNonLocal() {
         int64_t const additionalStackSlots =
             2 - (int64_t)GetFrame()->RemainingStackSize();
         if (additionalStackSlots > 0) {
-            GetFrame()->SetBytecodeIndex(bytecodeIndexGlobal);
             // copy current frame into a bigger one, and replace it
-            SetFrame(
-                VMFrame::EmergencyFrameFrom(GetFrame(), additionalStackSlots));
+            moveFrameToHeap(additionalStackSlots);
         }
 
         AS_OBJ(sender)->Send(escapedBlock, arguments, 1);
         return;
     }
 
-    while (GetFrame() != context) {
-        popFrame();
-    }
+    // release the frames up to and including the home context at once,
+    // without making each of them the current frame
+    uint8_t const numberOfArgs = context->GetMethod()->GetNumberOfArguments();
+    unwindTo(context->GetPreviousFrame());
 
-    popFrameAndPushResult(result);
-}
-
-void Interpreter::doInc() {
-    vm_oop_t val = GetFrame()->Top();
-
-    if (IS_SMALL_INT(val)) {
-        int64_t const result = SMALL_INT_VAL(val) + 1;
-        val = NEW_INT(result);
-    } else if (CLASS_OF(val) == load_ptr(doubleClass)) {
-        double const d = static_cast<VMDouble*>(val)->GetEmbeddedDouble();
-        val = Universe::NewDouble(d + 1.0);
-    } else {
-        ErrorExit("unsupported");
-    }
-
-    GetFrame()->SetTop(store_root(val));
-}
-
-void Interpreter::doDec() {
-    vm_oop_t val = GetFrame()->Top();
-
-    if (IS_SMALL_INT(val)) {
-        int64_t const result = SMALL_INT_VAL(val) - 1;
-        val = NEW_INT(result);
-    } else if (CLASS_OF(val) == load_ptr(doubleClass)) {
-        double const d = static_cast<VMDouble*>(val)->GetEmbeddedDouble();
-        val = Universe::NewDouble(d - 1.0);
-    } else {
-        ErrorExit("unsupported");
-    }
-
-    GetFrame()->SetTop(store_root(val));
-}
-
-void Interpreter::doIncField(uint8_t fieldIndex) {
-    vm_oop_t self = GetSelf();
-
-    if (unlikely(IS_TAGGED(self))) {
-        ErrorExit("Integers do not have fields!");
-    }
-
-    auto* selfObj = (VMObject*)self;
-
-    vm_oop_t val = selfObj->GetField(fieldIndex);
-
-    if (IS_SMALL_INT(val)) {
-        int64_t const result = SMALL_INT_VAL(val) + 1;
-        val = NEW_INT(result);
-    } else if (CLASS_OF(val) == load_ptr(doubleClass)) {
-        double const d = static_cast<VMDouble*>(val)->GetEmbeddedDouble();
-        val = Universe::NewDouble(d + 1.0);
-    } else {
-        ErrorExit("unsupported");
-    }
-
-    selfObj->SetField(fieldIndex, val);
-}
-
-void Interpreter::doIncFieldPush(uint8_t fieldIndex) {
-    vm_oop_t self = GetSelf();
-
-    if (unlikely(IS_TAGGED(self))) {
-        ErrorExit("Integers do not have fields!");
-    }
-
-    auto* selfObj = (VMObject*)self;
-
-    vm_oop_t val = selfObj->GetField(fieldIndex);
-
-    if (IS_SMALL_INT(val)) {
-        int64_t const result = SMALL_INT_VAL(val) + 1;
-        val = NEW_INT(result);
-    } else if (CLASS_OF(val) == load_ptr(doubleClass)) {
-        double const d = static_cast<VMDouble*>(val)->GetEmbeddedDouble();
-        val = Universe::NewDouble(d + 1.0);
-    } else {
-        ErrorExit("unsupported");
-    }
-
-    selfObj->SetField(fieldIndex, val);
-    GetFrame()->Push(val);
-}
-
-bool Interpreter::checkIsGreater() {
-    vm_oop_t top = GetFrame()->Top();
-    vm_oop_t top2 = GetFrame()->Top2();
-
-    if (IS_SMALL_INT(top) && IS_SMALL_INT(top2)) {
-        return SMALL_INT_VAL(top) > SMALL_INT_VAL(top2);
-    }
-    if (IS_DOUBLE(top) && IS_DOUBLE(top2)) {
-        return AS_DOUBLE(top) > AS_DOUBLE(top2);
+    for (uint8_t i = 0; i < numberOfArgs; ++i) {
+        GetFrame()->Pop();
     }
-
-    return false;
+    GetFrame()->Push(result);
 }
 
 void Interpreter::WalkGlobals(walk_heap_fn walk) {
+    // the pooled frames are garbage, and are not kept alive by the GC
+    FramePool::Clear();
+
     method = load_ptr(static_cast<GCMethod*>(walk(tmp_ptr(method))));
 
     // Get the current frame and mark it.
     // Since marking is done recursively, this automatically
-    // marks the whole stack
-    frame = load_ptr(static_cast<GCFrame*>(walk(tmp_ptr(frame))));
+    // marks the whole stack, apart from the frames on the frame stack, which
+    // are roots themselves
+    if (!FrameStack::Contains(frame)) {
+        frame = load_ptr(static_cast<GCFrame*>(walk(tmp_ptr(frame))));
+    }
+    FrameStack::WalkFrames(walk);
 }
 
 void Interpreter::startGC() {
@@ -1190,6 +1921,7 @@ void Interpreter::startGC() {
     GetHeap<HEAP_CLS>()->FullGC();
     method = GetFrame()->GetMethod();
     currentBytecodes = method->GetBytecodes();
+    currentDecodedBytecodes = method->GetDecodedBytecodes(dispatchTable);
 }
 
 VMMethod* Interpreter::GetMethod() {
@@ -33,19 +33,107 @@
 #include "../vmobjects/VMFrame.h"
 #include "../vmobjects/VMMethod.h"
 
-#define DISPATCH_NOGC()                                           \
-    {                                                             \
-        goto* loopTargets[currentBytecodes[bytecodeIndexGlobal]]; \
+// The interpreter loop keeps the instruction pointer (ip), the stack pointer
+// (sp), and the frame (fp) in locals. SPILL() writes them back to
+// bytecodeIndexGlobal and the frame, and RELOAD() reads them from the
+// interpreter state again, which may have changed, e.g., when a new frame was
+// pushed or the GC moved objects. The instruction pointer points into the
+// method's decoded bytecodes, see VMMethod::GetDecodedBytecodes().
+#define SPILL()                                             \
+    {                                                       \
+        bytecodeIndexGlobal = ip - currentDecodedBytecodes; \
+        fp->stack_ptr = sp;                                 \
     }
 
-#define DISPATCH_GC()                                             \
-    {                                                             \
-        if (GetHeap<HEAP_CLS>()->isCollectionTriggered()) {       \
-            startGC();                                            \
-        }                                                         \
-        goto* loopTargets[currentBytecodes[bytecodeIndexGlobal]]; \
+#define RELOAD()                                            \
+    {                                                       \
+        fp = frame;                                         \
+        ip = currentDecodedBytecodes + bytecodeIndexGlobal; \
+        sp = fp->stack_ptr;                                 \
     }
 
+#define CALL(expr) \
+    {              \
+        SPILL();   \
+        expr;      \
+        RELOAD();  \
+    }
+
+#define PUSH(value)                                                      \
+    {                                                                    \
+        vm_oop_t pushed = (value);                                       \
+        assert((void*)(sp + 1) < SHIFTED_PTR(fp, fp->totalObjectSize)); \
+        *++sp = store_with_separate_barrier(pushed);                     \
+        write_barrier_at(fp, sp, pushed);                                \
+    }
+
+// the frame may be an old one from the FramePool, and thus needs the write
+// barrier also for new objects
+#define SET_TOP(value)                                  \
+    {                                                   \
+        vm_oop_t top = (value);                         \
+        *sp = store_with_separate_barrier(top);         \
+        write_barrier_at(fp, sp, top);                  \
+    }
+
+// replace receiver and argument by the result of the fast path, or fall back
+// to a normal send
+#define BINARY_FAST_PATH(fastPath)                       \
+    {                                                    \
+        vm_oop_t result = (fastPath);                    \
+        if (likely(result != nullptr)) {                 \
+            sp -= 1;                                     \
+            SET_TOP(result);                             \
+        } else {                                         \
+            CALL(doBinarySend(bytecodeIndexGlobal - 2)); \
+        }                                                \
+    }
+
+#define DISPATCH_NOGC()    \
+    {                      \
+        goto* ip->handler; \
+    }
+
+#ifdef JIT
+  // continue in compiled code, if the current method has some, see
+  // JitCompiler. The compiled code is not used when tracing bytecodes.
+  #define ENTER_COMPILED_CODE()                         \
+      {                                                 \
+          if constexpr (!PrintBytecodes) {              \
+              if (method->GetJitEntries() != nullptr) { \
+                  goto LABEL_JIT_ENTER;                 \
+              }                                         \
+          }                                             \
+      }
+  #define COUNT_LOOP_ITERATION()  \
+      {                           \
+          method->CountHotness(); \
+          ENTER_COMPILED_CODE();  \
+      }
+#else
+  #define ENTER_COMPILED_CODE()
+  #define COUNT_LOOP_ITERATION()
+#endif
+
+#define DISPATCH_GC()                                       \
+    {                                                       \
+        if (GetHeap<HEAP_CLS>()->isCollectionTriggered()) { \
+            CALL(startGC());                                \
+        }                                                   \
+        ENTER_COMPILED_CODE();                              \
+        goto* ip->handler;                                  \
+    }
+
+#ifdef JIT
+// runs the bytecode at the given index for compiled code, and returns where
+// compiled code continues, or nullptr for the next bytecode
+typedef void* (*JitHelper)(size_t bytecodeIndex);
+
+// the fast path of a bytecode, which returns its result, or nullptr if the
+// helper needs to run the bytecode
+typedef vm_oop_t (*JitFastPath)(vm_oop_t left, vm_oop_t right);
+#endif
+
 class Interpreter {
 public:
     template <bool PrintBytecodes>
@@ -80,6 +168,11 @@ private:
     // current execution context
     static size_t bytecodeIndexGlobal;
     static uint8_t* currentBytecodes;
+    static DecodedBytecode* currentDecodedBytecodes;
+
+    // the handlers of the interpreter loop, indexed by bytecode, which the
+    // decoded bytecodes refer to. They are known once the loop first ran.
+    static void const* const* dispatchTable;
 
     static const std::string unknownGlobal;
     static const std::string doesNotUnderstand;
@@ -89,41 +182,65 @@ private:
     static void disassembleMethod();
 
     static VMFrame* popFrame();
+    static void releaseFrame(VMFrame* frm);
+
+    /// Release all frames above the target frame, which becomes the current
+    /// frame.
+    static void unwindTo(VMFrame* target);
     static void popFrameAndPushResult(vm_oop_t result);
 
-    static void send(VMSymbol* signature, VMClass* receiverClass);
+    /// Replace the current frame by a copy on the heap, which has additional
+    /// stack slots.
+    static void moveFrameToHeap(size_t additionalStackSlots);
 
-    static void triggerDoesNotUnderstand(VMSymbol* signature);
+    /// @return whether the block is an argument of a send that does not let
+    ///         it escape, based on the compiler's marking and the receiver
+    [[nodiscard]] static bool isNonEscaping(VMInvokable* blockMethod);
 
-    static void doDup();
-    static void doPushLocal(size_t bytecodeIndex);
-    static void doPushLocalWithIndex(uint8_t localIndex);
-    static void doReturnFieldWithIndex(uint8_t fieldIndex);
-    static void doPushArgument(size_t bytecodeIndex);
-    static void doPushField(size_t bytecodeIndex);
-    static void doPushFieldWithIndex(uint8_t fieldIndex);
-    static void doPushBlock(size_t bytecodeIndex);
+    static VMInvokable* lookupWithInlineCache(VMSymbol* signature,
+                                              VMClass* receiverClass,
+                                              size_t bytecodeIndex);
 
-    static inline void doPushConstant(size_t bytecodeIndex) {
-        vm_oop_t constant = method->GetConstant(bytecodeIndex);
-        GetFrame()->Push(constant);
-    }
+    static void send(VMSymbol* signature, VMClass* receiverClass,
+                     size_t bytecodeIndex);
+
+    static void rewriteBytecode(size_t bytecodeIndex, uint8_t bytecode);
+    static void quickenSend(size_t bytecodeIndex, VMSymbol* signature,
+                            VMInvokable* invokable);
+    static void deoptimizeSend(size_t bytecodeIndex);
 
+    static void triggerDoesNotUnderstand(VMSymbol* signature);
+
+    static vm_oop_t loadSelfField(uint8_t fieldIndex);
+    static void storeSelfField(uint8_t fieldIndex, vm_oop_t value);
+    static vm_oop_t incrementField(uint8_t fieldIndex);
+
+    static void doPushBlock(size_t bytecodeIndex);
     static void doPushGlobal(size_t bytecodeIndex);
-    static void doPop();
-    static void doPopLocal(size_t bytecodeIndex);
-    static void doPopLocalWithIndex(uint8_t localIndex);
-    static void doPopArgument(size_t bytecodeIndex);
-    static void doPopField(size_t bytecodeIndex);
-    static void doPopFieldWithIndex(uint8_t fieldIndex);
     static void doSend(size_t bytecodeIndex);
     static void doUnarySend(size_t bytecodeIndex);
+    static void doBinarySend(size_t bytecodeIndex);
+    static void doTernarySend(size_t bytecodeIndex);
     static void doSuperSend(size_t bytecodeIndex);
+    static void doSendPrimUnary(size_t bytecodeIndex);
+    static void doSendPrimBinary(size_t bytecodeIndex);
+    static void doSendGetter(size_t bytecodeIndex);
+    static void doSendSetter(size_t bytecodeIndex);
+    static void doSendMethod(size_t bytecodeIndex);
+
     static void doReturnLocal();
     static void doReturnNonLocal();
-    static void doInc();
-    static void doDec();
-    static void doIncField(uint8_t fieldIndex);
-    static void doIncFieldPush(uint8_t fieldIndex);
-    static bool checkIsGreater();
+
+#ifdef JIT
+    friend class JitCompiler;
+
+    static JitHelper getJitHelper(uint8_t bytecode);
+    static JitFastPath getJitFastPath(uint8_t bytecode);
+    static void doAnySend(size_t bytecodeIndex);
+    static void* continueCompiledCode(VMFrame* prevFrame,
+                                      size_t nextBytecodeIndex);
+    static bool jitIsGreater(vm_oop_t top, vm_oop_t top2);
+    static bool jitLoopStart(VMFrame* fp, gc_oop_t* sp, uint8_t slot);
+    static bool jitLoopNext(VMFrame* fp, uint8_t slot);
+#endif
 };
@@ -0,0 +1,56 @@
+#include "MethodCache.h"
+
+#include <cstddef>
+
+#include "../misc/defs.h"
+#include "../vmobjects/ObjectFormats.h"
+#include "../vmobjects/VMClass.h"
+#include "../vmobjects/VMInvokable.h"
+#include "../vmobjects/VMSymbol.h"
+
+MethodCache::Entry MethodCache::entries[METHOD_CACHE_SIZE];
+
+void MethodCache::Insert(VMClass* cls, VMSymbol* selector,
+                         VMInvokable* invokable) {
+    Entry& entry = entries[index(cls, selector)];
+    entry.cls = store_root(cls);
+    entry.selector = store_root(selector);
+    entry.invokable = store_root(invokable);
+}
+
+void MethodCache::Invalidate(VMSymbol* selector) {
+    for (Entry& entry : entries) {
+        if (load_ptr(entry.selector) == selector) {
+            entry = Entry();
+        }
+    }
+}
+
+void MethodCache::Flush() {
+    for (Entry& entry : entries) {
+        entry = Entry();
+    }
+}
+
+void MethodCache::WalkObjects(walk_heap_fn walk) {
+    Entry walked[METHOD_CACHE_SIZE];
+    size_t numWalked = 0;
+
+    for (Entry& entry : entries) {
+        if (entry.cls != nullptr) {
+            walked[numWalked].cls = static_cast<GCClass*>(walk(entry.cls));
+            walked[numWalked].selector =
+                static_cast<GCSymbol*>(walk(entry.selector));
+            walked[numWalked].invokable =
+                static_cast<GCInvokable*>(walk(entry.invokable));
+            numWalked += 1;
+            entry = Entry();
+        }
+    }
+
+    // the classes may have moved, which changes their index
+    for (size_t i = 0; i < numWalked; i += 1) {
+        Insert(load_ptr(walked[i].cls), load_ptr(walked[i].selector),
+               load_ptr(walked[i].invokable));
+    }
+}
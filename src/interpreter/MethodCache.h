@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "../misc/defs.h"
+#include "../vmobjects/ObjectFormats.h"
+#include "../vmobjects/VMSymbol.h"
+
+// the number of entries of the method cache, needs to be a power of two
+#define METHOD_CACHE_SIZE 1024
+
+/**
+ * A global cache for method lookups, keyed on the receiver class and the
+ * selector.
+ *
+ * VMClass::LookupInvokable() consults it before it searches the class
+ * hierarchy, and remembers the result for the receiver class, not for the
+ * class that defines the method. The index combines the address of the class
+ * with the hash that is stored in the symbol. Since moving GCs change the
+ * addresses, the cache is rehashed when its entries are walked.
+ *
+ * Entries need to be invalidated whenever the methods of a class change.
+ */
+class MethodCache {
+public:
+    [[nodiscard]] static inline VMInvokable* Lookup(VMClass* cls,
+                                                    VMSymbol* selector) {
+        Entry const& entry = entries[index(cls, selector)];
+        if (load_ptr(entry.cls) == cls && load_ptr(entry.selector) == selector) {
+            return load_ptr(entry.invokable);
+        }
+        return nullptr;
+    }
+
+    static void Insert(VMClass* cls, VMSymbol* selector,
+                       VMInvokable* invokable);
+
+    /// Remove all entries for the selector, for instance, because a method
+    /// with it was added to or replaced in a class.
+    static void Invalidate(VMSymbol* selector);
+
+    /// Remove all entries.
+    static void Flush();
+
+    static void WalkObjects(walk_heap_fn walk);
+
+private:
+    struct Entry {
+        GCClass* cls;
+        GCSymbol* selector;
+        GCInvokable* invokable;
+    };
+
+    [[nodiscard]] static inline size_t index(VMClass* cls,
+                                             VMSymbol* selector) {
+        return (((uintptr_t)cls >> 3U) ^ selector->GetHash()) &
+               (METHOD_CACHE_SIZE - 1);
+    }
+
+    static Entry entries[METHOD_CACHE_SIZE];
+};
@@ -0,0 +1,401 @@
+#pragma once
+
+// Generated by scripts/superinstructions.py from
+// scripts/superinstruction_profile.csv. Do not edit.
+
+// clang-format off
+#define BC_DUP_POP_LOCAL_RETURN_LOCAL             89
+#define BC_DUP_POP_LOCAL_0_PUSH_ARG_1             90
+#define BC_PUSH_LOCAL_PUSH_ARG_1_ADD              91
+#define BC_POP_LOCAL_0_PUSH_ARG_1_PUSH_SELF       92
+#define BC_PUSH_ARG_1_PUSH_SELF_PUSH_LOCAL_0      93
+#define BC_PUSH_ARG_1_PUSH_CONSTANT_0_LT          94
+#define BC_POP_PUSH_SELF_PUSH_ARG_1               95
+#define BC_PUSH_ARG_1_PUSH_CONSTANT_SUB           96
+#define BC_PUSH_SELF_PUSH_ARG_1_DEC               97
+#define BC_PUSH_SELF_PUSH_ARG_1_PUSH_CONSTANT     98
+#define BC_DUP_POP_LOCAL_0_POP                    99
+#define BC_POP_LOCAL_0_POP_INC                    100
+#define BC_DUP_POP_LOCAL_PUSH_GLOBAL              101
+#define BC_POP_LOCAL_1_PUSH_LOCAL_0_PUSH_LOCAL_1  102
+#define BC_POP_INC                                103
+#define BC_DUP_POP_LOCAL_0                        104
+#define BC_DUP_POP_LOCAL                          105
+#define BC_POP_LOCAL_RETURN_LOCAL                 106
+#define BC_POP_LOCAL_0_PUSH_ARG_1                 107
+#define BC_PUSH_LOCAL_PUSH_ARG_1                  108
+#define BC_PUSH_ARG_1_ADD                         109
+#define BC_PUSH_SELF_PUSH_LOCAL_0                 110
+#define BC_PUSH_ARG_1_PUSH_SELF                   111
+#define BC_PUSH_SELF_PUSH_ARG_1                   112
+#define BC_PUSH_CONSTANT_0_LT                     113
+#define BC_PUSH_ARG_1_PUSH_CONSTANT_0             114
+#define BC_POP_PUSH_SELF                          115
+#define BC_PUSH_ARG_1_RETURN_LOCAL                116
+#define BC_PUSH_CONSTANT_SUB                      117
+#define BC_PUSH_ARG_1_DEC                         118
+#define BC_PUSH_ARG_1_PUSH_CONSTANT               119
+#define BC_POP_LOCAL_0_POP                        120
+
+#define NUM_SUPERINSTRUCTIONS 32
+// clang-format on
+
+// the bytecodes each superinstruction combines, the first one also
+// determines the superinstruction's length
+#define SUPERINSTRUCTION_COMPONENTS                     \
+    {BC_DUP, BC_POP_LOCAL, BC_RETURN_LOCAL},            \
+    {BC_DUP, BC_POP_LOCAL_0, BC_PUSH_ARG_1},            \
+    {BC_PUSH_LOCAL, BC_PUSH_ARG_1, BC_ADD},             \
+    {BC_POP_LOCAL_0, BC_PUSH_ARG_1, BC_PUSH_SELF},      \
+    {BC_PUSH_ARG_1, BC_PUSH_SELF, BC_PUSH_LOCAL_0},     \
+    {BC_PUSH_ARG_1, BC_PUSH_CONSTANT_0, BC_LT},         \
+    {BC_POP, BC_PUSH_SELF, BC_PUSH_ARG_1},              \
+    {BC_PUSH_ARG_1, BC_PUSH_CONSTANT, BC_SUB},          \
+    {BC_PUSH_SELF, BC_PUSH_ARG_1, BC_DEC},              \
+    {BC_PUSH_SELF, BC_PUSH_ARG_1, BC_PUSH_CONSTANT},    \
+    {BC_DUP, BC_POP_LOCAL_0, BC_POP},                   \
+    {BC_POP_LOCAL_0, BC_POP, BC_INC},                   \
+    {BC_DUP, BC_POP_LOCAL, BC_PUSH_GLOBAL},             \
+    {BC_POP_LOCAL_1, BC_PUSH_LOCAL_0, BC_PUSH_LOCAL_1}, \
+    {BC_POP, BC_INC, BC_INVALID},                       \
+    {BC_DUP, BC_POP_LOCAL_0, BC_INVALID},               \
+    {BC_DUP, BC_POP_LOCAL, BC_INVALID},                 \
+    {BC_POP_LOCAL, BC_RETURN_LOCAL, BC_INVALID},        \
+    {BC_POP_LOCAL_0, BC_PUSH_ARG_1, BC_INVALID},        \
+    {BC_PUSH_LOCAL, BC_PUSH_ARG_1, BC_INVALID},         \
+    {BC_PUSH_ARG_1, BC_ADD, BC_INVALID},                \
+    {BC_PUSH_SELF, BC_PUSH_LOCAL_0, BC_INVALID},        \
+    {BC_PUSH_ARG_1, BC_PUSH_SELF, BC_INVALID},          \
+    {BC_PUSH_SELF, BC_PUSH_ARG_1, BC_INVALID},          \
+    {BC_PUSH_CONSTANT_0, BC_LT, BC_INVALID},            \
+    {BC_PUSH_ARG_1, BC_PUSH_CONSTANT_0, BC_INVALID},    \
+    {BC_POP, BC_PUSH_SELF, BC_INVALID},                 \
+    {BC_PUSH_ARG_1, BC_RETURN_LOCAL, BC_INVALID},       \
+    {BC_PUSH_CONSTANT, BC_SUB, BC_INVALID},             \
+    {BC_PUSH_ARG_1, BC_DEC, BC_INVALID},                \
+    {BC_PUSH_ARG_1, BC_PUSH_CONSTANT, BC_INVALID},      \
+    {BC_POP_LOCAL_0, BC_POP, BC_INVALID},
+
+#define SUPERINSTRUCTION_LENGTHS \
+    1,                           \
+    1,                           \
+    3,                           \
+    1,                           \
+    1,                           \
+    1,                           \
+    1,                           \
+    1,                           \
+    1,                           \
+    1,                           \
+    1,                           \
+    1,                           \
+    1,                           \
+    1,                           \
+    1,                           \
+    1,                           \
+    1,                           \
+    3,                           \
+    1,                           \
+    3,                           \
+    1,                           \
+    1,                           \
+    1,                           \
+    1,                           \
+    1,                           \
+    1,                           \
+    1,                           \
+    1,                           \
+    2,                           \
+    1,                           \
+    1,                           \
+    1,
+
+#define SUPERINSTRUCTION_NAMES               \
+    "DUP+POP_LOCAL+RETURN_LOCAL",            \
+    "DUP+POP_LOCAL_0+PUSH_ARG_1",            \
+    "PUSH_LOCAL+PUSH_ARG_1+ADD",             \
+    "POP_LOCAL_0+PUSH_ARG_1+PUSH_SELF",      \
+    "PUSH_ARG_1+PUSH_SELF+PUSH_LOCAL_0",     \
+    "PUSH_ARG_1+PUSH_CONSTANT_0+LT",         \
+    "POP+PUSH_SELF+PUSH_ARG_1",              \
+    "PUSH_ARG_1+PUSH_CONSTANT+SUB",          \
+    "PUSH_SELF+PUSH_ARG_1+DEC",              \
+    "PUSH_SELF+PUSH_ARG_1+PUSH_CONSTANT",    \
+    "DUP+POP_LOCAL_0+POP",                   \
+    "POP_LOCAL_0+POP+INC",                   \
+    "DUP+POP_LOCAL+PUSH_GLOBAL",             \
+    "POP_LOCAL_1+PUSH_LOCAL_0+PUSH_LOCAL_1", \
+    "POP+INC",                               \
+    "DUP+POP_LOCAL_0",                       \
+    "DUP+POP_LOCAL",                         \
+    "POP_LOCAL+RETURN_LOCAL",                \
+    "POP_LOCAL_0+PUSH_ARG_1",                \
+    "PUSH_LOCAL+PUSH_ARG_1",                 \
+    "PUSH_ARG_1+ADD",                        \
+    "PUSH_SELF+PUSH_LOCAL_0",                \
+    "PUSH_ARG_1+PUSH_SELF",                  \
+    "PUSH_SELF+PUSH_ARG_1",                  \
+    "PUSH_CONSTANT_0+LT",                    \
+    "PUSH_ARG_1+PUSH_CONSTANT_0",            \
+    "POP+PUSH_SELF",                         \
+    "PUSH_ARG_1+RETURN_LOCAL",               \
+    "PUSH_CONSTANT+SUB",                     \
+    "PUSH_ARG_1+DEC",                        \
+    "PUSH_ARG_1+PUSH_CONSTANT",              \
+    "POP_LOCAL_0+POP",
+
+#define SUPERINSTRUCTION_LOOP_TARGETS                 \
+    &&LABEL_BC_DUP_POP_LOCAL_RETURN_LOCAL,            \
+    &&LABEL_BC_DUP_POP_LOCAL_0_PUSH_ARG_1,            \
+    &&LABEL_BC_PUSH_LOCAL_PUSH_ARG_1_ADD,             \
+    &&LABEL_BC_POP_LOCAL_0_PUSH_ARG_1_PUSH_SELF,      \
+    &&LABEL_BC_PUSH_ARG_1_PUSH_SELF_PUSH_LOCAL_0,     \
+    &&LABEL_BC_PUSH_ARG_1_PUSH_CONSTANT_0_LT,         \
+    &&LABEL_BC_POP_PUSH_SELF_PUSH_ARG_1,              \
+    &&LABEL_BC_PUSH_ARG_1_PUSH_CONSTANT_SUB,          \
+    &&LABEL_BC_PUSH_SELF_PUSH_ARG_1_DEC,              \
+    &&LABEL_BC_PUSH_SELF_PUSH_ARG_1_PUSH_CONSTANT,    \
+    &&LABEL_BC_DUP_POP_LOCAL_0_POP,                   \
+    &&LABEL_BC_POP_LOCAL_0_POP_INC,                   \
+    &&LABEL_BC_DUP_POP_LOCAL_PUSH_GLOBAL,             \
+    &&LABEL_BC_POP_LOCAL_1_PUSH_LOCAL_0_PUSH_LOCAL_1, \
+    &&LABEL_BC_POP_INC,                               \
+    &&LABEL_BC_DUP_POP_LOCAL_0,                       \
+    &&LABEL_BC_DUP_POP_LOCAL,                         \
+    &&LABEL_BC_POP_LOCAL_RETURN_LOCAL,                \
+    &&LABEL_BC_POP_LOCAL_0_PUSH_ARG_1,                \
+    &&LABEL_BC_PUSH_LOCAL_PUSH_ARG_1,                 \
+    &&LABEL_BC_PUSH_ARG_1_ADD,                        \
+    &&LABEL_BC_PUSH_SELF_PUSH_LOCAL_0,                \
+    &&LABEL_BC_PUSH_ARG_1_PUSH_SELF,                  \
+    &&LABEL_BC_PUSH_SELF_PUSH_ARG_1,                  \
+    &&LABEL_BC_PUSH_CONSTANT_0_LT,                    \
+    &&LABEL_BC_PUSH_ARG_1_PUSH_CONSTANT_0,            \
+    &&LABEL_BC_POP_PUSH_SELF,                         \
+    &&LABEL_BC_PUSH_ARG_1_RETURN_LOCAL,               \
+    &&LABEL_BC_PUSH_CONSTANT_SUB,                     \
+    &&LABEL_BC_PUSH_ARG_1_DEC,                        \
+    &&LABEL_BC_PUSH_ARG_1_PUSH_CONSTANT,              \
+    &&LABEL_BC_POP_LOCAL_0_POP,
+
+#define SUPERINSTRUCTION_HANDLERS               \
+LABEL_BC_DUP_POP_LOCAL_RETURN_LOCAL:            \
+    PROLOGUE(1);                                \
+    OP_DUP();                                   \
+    PROLOGUE(3);                                \
+    OP_POP_LOCAL();                             \
+    PROLOGUE(1);                                \
+    OP_RETURN_LOCAL();                          \
+    DISPATCH_NOGC();                            \
+LABEL_BC_DUP_POP_LOCAL_0_PUSH_ARG_1:            \
+    PROLOGUE(1);                                \
+    OP_DUP();                                   \
+    PROLOGUE(1);                                \
+    OP_POP_LOCAL_0();                           \
+    PROLOGUE(1);                                \
+    OP_PUSH_ARG_1();                            \
+    DISPATCH_NOGC();                            \
+LABEL_BC_PUSH_LOCAL_PUSH_ARG_1_ADD:             \
+    PROLOGUE(3);                                \
+    OP_PUSH_LOCAL();                            \
+    PROLOGUE(1);                                \
+    OP_PUSH_ARG_1();                            \
+    PROLOGUE(2);                                \
+    OP_ADD();                                   \
+    DISPATCH_GC();                              \
+LABEL_BC_POP_LOCAL_0_PUSH_ARG_1_PUSH_SELF:      \
+    PROLOGUE(1);                                \
+    OP_POP_LOCAL_0();                           \
+    PROLOGUE(1);                                \
+    OP_PUSH_ARG_1();                            \
+    PROLOGUE(1);                                \
+    OP_PUSH_SELF();                             \
+    DISPATCH_NOGC();                            \
+LABEL_BC_PUSH_ARG_1_PUSH_SELF_PUSH_LOCAL_0:     \
+    PROLOGUE(1);                                \
+    OP_PUSH_ARG_1();                            \
+    PROLOGUE(1);                                \
+    OP_PUSH_SELF();                             \
+    PROLOGUE(1);                                \
+    OP_PUSH_LOCAL_0();                          \
+    DISPATCH_NOGC();                            \
+LABEL_BC_PUSH_ARG_1_PUSH_CONSTANT_0_LT:         \
+    PROLOGUE(1);                                \
+    OP_PUSH_ARG_1();                            \
+    PROLOGUE(1);                                \
+    OP_PUSH_CONSTANT_0();                       \
+    PROLOGUE(2);                                \
+    OP_LT();                                    \
+    DISPATCH_GC();                              \
+LABEL_BC_POP_PUSH_SELF_PUSH_ARG_1:              \
+    PROLOGUE(1);                                \
+    OP_POP();                                   \
+    PROLOGUE(1);                                \
+    OP_PUSH_SELF();                             \
+    PROLOGUE(1);                                \
+    OP_PUSH_ARG_1();                            \
+    DISPATCH_NOGC();                            \
+LABEL_BC_PUSH_ARG_1_PUSH_CONSTANT_SUB:          \
+    PROLOGUE(1);                                \
+    OP_PUSH_ARG_1();                            \
+    PROLOGUE(2);                                \
+    OP_PUSH_CONSTANT();                         \
+    PROLOGUE(2);                                \
+    OP_SUB();                                   \
+    DISPATCH_GC();                              \
+LABEL_BC_PUSH_SELF_PUSH_ARG_1_DEC:              \
+    PROLOGUE(1);                                \
+    OP_PUSH_SELF();                             \
+    PROLOGUE(1);                                \
+    OP_PUSH_ARG_1();                            \
+    PROLOGUE(1);                                \
+    OP_DEC();                                   \
+    DISPATCH_NOGC();                            \
+LABEL_BC_PUSH_SELF_PUSH_ARG_1_PUSH_CONSTANT:    \
+    PROLOGUE(1);                                \
+    OP_PUSH_SELF();                             \
+    PROLOGUE(1);                                \
+    OP_PUSH_ARG_1();                            \
+    PROLOGUE(2);                                \
+    OP_PUSH_CONSTANT();                         \
+    DISPATCH_NOGC();                            \
+LABEL_BC_DUP_POP_LOCAL_0_POP:                   \
+    PROLOGUE(1);                                \
+    OP_DUP();                                   \
+    PROLOGUE(1);                                \
+    OP_POP_LOCAL_0();                           \
+    PROLOGUE(1);                                \
+    OP_POP();                                   \
+    DISPATCH_NOGC();                            \
+LABEL_BC_POP_LOCAL_0_POP_INC:                   \
+    PROLOGUE(1);                                \
+    OP_POP_LOCAL_0();                           \
+    PROLOGUE(1);                                \
+    OP_POP();                                   \
+    PROLOGUE(1);                                \
+    OP_INC();                                   \
+    DISPATCH_GC();                              \
+LABEL_BC_DUP_POP_LOCAL_PUSH_GLOBAL:             \
+    PROLOGUE(1);                                \
+    OP_DUP();                                   \
+    PROLOGUE(3);                                \
+    OP_POP_LOCAL();                             \
+    PROLOGUE(2);                                \
+    OP_PUSH_GLOBAL();                           \
+    DISPATCH_GC();                              \
+LABEL_BC_POP_LOCAL_1_PUSH_LOCAL_0_PUSH_LOCAL_1: \
+    PROLOGUE(1);                                \
+    OP_POP_LOCAL_1();                           \
+    PROLOGUE(1);                                \
+    OP_PUSH_LOCAL_0();                          \
+    PROLOGUE(1);                                \
+    OP_PUSH_LOCAL_1();                          \
+    DISPATCH_NOGC();                            \
+LABEL_BC_POP_INC:                               \
+    PROLOGUE(1);                                \
+    OP_POP();                                   \
+    PROLOGUE(1);                                \
+    OP_INC();                                   \
+    DISPATCH_GC();                              \
+LABEL_BC_DUP_POP_LOCAL_0:                       \
+    PROLOGUE(1);                                \
+    OP_DUP();                                   \
+    PROLOGUE(1);                                \
+    OP_POP_LOCAL_0();                           \
+    DISPATCH_NOGC();                            \
+LABEL_BC_DUP_POP_LOCAL:                         \
+    PROLOGUE(1);                                \
+    OP_DUP();                                   \
+    PROLOGUE(3);                                \
+    OP_POP_LOCAL();                             \
+    DISPATCH_NOGC();                            \
+LABEL_BC_POP_LOCAL_RETURN_LOCAL:                \
+    PROLOGUE(3);                                \
+    OP_POP_LOCAL();                             \
+    PROLOGUE(1);                                \
+    OP_RETURN_LOCAL();                          \
+    DISPATCH_NOGC();                            \
+LABEL_BC_POP_LOCAL_0_PUSH_ARG_1:                \
+    PROLOGUE(1);                                \
+    OP_POP_LOCAL_0();                           \
+    PROLOGUE(1);                                \
+    OP_PUSH_ARG_1();                            \
+    DISPATCH_NOGC();                            \
+LABEL_BC_PUSH_LOCAL_PUSH_ARG_1:                 \
+    PROLOGUE(3);                                \
+    OP_PUSH_LOCAL();                            \
+    PROLOGUE(1);                                \
+    OP_PUSH_ARG_1();                            \
+    DISPATCH_NOGC();                            \
+LABEL_BC_PUSH_ARG_1_ADD:                        \
+    PROLOGUE(1);                                \
+    OP_PUSH_ARG_1();                            \
+    PROLOGUE(2);                                \
+    OP_ADD();                                   \
+    DISPATCH_GC();                              \
+LABEL_BC_PUSH_SELF_PUSH_LOCAL_0:                \
+    PROLOGUE(1);                                \
+    OP_PUSH_SELF();                             \
+    PROLOGUE(1);                                \
+    OP_PUSH_LOCAL_0();                          \
+    DISPATCH_NOGC();                            \
+LABEL_BC_PUSH_ARG_1_PUSH_SELF:                  \
+    PROLOGUE(1);                                \
+    OP_PUSH_ARG_1();                            \
+    PROLOGUE(1);                                \
+    OP_PUSH_SELF();                             \
+    DISPATCH_NOGC();                            \
+LABEL_BC_PUSH_SELF_PUSH_ARG_1:                  \
+    PROLOGUE(1);                                \
+    OP_PUSH_SELF();                             \
+    PROLOGUE(1);                                \
+    OP_PUSH_ARG_1();                            \
+    DISPATCH_NOGC();                            \
+LABEL_BC_PUSH_CONSTANT_0_LT:                    \
+    PROLOGUE(1);                                \
+    OP_PUSH_CONSTANT_0();                       \
+    PROLOGUE(2);                                \
+    OP_LT();                                    \
+    DISPATCH_GC();                              \
+LABEL_BC_PUSH_ARG_1_PUSH_CONSTANT_0:            \
+    PROLOGUE(1);                                \
+    OP_PUSH_ARG_1();                            \
+    PROLOGUE(1);                                \
+    OP_PUSH_CONSTANT_0();                       \
+    DISPATCH_NOGC();                            \
+LABEL_BC_POP_PUSH_SELF:                         \
+    PROLOGUE(1);                                \
+    OP_POP();                                   \
+    PROLOGUE(1);                                \
+    OP_PUSH_SELF();                             \
+    DISPATCH_NOGC();                            \
+LABEL_BC_PUSH_ARG_1_RETURN_LOCAL:               \
+    PROLOGUE(1);                                \
+    OP_PUSH_ARG_1();                            \
+    PROLOGUE(1);                                \
+    OP_RETURN_LOCAL();                          \
+    DISPATCH_NOGC();                            \
+LABEL_BC_PUSH_CONSTANT_SUB:                     \
+    PROLOGUE(2);                                \
+    OP_PUSH_CONSTANT();                         \
+    PROLOGUE(2);                                \
+    OP_SUB();                                   \
+    DISPATCH_GC();                              \
+LABEL_BC_PUSH_ARG_1_DEC:                        \
+    PROLOGUE(1);                                \
+    OP_PUSH_ARG_1();                            \
+    PROLOGUE(1);                                \
+    OP_DEC();                                   \
+    DISPATCH_NOGC();                            \
+LABEL_BC_PUSH_ARG_1_PUSH_CONSTANT:              \
+    PROLOGUE(1);                                \
+    OP_PUSH_ARG_1();                            \
+    PROLOGUE(2);                                \
+    OP_PUSH_CONSTANT();                         \
+    DISPATCH_NOGC();                            \
+LABEL_BC_POP_LOCAL_0_POP:                       \
+    PROLOGUE(1);                                \
+    OP_POP_LOCAL_0();                           \
+    PROLOGUE(1);                                \
+    OP_POP();                                   \
+    DISPATCH_NOGC();
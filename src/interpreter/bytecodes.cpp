@@ -27,7 +27,9 @@
  */
 
 #include <cassert>
+#include <cstddef>
 #include <cstdint>
+#include <vector>
 
 const uint8_t Bytecode::bytecodeLengths[] = {
     1,  // BC_HALT
@@ -64,7 +66,7 @@ const uint8_t Bytecode::bytecodeLengths[] = {
     1,  // BC_POP_FIELD_1
     2,  // BC_SEND
     2,  // BC_SEND_1
-    2,  // BC_SUPER_SEND
+    3,  // BC_SUPER_SEND
     1,  // BC_RETURN_LOCAL
     1,  // BC_RETURN_NON_LOCAL
     1,  // BC_RETURN_SELF
@@ -86,6 +88,7 @@ const uint8_t Bytecode::bytecodeLengths[] = {
     3,  // BC_JUMP_ON_NOT_NIL_TOP_TOP
     3,  // BC_JUMP_ON_NIL_TOP_TOP
     3,  // BC_JUMP_IF_GREATER
+    3,  // BC_JUMP_IF_LESS
     3,  // BC_JUMP_BACKWARD
 
     3,  // BC_JUMP2
@@ -98,7 +101,32 @@ const uint8_t Bytecode::bytecodeLengths[] = {
     3,  // BC_JUMP2_ON_NOT_NIL_TOP_TOP
     3,  // BC_JUMP2_ON_NIL_TOP_TOP
     3,  // BC_JUMP2_IF_GREATER
+    3,  // BC_JUMP2_IF_LESS
     3,  // BC_JUMP2_BACKWARD
+    4,  // BC_LOOP_START
+    4,  // BC_LOOP_NEXT
+    2,  // BC_LOOP_COUNTER
+    2,  // BC_SEND_2
+    2,  // BC_SEND_3
+    2,  // BC_SEND_N
+
+    2,  // BC_ADD
+    2,  // BC_SUB
+    2,  // BC_MUL
+    2,  // BC_LT
+    2,  // BC_GT
+    2,  // BC_LE
+    2,  // BC_GE
+    2,  // BC_EQ
+    2,  // BC_EQ_EQ
+
+    2,  // BC_SEND_PRIM_UNARY
+    2,  // BC_SEND_PRIM_BINARY
+    2,  // BC_SEND_GETTER
+    2,  // BC_SEND_SETTER
+    2,  // BC_SEND_METHOD
+
+    SUPERINSTRUCTION_LENGTHS
 };
 
 const char* Bytecode::bytecodeNames[] = {
@@ -157,28 +185,94 @@ const char* Bytecode::bytecodeNames[] = {
     "JUMP_ON_NOT_NIL_TOP_TOP",   // 52
     "JUMP_ON_NIL_TOP_TOP",       // 53
     "JUMP_IF_GREATER ",          // 54
-    "JUMP_BACKWARD   ",          // 55
-    "JUMP2           ",          // 56
-    "JUMP2_ON_FALSE_POP",        // 57
-    "JUMP2_ON_TRUE_POP",         // 58
-    "JUMP2_ON_FALSE_TOP_NIL",    // 59
-    "JUMP2_ON_TRUE_TOP_NIL",     // 60
-    "JUMP2_ON_NOT_NIL_POP",      // 61
-    "JUMP2_ON_NIL_POP ",         // 62
-    "JUMP2_ON_NOT_NIL_TOP_TOP",  // 63
-    "JUMP2_ON_NIL_TOP_TOP",      // 64
-    "JUMP2_IF_GREATER",          // 65
-    "JUMP2_BACKWARD  ",          // 66
+    "JUMP_IF_LESS    ",          // 55
+    "JUMP_BACKWARD   ",          // 56
+    "JUMP2           ",          // 57
+    "JUMP2_ON_FALSE_POP",        // 58
+    "JUMP2_ON_TRUE_POP",         // 59
+    "JUMP2_ON_FALSE_TOP_NIL",    // 60
+    "JUMP2_ON_TRUE_TOP_NIL",     // 61
+    "JUMP2_ON_NOT_NIL_POP",      // 62
+    "JUMP2_ON_NIL_POP ",         // 63
+    "JUMP2_ON_NOT_NIL_TOP_TOP",  // 64
+    "JUMP2_ON_NIL_TOP_TOP",      // 65
+    "JUMP2_IF_GREATER",          // 66
+    "JUMP2_IF_LESS   ",          // 67
+    "JUMP2_BACKWARD  ",          // 68
+    "LOOP_START      ",          // 69
+    "LOOP_NEXT       ",          // 70
+    "LOOP_COUNTER    ",          // 71
+    "SEND_2          ",          // 72
+    "SEND_3          ",          // 73
+    "SEND_N          ",          // 74
+    "ADD             ",          // 75
+    "SUB             ",          // 76
+    "MUL             ",          // 77
+    "LT              ",          // 78
+    "GT              ",          // 79
+    "LE              ",          // 80
+    "GE              ",          // 81
+    "EQ              ",          // 82
+    "EQ_EQ           ",          // 83
+    "SEND_PRIM_UNARY ",          // 84
+    "SEND_PRIM_BINARY",          // 85
+    "SEND_GETTER     ",          // 86
+    "SEND_SETTER     ",          // 87
+    "SEND_METHOD     ",          // 88
+
+    SUPERINSTRUCTION_NAMES
 };
 
+static_assert(FIRST_SUPERINSTRUCTION == BC_SEND_METHOD + 1,
+              "superinstructions follow the last normal bytecode");
+
+// the last row only keeps the array from being empty
+static const uint8_t superinstructionComponents[][3] = {
+    SUPERINSTRUCTION_COMPONENTS{BC_INVALID, BC_INVALID, BC_INVALID}};
+
+const uint8_t* GetSuperinstructionComponents(uint8_t bc) {
+    assert(FIRST_SUPERINSTRUCTION <= bc && bc <= _LAST_BYTECODE);
+    return superinstructionComponents[bc - FIRST_SUPERINSTRUCTION];
+}
+
 bool IsJumpBytecode(uint8_t bc) {
     static_assert(
         BC_JUMP < BC_JUMP2_BACKWARD,
         "make sure the nummeric value of jump bytecodes is as expected");
-    static_assert((BC_JUMP2_BACKWARD - BC_JUMP) == 21,
-                  "we expect there to be 22 jump bytecodes");
+    static_assert((BC_JUMP2_BACKWARD - BC_JUMP) == 23,
+                  "we expect there to be 24 jump bytecodes");
+    static_assert(BC_LOOP_START == BC_JUMP2_BACKWARD + 1 &&
+                      BC_LOOP_NEXT == BC_LOOP_START + 1,
+                  "the loop bytecodes follow the jump bytecodes");
 
-    return BC_JUMP <= bc && bc <= BC_JUMP2_BACKWARD;
+    return BC_JUMP <= bc && bc <= BC_LOOP_NEXT;
+}
+
+bool IsBackwardJumpBytecode(uint8_t bc) {
+    return bc == BC_JUMP_BACKWARD || bc == BC_JUMP2_BACKWARD ||
+           bc == BC_LOOP_NEXT;
+}
+
+std::vector<bool> GetJumpTargets(const uint8_t* bytecodes,
+                                 size_t numberOfBytecodes) {
+    std::vector<bool> isTarget(numberOfBytecodes, false);
+
+    for (size_t i = 0; i < numberOfBytecodes;
+         i += Bytecode::GetBytecodeLength(bytecodes[i])) {
+        uint8_t const bc = bytecodes[i];
+        if (!IsJumpBytecode(bc)) {
+            continue;
+        }
+
+        uint16_t const offset =
+            ComputeOffset(bytecodes[i + 1], bytecodes[i + 2]);
+        if (IsBackwardJumpBytecode(bc)) {
+            isTarget[i - offset] = true;
+        } else if (i + offset < numberOfBytecodes) {
+            isTarget[i + offset] = true;
+        }
+    }
+    return isTarget;
 }
 
 uint8_t IsPushConstBytecode(uint8_t bc) {
@@ -263,6 +357,19 @@ uint8_t IsPopSmthBytecode(uint8_t bc) {
     }
 }
 
+uint8_t SendBytecodeForArguments(uint8_t numberOfArguments) {
+    switch (numberOfArguments) {
+        case 1:
+            return BC_SEND_1;
+        case 2:
+            return BC_SEND_2;
+        case 3:
+            return BC_SEND_3;
+        default:
+            return BC_SEND_N;
+    }
+}
+
 bool Bytecode::BytecodeDefinitionsAreConsistent() {
     bool const namesAndLengthMatch =
         (sizeof(Bytecode::bytecodeNames) / sizeof(char*)) ==
@@ -271,5 +378,15 @@ bool Bytecode::BytecodeDefinitionsAreConsistent() {
         _LAST_BYTECODE ==
         (sizeof(Bytecode::bytecodeLengths) - 1);  // -1 because null terminated
 
-    return namesAndLengthMatch && lastBytecodeLinesUp;
+    // a superinstruction takes the place of its first bytecode
+    bool superinstructionLengthsMatch = true;
+    for (size_t bc = FIRST_SUPERINSTRUCTION; bc <= _LAST_BYTECODE; bc += 1) {
+        uint8_t const first = GetSuperinstructionComponents(bc)[0];
+        superinstructionLengthsMatch = superinstructionLengthsMatch &&
+                                       bytecodeLengths[bc] ==
+                                           bytecodeLengths[first];
+    }
+
+    return namesAndLengthMatch && lastBytecodeLinesUp &&
+           superinstructionLengthsMatch;
 }
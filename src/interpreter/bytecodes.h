@@ -27,8 +27,11 @@
  */
 
 #include <cassert>
+#include <cstddef>
+#include <vector>
 
 #include "../misc/defs.h"
+#include "Superinstructions.h"
 
 // bytecode constants used by SOM++
 
@@ -88,33 +91,57 @@
 #define BC_JUMP_ON_NOT_NIL_TOP_TOP 52
 #define BC_JUMP_ON_NIL_TOP_TOP    53
 #define BC_JUMP_IF_GREATER        54
-#define BC_JUMP_BACKWARD          55
-#define BC_JUMP2                  56
-#define BC_JUMP2_ON_FALSE_POP     57
-#define BC_JUMP2_ON_TRUE_POP      58
-#define BC_JUMP2_ON_FALSE_TOP_NIL 59
-#define BC_JUMP2_ON_TRUE_TOP_NIL  60
-#define BC_JUMP2_ON_NOT_NIL_POP   61
-#define BC_JUMP2_ON_NIL_POP       62
-#define BC_JUMP2_ON_NOT_NIL_TOP_TOP 63
-#define BC_JUMP2_ON_NIL_TOP_TOP   64
-#define BC_JUMP2_IF_GREATER       65
-#define BC_JUMP2_BACKWARD         66
-
-#define _LAST_BYTECODE BC_JUMP2_BACKWARD
+#define BC_JUMP_IF_LESS           55
+#define BC_JUMP_BACKWARD          56
+#define BC_JUMP2                  57
+#define BC_JUMP2_ON_FALSE_POP     58
+#define BC_JUMP2_ON_TRUE_POP      59
+#define BC_JUMP2_ON_FALSE_TOP_NIL 60
+#define BC_JUMP2_ON_TRUE_TOP_NIL  61
+#define BC_JUMP2_ON_NOT_NIL_POP   62
+#define BC_JUMP2_ON_NIL_POP       63
+#define BC_JUMP2_ON_NOT_NIL_TOP_TOP 64
+#define BC_JUMP2_ON_NIL_TOP_TOP   65
+#define BC_JUMP2_IF_GREATER       66
+#define BC_JUMP2_IF_LESS          67
+#define BC_JUMP2_BACKWARD         68
+
+// counted loops, which keep their counter unboxed in the frame, see
+// VMFrame::GetLoopSlot(). They are jumps with a 16-bit offset and a slot.
+#define BC_LOOP_START             69
+#define BC_LOOP_NEXT              70
+#define BC_LOOP_COUNTER           71
+
+#define BC_SEND_2                 72
+#define BC_SEND_3                 73
+#define BC_SEND_N                 74
+
+// sends of special selectors, with fast paths for integers and doubles
+#define BC_ADD                    75
+#define BC_SUB                    76
+#define BC_MUL                    77
+#define BC_LT                     78
+#define BC_GT                     79
+#define BC_LE                     80
+#define BC_GE                     81
+#define BC_EQ                     82
+#define BC_EQ_EQ                  83
+
+// quickened sends, only created at run time by rewriting the sends above
+#define BC_SEND_PRIM_UNARY        84
+#define BC_SEND_PRIM_BINARY       85
+#define BC_SEND_GETTER            86
+#define BC_SEND_SETTER            87
+#define BC_SEND_METHOD            88
+
+// superinstructions, generated from a profile into Superinstructions.h
+#define FIRST_SUPERINSTRUCTION    89
+
+#define _LAST_BYTECODE (BC_SEND_METHOD + NUM_SUPERINSTRUCTIONS)
 
 #define BC_INVALID           255
 // clang-format on
 
-// TODO(smarr): port support for these bytecodes
-//       they were already named in ported code, and it seemed nicer to just
-//       already include that code
-// clang-format off
-#define BC_SEND_N            250
-#define BC_SEND_3            249
-#define BC_SEND_2            248
-// clang-format on
-
 // properties of the bytecodes
 
 #define FIRST_DOUBLE_BYTE_JUMP_BYTECODE BC_JUMP2
@@ -143,9 +170,30 @@ inline uint16_t ComputeOffset(uint8_t byte1, uint8_t byte2) {
 }
 
 bool IsJumpBytecode(uint8_t bc);
+bool IsBackwardJumpBytecode(uint8_t bc);
+
+/// Marks the indexes of the bytecodes that are the target of a jump.
+std::vector<bool> GetJumpTargets(const uint8_t* bytecodes,
+                                 size_t numberOfBytecodes);
 uint8_t IsPushConstBytecode(uint8_t bc);
 uint8_t IsPushFieldBytecode(uint8_t bc);
 uint8_t IsPushArgBytecode(uint8_t bc);
 uint8_t IsPopFieldBytecode(uint8_t bc);
 uint8_t IsPopSmthBytecode(uint8_t bc);
 uint8_t IsReturnFieldBytecode(uint8_t bc);
+
+/// The bytecodes combined by a superinstruction, padded with BC_INVALID.
+const uint8_t* GetSuperinstructionComponents(uint8_t bc);
+
+/// The first bytecode of a superinstruction, or the bytecode itself. The
+/// superinstruction replaces only this bytecode, all others remain in place.
+inline uint8_t BaseBytecode(uint8_t bc) {
+    if (likely(bc < FIRST_SUPERINSTRUCTION || bc == BC_INVALID)) {
+        return bc;
+    }
+    return GetSuperinstructionComponents(bc)[0];
+}
+
+/// The send bytecode specialized for the given number of arguments,
+/// which includes the receiver.
+uint8_t SendBytecodeForArguments(uint8_t numberOfArguments);
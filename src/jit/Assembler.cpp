@@ -0,0 +1,237 @@
+#include "Assembler.h"
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+void Assembler::Bind(Label& label) {
+    assert(!label.IsBound());
+    label.position = (int64_t)code.size();
+
+    for (size_t const use : label.unresolvedUses) {
+        // displacements are relative to the end of the instruction, which is
+        // where the displacement ends
+        auto const rel = (uint32_t)(int32_t)(label.position - (use + 4));
+        for (size_t i = 0; i < 4; i += 1) {
+            code[use + i] = (uint8_t)(rel >> (8 * i));
+        }
+    }
+    label.unresolvedUses.clear();
+}
+
+void Assembler::emit32(uint32_t value) {
+    for (size_t i = 0; i < 4; i += 1) {
+        emit8((uint8_t)(value >> (8 * i)));
+    }
+}
+
+void Assembler::emit64(uint64_t value) {
+    for (size_t i = 0; i < 8; i += 1) {
+        emit8((uint8_t)(value >> (8 * i)));
+    }
+}
+
+void Assembler::emitRex(bool wide, uint8_t reg, uint8_t rm) {
+    uint8_t const rex = 0x40U | (wide ? 0x08U : 0U) |
+                        ((reg & 8U) != 0 ? 0x04U : 0U) |
+                        ((rm & 8U) != 0 ? 0x01U : 0U);
+    if (rex != 0x40U) {
+        emit8(rex);
+    }
+}
+
+void Assembler::emitModRm(uint8_t mod, uint8_t reg, uint8_t rm) {
+    emit8((uint8_t)((mod << 6U) | ((reg & 7U) << 3U) | (rm & 7U)));
+}
+
+void Assembler::emitMemoryOperand(uint8_t reg, Register base, int32_t disp) {
+    // [rbp] and [r13] can only be encoded with a displacement
+    bool const needsDisp = disp != 0 || (base & 7U) == RBP;
+    bool const smallDisp = disp >= -128 && disp <= 127;
+
+    uint8_t const mod = !needsDisp ? 0 : (smallDisp ? 1 : 2);
+    emitModRm(mod, reg, base);
+
+    // [rsp] and [r12] need a SIB byte
+    if ((base & 7U) == RSP) {
+        emit8(0x24);
+    }
+
+    if (mod == 1) {
+        emit8((uint8_t)(int8_t)disp);
+    } else if (mod == 2) {
+        emit32((uint32_t)disp);
+    }
+}
+
+void Assembler::emitOp(uint8_t opcode, Register dst, Register src) {
+    emitRex(true, src, dst);
+    emit8(opcode);
+    emitModRm(3, src, dst);
+}
+
+void Assembler::emitOpWithImm(uint8_t opExt, Register dst, int32_t imm) {
+    emitRex(true, 0, dst);
+    if (imm >= -128 && imm <= 127) {
+        emit8(0x83);
+        emitModRm(3, opExt, dst);
+        emit8((uint8_t)(int8_t)imm);
+    } else {
+        emit8(0x81);
+        emitModRm(3, opExt, dst);
+        emit32((uint32_t)imm);
+    }
+}
+
+void Assembler::emitLabelUse(Label& label) {
+    if (label.IsBound()) {
+        auto const end = (int64_t)(code.size() + 4);
+        emit32((uint32_t)(int32_t)(label.position - end));
+    } else {
+        label.unresolvedUses.push_back(code.size());
+        emit32(0);
+    }
+}
+
+void Assembler::MovImm32(Register dst, uint32_t imm) {
+    // zero extends into the upper half of the register
+    emitRex(false, 0, dst);
+    emit8(0xB8U + (dst & 7U));
+    emit32(imm);
+}
+
+void Assembler::MovImm64(Register dst, uint64_t imm) {
+    emitRex(true, 0, dst);
+    emit8(0xB8U + (dst & 7U));
+    emit64(imm);
+}
+
+void Assembler::Mov(Register dst, Register src) {
+    emitOp(0x89, dst, src);
+}
+
+void Assembler::Load(Register dst, Register base, int32_t disp) {
+    emitRex(true, dst, base);
+    emit8(0x8B);
+    emitMemoryOperand(dst, base, disp);
+}
+
+void Assembler::Store(Register base, int32_t disp, Register src) {
+    emitRex(true, src, base);
+    emit8(0x89);
+    emitMemoryOperand(src, base, disp);
+}
+
+void Assembler::StoreByteImm(Register base, int32_t disp, uint8_t imm) {
+    emitRex(false, 0, base);
+    emit8(0xC6);
+    emitMemoryOperand(0, base, disp);
+    emit8(imm);
+}
+
+void Assembler::Add(Register dst, Register src) {
+    emitOp(0x01, dst, src);
+}
+
+void Assembler::Sub(Register dst, Register src) {
+    emitOp(0x29, dst, src);
+}
+
+void Assembler::And(Register dst, Register src) {
+    emitOp(0x21, dst, src);
+}
+
+void Assembler::AddImm(Register dst, int32_t imm) {
+    emitOpWithImm(0, dst, imm);
+}
+
+void Assembler::SubImm(Register dst, int32_t imm) {
+    emitOpWithImm(5, dst, imm);
+}
+
+void Assembler::AndImm32(Register dst, int8_t imm) {
+    emitRex(false, 0, dst);
+    emit8(0x83);
+    emitModRm(3, 4, dst);
+    emit8((uint8_t)imm);
+}
+
+void Assembler::CmpImm32(Register dst, int8_t imm) {
+    emitRex(false, 0, dst);
+    emit8(0x83);
+    emitModRm(3, 7, dst);
+    emit8((uint8_t)imm);
+}
+
+void Assembler::ShrImm(Register dst, uint8_t imm) {
+    emitRex(true, 0, dst);
+    emit8(0xC1);
+    emitModRm(3, 5, dst);
+    emit8(imm);
+}
+
+void Assembler::Cmp(Register left, Register right) {
+    emitOp(0x39, left, right);
+}
+
+void Assembler::Cmp(Register left, Register base, int32_t disp) {
+    emitRex(true, left, base);
+    emit8(0x3B);
+    emitMemoryOperand(left, base, disp);
+}
+
+void Assembler::Test(Register left, Register right) {
+    emitOp(0x85, left, right);
+}
+
+void Assembler::TestAl() {
+    emit8(0x84);
+    emit8(0xC0);
+}
+
+void Assembler::TestLowByte(Register reg, uint8_t imm) {
+    // without a REX prefix, 4 to 7 would be ah, ch, dh, and bh
+    if (reg >= RSP) {
+        emit8(0x40U | ((reg & 8U) != 0 ? 0x01U : 0U));
+    }
+    emit8(0xF6);
+    emitModRm(3, 0, reg);
+    emit8(imm);
+}
+
+void Assembler::Push(Register reg) {
+    emitRex(false, 0, reg);
+    emit8(0x50U + (reg & 7U));
+}
+
+void Assembler::Pop(Register reg) {
+    emitRex(false, 0, reg);
+    emit8(0x58U + (reg & 7U));
+}
+
+void Assembler::Call(Register target) {
+    emitRex(false, 0, target);
+    emit8(0xFF);
+    emitModRm(3, 2, target);
+}
+
+void Assembler::Jmp(Register target) {
+    emitRex(false, 0, target);
+    emit8(0xFF);
+    emitModRm(3, 4, target);
+}
+
+void Assembler::Jmp(Label& target) {
+    emit8(0xE9);
+    emitLabelUse(target);
+}
+
+void Assembler::J(Condition cond, Label& target) {
+    emit8(0x0F);
+    emit8(0x80U + cond);
+    emitLabelUse(target);
+}
+
+void Assembler::Ret() {
+    emit8(0xC3);
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// clang-format off
+enum Register : uint8_t {
+    RAX = 0, RCX = 1, RDX = 2,  RBX = 3,  RSP = 4,  RBP = 5,  RSI = 6,  RDI = 7,
+    R8  = 8, R9  = 9, R10 = 10, R11 = 11, R12 = 12, R13 = 13, R14 = 14, R15 = 15
+};
+// clang-format on
+
+enum Condition : uint8_t {
+    COND_OVERFLOW = 0x0,
+    COND_ABOVE_EQUAL = 0x3,
+    COND_EQUAL = 0x4,
+    COND_NOT_EQUAL = 0x5,
+    COND_LESS = 0xC,
+    COND_GREATER_EQUAL = 0xD,
+    COND_LESS_EQUAL = 0xE,
+    COND_GREATER = 0xF
+};
+
+/**
+ * A position in the code, which jumps can refer to before it is known.
+ */
+class Label {
+public:
+    [[nodiscard]] bool IsBound() const { return position >= 0; }
+    [[nodiscard]] size_t GetPosition() const { return (size_t)position; }
+    [[nodiscard]] bool IsUsed() const { return !unresolvedUses.empty(); }
+
+private:
+    friend class Assembler;
+
+    int64_t position{-1};
+
+    // the offsets of the 32-bit displacements that still need to be patched
+    std::vector<size_t> unresolvedUses;
+};
+
+/**
+ * A minimal x86-64 assembler with only the instructions the JIT needs.
+ *
+ * All jumps are relative to the code itself, so that it can be copied into
+ * the code cache once it is complete.
+ */
+class Assembler {
+public:
+    void Bind(Label& label);
+
+    void MovImm32(Register dst, uint32_t imm);
+    void MovImm64(Register dst, uint64_t imm);
+    void Mov(Register dst, Register src);
+    void Load(Register dst, Register base, int32_t disp);
+    void Store(Register base, int32_t disp, Register src);
+    void StoreByteImm(Register base, int32_t disp, uint8_t imm);
+
+    void Add(Register dst, Register src);
+    void Sub(Register dst, Register src);
+    void And(Register dst, Register src);
+    void AddImm(Register dst, int32_t imm);
+    void SubImm(Register dst, int32_t imm);
+    void AndImm32(Register dst, int8_t imm);
+    void CmpImm32(Register dst, int8_t imm);
+    void ShrImm(Register dst, uint8_t imm);
+    void Cmp(Register left, Register right);
+    void Cmp(Register left, Register base, int32_t disp);
+    void Test(Register left, Register right);
+    void TestAl();
+    void TestLowByte(Register reg, uint8_t imm);
+
+    void Push(Register reg);
+    void Pop(Register reg);
+    void Call(Register target);
+    void Jmp(Register target);
+    void Jmp(Label& target);
+    void J(Condition cond, Label& target);
+    void Ret();
+
+    [[nodiscard]] const std::vector<uint8_t>& GetCode() const { return code; }
+
+private:
+    void emit8(uint8_t byte) { code.push_back(byte); }
+    void emit32(uint32_t value);
+    void emit64(uint64_t value);
+
+    void emitRex(bool wide, uint8_t reg, uint8_t rm);
+    void emitModRm(uint8_t mod, uint8_t reg, uint8_t rm);
+    void emitMemoryOperand(uint8_t reg, Register base, int32_t disp);
+    void emitOp(uint8_t opcode, Register dst, Register src);
+    void emitOpWithImm(uint8_t opExt, Register dst, int32_t imm);
+    void emitLabelUse(Label& label);
+
+    std::vector<uint8_t> code;
+};
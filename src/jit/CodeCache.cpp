@@ -0,0 +1,52 @@
+#include "CodeCache.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <vector>
+
+#include "../vm/Print.h"
+
+uint8_t* CodeCache::start = nullptr;
+size_t CodeCache::used = 0;
+
+void CodeCache::initialize() {
+    void* memory = mmap(nullptr, JIT_CODE_CACHE_SIZE, PROT_READ | PROT_EXEC,
+                        MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (memory == MAP_FAILED) {
+        ErrorExit("Failed to allocate the code cache for the JIT");
+    }
+    start = (uint8_t*)memory;
+}
+
+uint8_t* CodeCache::Install(const std::vector<uint8_t>& code) {
+    if (start == nullptr) {
+        initialize();
+    }
+
+    // keep code 16-byte aligned, which is what compilers do, too
+    size_t const size = (code.size() + 15) & ~(size_t)15;
+    if (used + size > JIT_CODE_CACHE_SIZE) {
+        return nullptr;
+    }
+
+    auto const pageSize = (size_t)sysconf(_SC_PAGESIZE);
+    size_t const firstPage = used & ~(pageSize - 1);
+    size_t const endOfLastPage = (used + size + pageSize - 1) & ~(pageSize - 1);
+    size_t const length = endOfLastPage - firstPage;
+
+    if (mprotect(start + firstPage, length, PROT_READ | PROT_WRITE) != 0) {
+        ErrorExit("Failed to make the code cache writable");
+    }
+
+    uint8_t* result = start + used;
+    memcpy(result, code.data(), code.size());
+    used += size;
+
+    if (mprotect(start + firstPage, length, PROT_READ | PROT_EXEC) != 0) {
+        ErrorExit("Failed to make the code cache executable");
+    }
+    return result;
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#define JIT_CODE_CACHE_SIZE (32 * 1024 * 1024)
+
+/**
+ * The executable memory for compiled code.
+ *
+ * Code is only appended, and never freed. The memory is writable only while
+ * new code is copied into it.
+ */
+class CodeCache {
+public:
+    /// Copy the code into the cache.
+    /// @return the address of the code, or nullptr if the cache is full
+    static uint8_t* Install(const std::vector<uint8_t>& code);
+
+private:
+    static void initialize();
+
+    static uint8_t* start;
+    static size_t used;
+};
@@ -0,0 +1,691 @@
+#include "JitCompiler.h"
+
+#include <cstddef>
+#include <cstdint>
+
+#include "../interpreter/Interpreter.h"
+#include "../interpreter/bytecodes.h"
+#include "../memory/Heap.h"
+#include "../misc/defs.h"
+#include "../vm/Globals.h"
+#include "../vmobjects/ObjectFormats.h"
+#include "../vmobjects/VMAssociation.h"
+#include "../vmobjects/VMFrame.h"
+#include "../vmobjects/VMMethod.h"
+#include "../vmobjects/VMObject.h"
+#include "Assembler.h"
+#include "CodeCache.h"
+
+#if GC_TYPE == GENERATIONAL
+  #include "../memory/GenerationalHeap.h"
+#endif
+
+// VMFrame, VMMethod, and VMAssociation are not standard-layout, but GCC and Clang lay out
+// their fields like any other class
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Winvalid-offsetof"
+const int32_t JitCompiler::FRAME_CONTEXT = offsetof(VMFrame, context);
+const int32_t JitCompiler::FRAME_OUTER_CONTEXT =
+    offsetof(VMFrame, outerContext);
+const int32_t JitCompiler::FRAME_METHOD = offsetof(VMFrame, method);
+const int32_t JitCompiler::FRAME_ARGUMENTS = offsetof(VMFrame, arguments);
+const int32_t JitCompiler::FRAME_LOCALS = offsetof(VMFrame, locals);
+const int32_t JitCompiler::FRAME_STACK_PTR = offsetof(VMFrame, stack_ptr);
+const int32_t JitCompiler::METHOD_LITERALS =
+    offsetof(VMMethod, indexableFields);
+const int32_t JitCompiler::ASSOCIATION_VALUE = offsetof(VMAssociation, value);
+#pragma GCC diagnostic pop
+
+static const int32_t WORD = sizeof(gc_oop_t);
+
+// the fields of an object follow its header, see FIELDS in VMObject.h
+static const int32_t OBJECT_FIELDS = sizeof(VMObject);
+
+void (*JitCompiler::enter)(void* entry) = nullptr;
+void* JitCompiler::exitToInterpreter = nullptr;
+
+bool JitCompiler::Compile(VMMethod* method) {
+    if (enter == nullptr && !generateEntryAndExit()) {
+        return false;
+    }
+
+    JitCompiler compiler(method);
+    return compiler.compile();
+}
+
+JitCompiler::JitCompiler(VMMethod* method)
+    : method(method), bytecodeLabels(method->GetNumberOfBytecodes()) {}
+
+bool JitCompiler::generateEntryAndExit() {
+    Assembler stubs;
+
+    // rbx, r12, and r13 are callee-saved. Pushing three registers also keeps
+    // the stack 16-byte aligned for the calls from compiled code.
+    stubs.Push(RBX);
+    stubs.Push(R12);
+    stubs.Push(R13);
+
+    stubs.MovImm64(RAX, (uint64_t)&Interpreter::frame);
+    stubs.Load(RBX, RAX, 0);
+    stubs.Load(R12, RBX, FRAME_STACK_PTR);
+    stubs.Jmp(RDI);
+
+    Label exit;
+    stubs.Bind(exit);
+    stubs.Pop(R13);
+    stubs.Pop(R12);
+    stubs.Pop(RBX);
+    stubs.Ret();
+
+    uint8_t* code = CodeCache::Install(stubs.GetCode());
+    if (code == nullptr) {
+        return false;
+    }
+    enter = (void (*)(void*))code;
+    exitToInterpreter = code + exit.GetPosition();
+    return true;
+}
+
+bool JitCompiler::compile() {
+    size_t const length = method->GetNumberOfBytecodes();
+
+    for (size_t i = 0; i < length;) {
+        masm.Bind(bytecodeLabels[i]);
+
+        // superinstructions start with their first component, and the
+        // other components follow as normal bytecodes
+        uint8_t const bytecode = BaseBytecode(method->GetBytecode(i));
+        if (!compileBytecode(i, bytecode)) {
+            return false;
+        }
+        i += Bytecode::GetBytecodeLength(bytecode);
+    }
+
+    for (Label const& label : bytecodeLabels) {
+        if (!label.IsBound() && label.IsUsed()) {
+            // a jump into the middle of a bytecode
+            return false;
+        }
+    }
+
+    uint8_t* code = CodeCache::Install(masm.GetCode());
+    if (code == nullptr) {
+        return false;
+    }
+
+    auto** entries = new void*[length]();
+    for (size_t i = 0; i < length; i += 1) {
+        if (bytecodeLabels[i].IsBound()) {
+            entries[i] = code + bytecodeLabels[i].GetPosition();
+        }
+    }
+    method->jitEntries = entries;
+    return true;
+}
+
+bool JitCompiler::compileBytecode(size_t bcIdx, uint8_t bytecode) {
+    uint8_t const operand1 =
+        bcIdx + 1 < method->GetNumberOfBytecodes()
+            ? method->GetBytecode(bcIdx + 1)
+            : 0;
+    uint8_t const operand2 =
+        bcIdx + 2 < method->GetNumberOfBytecodes()
+            ? method->GetBytecode(bcIdx + 2)
+            : 0;
+
+    switch (bytecode) {
+        case BC_DUP:
+            masm.Load(RAX, R12, 0);
+            emitPush(RAX);
+            return true;
+        case BC_DUP_SECOND:
+            masm.Load(RAX, R12, -WORD);
+            emitPush(RAX);
+            return true;
+
+        case BC_PUSH_LOCAL:
+            emitPushVariable(FRAME_LOCALS, operand1, operand2);
+            return true;
+        case BC_PUSH_LOCAL_0:
+        case BC_PUSH_LOCAL_1:
+        case BC_PUSH_LOCAL_2:
+            emitPushVariable(FRAME_LOCALS, bytecode - BC_PUSH_LOCAL_0, 0);
+            return true;
+        case BC_PUSH_ARGUMENT:
+            emitPushVariable(FRAME_ARGUMENTS, operand1, operand2);
+            return true;
+        case BC_PUSH_SELF:
+        case BC_PUSH_ARG_1:
+        case BC_PUSH_ARG_2:
+            emitPushVariable(FRAME_ARGUMENTS, bytecode - BC_PUSH_SELF, 0);
+            return true;
+
+        case BC_PUSH_CONSTANT:
+            emitPushLiteral(operand1);
+            return true;
+        case BC_PUSH_CONSTANT_0:
+        case BC_PUSH_CONSTANT_1:
+        case BC_PUSH_CONSTANT_2:
+            emitPushLiteral(bytecode - BC_PUSH_CONSTANT_0);
+            return true;
+        case BC_PUSH_GLOBAL:
+            emitPushGlobal(bcIdx, operand1);
+            return true;
+
+        case BC_PUSH_FIELD:
+            emitPushField(operand1);
+            return true;
+        case BC_PUSH_FIELD_0:
+        case BC_PUSH_FIELD_1:
+            emitPushField(bytecode - BC_PUSH_FIELD_0);
+            return true;
+
+        case BC_PUSH_NIL:
+            emitLoadRoot(RAX, &nilObject);
+            emitPush(RAX);
+            return true;
+
+        case BC_POP:
+            masm.SubImm(R12, WORD);
+            return true;
+        case BC_POP_LOCAL:
+            emitPopVariable(FRAME_LOCALS, operand1, operand2);
+            return true;
+        case BC_POP_LOCAL_0:
+        case BC_POP_LOCAL_1:
+        case BC_POP_LOCAL_2:
+            emitPopVariable(FRAME_LOCALS, bytecode - BC_POP_LOCAL_0, 0);
+            return true;
+        case BC_POP_ARGUMENT:
+            emitPopVariable(FRAME_ARGUMENTS, operand1, operand2);
+            return true;
+        case BC_POP_FIELD:
+            emitPopField(operand1);
+            return true;
+        case BC_POP_FIELD_0:
+        case BC_POP_FIELD_1:
+            emitPopField(bytecode - BC_POP_FIELD_0);
+            return true;
+
+        case BC_JUMP:
+        case BC_JUMP_ON_FALSE_POP:
+        case BC_JUMP_ON_TRUE_POP:
+        case BC_JUMP_ON_FALSE_TOP_NIL:
+        case BC_JUMP_ON_TRUE_TOP_NIL:
+        case BC_JUMP_ON_NOT_NIL_POP:
+        case BC_JUMP_ON_NIL_POP:
+        case BC_JUMP_ON_NOT_NIL_TOP_TOP:
+        case BC_JUMP_ON_NIL_TOP_TOP:
+        case BC_JUMP_IF_GREATER:
+        case BC_JUMP_IF_LESS:
+        case BC_JUMP_BACKWARD:
+        case BC_JUMP2:
+        case BC_JUMP2_ON_FALSE_POP:
+        case BC_JUMP2_ON_TRUE_POP:
+        case BC_JUMP2_ON_FALSE_TOP_NIL:
+        case BC_JUMP2_ON_TRUE_TOP_NIL:
+        case BC_JUMP2_ON_NOT_NIL_POP:
+        case BC_JUMP2_ON_NIL_POP:
+        case BC_JUMP2_ON_NOT_NIL_TOP_TOP:
+        case BC_JUMP2_ON_NIL_TOP_TOP:
+        case BC_JUMP2_IF_GREATER:
+        case BC_JUMP2_IF_LESS:
+        case BC_JUMP2_BACKWARD:
+        case BC_LOOP_START:
+        case BC_LOOP_NEXT:
+            return compileJump(bcIdx, bytecode);
+
+        default: {
+            JitHelper const helper = Interpreter::getJitHelper(bytecode);
+            if (helper == nullptr) {
+                return false;
+            }
+
+            JitFastPath const fastPath = Interpreter::getJitFastPath(bytecode);
+            if (bytecode == BC_INC_FIELD || bytecode == BC_INC_FIELD_PUSH) {
+                emitIncrementField(helper, bcIdx, operand1,
+                                   bytecode == BC_INC_FIELD_PUSH);
+            } else if (fastPath != nullptr) {
+                emitFastPath(bytecode, fastPath, helper, bcIdx);
+            } else {
+                emitHelperCall(helper, bcIdx);
+            }
+            return true;
+        }
+    }
+}
+
+bool JitCompiler::compileJump(size_t bcIdx, uint8_t bytecode) {
+    uint8_t const operand1 = method->GetBytecode(bcIdx + 1);
+    uint8_t const operand2 = method->GetBytecode(bcIdx + 2);
+
+    size_t offset = operand1;
+    uint8_t jump = bytecode;
+    if (bytecode == BC_LOOP_START || bytecode == BC_LOOP_NEXT) {
+        offset = ComputeOffset(operand1, operand2);
+    } else if (bytecode >= FIRST_DOUBLE_BYTE_JUMP_BYTECODE) {
+        offset = ComputeOffset(operand1, operand2);
+        jump = bytecode - NUM_SINGLE_BYTE_JUMP_BYTECODES;
+    }
+
+    size_t const target =
+        IsBackwardJumpBytecode(jump) ? bcIdx - offset : bcIdx + offset;
+    if (target >= bytecodeLabels.size()) {
+        return false;
+    }
+    Label& targetLabel = bytecodeLabels[target];
+
+    switch (jump) {
+        case BC_JUMP:
+        case BC_JUMP_BACKWARD:
+            masm.Jmp(targetLabel);
+            return true;
+
+        case BC_JUMP_ON_FALSE_POP:
+        case BC_JUMP_ON_TRUE_POP:
+        case BC_JUMP_ON_NOT_NIL_POP:
+        case BC_JUMP_ON_NIL_POP: {
+            void* root = jump == BC_JUMP_ON_FALSE_POP  ? &falseObject
+                             : jump == BC_JUMP_ON_TRUE_POP ? &trueObject
+                                                           : &nilObject;
+            masm.Load(RAX, R12, 0);
+            masm.SubImm(R12, WORD);
+            emitCompareWithRoot(RAX, root);
+            masm.J(jump == BC_JUMP_ON_NOT_NIL_POP ? COND_NOT_EQUAL
+                                                  : COND_EQUAL,
+                   targetLabel);
+            return true;
+        }
+
+        case BC_JUMP_ON_FALSE_TOP_NIL:
+        case BC_JUMP_ON_TRUE_TOP_NIL: {
+            Label notTaken;
+            masm.Load(RAX, R12, 0);
+            emitCompareWithRoot(RAX, jump == BC_JUMP_ON_FALSE_TOP_NIL
+                                         ? &falseObject
+                                         : &trueObject);
+            masm.J(COND_NOT_EQUAL, notTaken);
+            emitLoadRoot(RCX, &nilObject);
+            masm.Store(R12, 0, RCX);
+            masm.Jmp(targetLabel);
+            masm.Bind(notTaken);
+            masm.SubImm(R12, WORD);
+            return true;
+        }
+
+        case BC_JUMP_ON_NOT_NIL_TOP_TOP:
+        case BC_JUMP_ON_NIL_TOP_TOP:
+            masm.Load(RAX, R12, 0);
+            emitCompareWithRoot(RAX, &nilObject);
+            masm.J(jump == BC_JUMP_ON_NOT_NIL_TOP_TOP ? COND_NOT_EQUAL
+                                                       : COND_EQUAL,
+                   targetLabel);
+            masm.SubImm(R12, WORD);
+            return true;
+
+        case BC_JUMP_IF_GREATER:
+        case BC_JUMP_IF_LESS: {
+            // JUMP_IF_LESS is JUMP_IF_GREATER with swapped operands
+            Label notTaken;
+            masm.Load(jump == BC_JUMP_IF_GREATER ? RDI : RSI, R12, 0);
+            masm.Load(jump == BC_JUMP_IF_GREATER ? RSI : RDI, R12, -WORD);
+            masm.MovImm64(RAX, (uint64_t)&Interpreter::jitIsGreater);
+            masm.Call(RAX);
+            masm.TestAl();
+            masm.J(COND_EQUAL, notTaken);
+            masm.SubImm(R12, 2 * WORD);
+            masm.Jmp(targetLabel);
+            masm.Bind(notTaken);
+            return true;
+        }
+
+        // the loop slots are at the end of the frame, whose size is not
+        // known here, so the loop bytecodes call their interpreter functions
+        case BC_LOOP_START: {
+            masm.Mov(RDI, RBX);
+            masm.Mov(RSI, R12);
+            masm.MovImm32(RDX, method->GetBytecode(bcIdx + 3));
+            masm.MovImm64(RAX, (uint64_t)&Interpreter::jitLoopStart);
+            masm.Call(RAX);
+            masm.SubImm(R12, 3 * WORD);
+            masm.TestAl();
+            masm.J(COND_EQUAL, targetLabel);
+            return true;
+        }
+        case BC_LOOP_NEXT: {
+            masm.Mov(RDI, RBX);
+            masm.MovImm32(RSI, method->GetBytecode(bcIdx + 3));
+            masm.MovImm64(RAX, (uint64_t)&Interpreter::jitLoopNext);
+            masm.Call(RAX);
+            masm.TestAl();
+            masm.J(COND_NOT_EQUAL, targetLabel);
+            return true;
+        }
+
+        default:
+            return false;
+    }
+}
+
+void JitCompiler::emitReload() {
+    masm.MovImm64(RCX, (uint64_t)&Interpreter::frame);
+    masm.Load(RBX, RCX, 0);
+    masm.Load(R12, RBX, FRAME_STACK_PTR);
+}
+
+void JitCompiler::emitHelperCall(JitHelper helper, size_t bcIdx) {
+    masm.Store(RBX, FRAME_STACK_PTR, R12);
+    masm.MovImm32(RDI, (uint32_t)bcIdx);
+    masm.MovImm64(RAX, (uint64_t)helper);
+    masm.Call(RAX);
+
+    // the helper may have changed the stack or the frame, and the GC may
+    // have moved the frame
+    emitReload();
+
+    // continue with the next bytecode, or where the helper says
+    Label next;
+    masm.Test(RAX, RAX);
+    masm.J(COND_EQUAL, next);
+    masm.Jmp(RAX);
+    masm.Bind(next);
+}
+
+void JitCompiler::emitFastPath(uint8_t bytecode, JitFastPath fastPath,
+                               JitHelper helper, size_t bcIdx) {
+    bool const binary = bytecode != BC_INC && bytecode != BC_DEC;
+
+    Label callFastPath;
+    Label slowPath;
+    Label store;
+    Label done;
+
+#if USE_TAGGING
+    if (emitTaggedIntegerFastPath(bytecode, callFastPath)) {
+        masm.Jmp(store);
+    }
+    masm.Bind(callFastPath);
+#endif
+
+    if (binary) {
+        masm.Load(RDI, R12, -WORD);
+        masm.Load(RSI, R12, 0);
+    } else {
+        masm.Load(RDI, R12, 0);
+    }
+    masm.MovImm64(RAX, (uint64_t)fastPath);
+    masm.Call(RAX);
+    masm.Test(RAX, RAX);
+    masm.J(COND_EQUAL, slowPath);
+
+    // like the interpreter, with write barrier, because the frame may be an
+    // old one from the FramePool
+    masm.Bind(store);
+    if (binary) {
+        masm.SubImm(R12, WORD);
+    }
+    masm.Store(R12, 0, RAX);
+    emitWriteBarrier(RBX, R12, 0, RAX);
+    masm.Jmp(done);
+
+    masm.Bind(slowPath);
+    emitHelperCall(helper, bcIdx);
+    masm.Bind(done);
+}
+
+#if USE_TAGGING
+bool JitCompiler::emitTaggedIntegerFastPath(uint8_t bytecode,
+                                            Label& notApplicable) {
+    if (bytecode == BC_INC || bytecode == BC_DEC) {
+        masm.Load(RAX, R12, 0);
+        masm.TestLowByte(RAX, 1);
+        masm.J(COND_EQUAL, notApplicable);
+        masm.AddImm(RAX, bytecode == BC_INC ? 2 : -2);
+        masm.J(COND_OVERFLOW, notApplicable);
+        return true;
+    }
+
+    Condition condition = COND_EQUAL;
+    switch (bytecode) {
+        case BC_ADD:
+        case BC_SUB:
+            break;
+        case BC_LT:
+            condition = COND_LESS;
+            break;
+        case BC_GT:
+            condition = COND_GREATER;
+            break;
+        case BC_LE:
+            condition = COND_LESS_EQUAL;
+            break;
+        case BC_GE:
+            condition = COND_GREATER_EQUAL;
+            break;
+        case BC_EQ:
+        case BC_EQ_EQ:
+            condition = COND_EQUAL;
+            break;
+        default:
+            return false;
+    }
+
+    // both operands need to be tagged integers
+    masm.Load(RAX, R12, -WORD);
+    masm.Load(RCX, R12, 0);
+    masm.Mov(RDX, RAX);
+    masm.And(RDX, RCX);
+    masm.TestLowByte(RDX, 1);
+    masm.J(COND_EQUAL, notApplicable);
+
+    // the tags cancel out, and the tagged range is the full 63 bits, so the
+    // overflow flag is exact
+    if (bytecode == BC_ADD) {
+        masm.SubImm(RCX, 1);
+        masm.Add(RAX, RCX);
+        masm.J(COND_OVERFLOW, notApplicable);
+        return true;
+    }
+    if (bytecode == BC_SUB) {
+        masm.Sub(RAX, RCX);
+        masm.J(COND_OVERFLOW, notApplicable);
+        masm.AddImm(RAX, 1);
+        return true;
+    }
+
+    // tagging keeps the order of integers
+    Label isTrue;
+    Label result;
+    masm.Cmp(RAX, RCX);
+    masm.J(condition, isTrue);
+    emitLoadRoot(RAX, &falseObject);
+    masm.Jmp(result);
+    masm.Bind(isTrue);
+    emitLoadRoot(RAX, &trueObject);
+    masm.Bind(result);
+    return true;
+}
+#endif
+
+void JitCompiler::emitLoadRoot(Register dst, void* root) {
+    masm.MovImm64(dst, (uint64_t)root);
+    masm.Load(dst, dst, 0);
+}
+
+void JitCompiler::emitCompareWithRoot(Register value, void* root) {
+    masm.MovImm64(RCX, (uint64_t)root);
+    masm.Cmp(value, RCX, 0);
+}
+
+Register JitCompiler::emitLoadContext(uint8_t contextLevel) {
+    if (contextLevel == 0) {
+        return RBX;
+    }
+
+    masm.Load(RDX, RBX, FRAME_CONTEXT);
+    for (uint8_t i = 1; i < contextLevel; i += 1) {
+        masm.Load(RDX, RDX, FRAME_CONTEXT);
+    }
+    return RDX;
+}
+
+void JitCompiler::emitPush(Register value) {
+    masm.AddImm(R12, WORD);
+    masm.Store(R12, 0, value);
+    emitWriteBarrier(RBX, R12, 0, value);
+}
+
+void JitCompiler::emitWriteBarrier(Register holder, Register slotBase,
+                                   int32_t slotDisp, Register value) {
+#if GC_TYPE == GENERATIONAL
+    // GenerationalHeap::writeBarrier(), which checks the gcfield that follows
+    // the vtable pointer, and whether the value is in the nursery
+    Label done;
+    auto* const heap = GetHeap<GenerationalHeap>();
+    masm.Load(R10, holder, WORD);
+    masm.TestLowByte(R10, MASK_OBJECT_IS_OLD);
+    masm.J(COND_EQUAL, done);
+    masm.MovImm64(R11, (uint64_t)heap->nursery);
+    masm.Mov(R10, value);
+    masm.Sub(R10, R11);
+    masm.MovImm64(R11, heap->nurserySize);
+    masm.Cmp(R10, R11);
+    masm.J(COND_ABOVE_EQUAL, done);
+
+    // dirty the card of the slot, see GenerationalHeap::CardFor()
+    masm.Mov(R10, slotBase);
+    if (slotDisp != 0) {
+        masm.AddImm(R10, slotDisp);
+    }
+    masm.Sub(R10, holder);
+    masm.ShrImm(R10, CARD_SHIFT);
+    masm.Mov(R11, holder);
+    masm.Sub(R11, R10);
+    masm.StoreByteImm(R11, -1, CARD_DIRTY);
+
+    masm.Load(R10, holder, WORD);
+    masm.TestLowByte(R10, MASK_SEEN_BY_WRITE_BARRIER);
+    masm.J(COND_NOT_EQUAL, done);
+    masm.Mov(RDI, holder);
+    masm.MovImm64(RAX, (uint64_t)&JitCompiler::rememberOldHolder);
+    masm.Call(RAX);
+    masm.Bind(done);
+#else
+    (void)holder;
+    (void)slotBase;
+    (void)slotDisp;
+    (void)value;
+#endif
+}
+
+void JitCompiler::emitPushVariable(int32_t variablesOffset, uint8_t index,
+                                   uint8_t contextLevel) {
+    Register const context = emitLoadContext(contextLevel);
+    masm.Load(RCX, context, variablesOffset);
+    masm.Load(RAX, RCX, index * WORD);
+    emitPush(RAX);
+}
+
+void JitCompiler::emitPopVariable(int32_t variablesOffset, uint8_t index,
+                                  uint8_t contextLevel) {
+    masm.Load(RAX, R12, 0);
+    masm.SubImm(R12, WORD);
+
+    Register const context = emitLoadContext(contextLevel);
+    masm.Load(RCX, context, variablesOffset);
+    masm.Store(RCX, index * WORD, RAX);
+    emitWriteBarrier(context, RCX, index * WORD, RAX);
+}
+
+void JitCompiler::emitLoadSelf() {
+    // self is the receiver of the outer context, which is the frame itself
+    // if there is none
+    Label outer;
+    masm.Load(RDX, RBX, FRAME_OUTER_CONTEXT);
+    masm.Test(RDX, RDX);
+    masm.J(COND_NOT_EQUAL, outer);
+    masm.Mov(RDX, RBX);
+    masm.Bind(outer);
+
+    // integers have no fields, so self is never tagged here
+    masm.Load(RDX, RDX, FRAME_ARGUMENTS);
+    masm.Load(RDX, RDX, 0);
+}
+
+void JitCompiler::emitPushField(uint8_t index) {
+    emitLoadSelf();
+    masm.Load(RAX, RDX, OBJECT_FIELDS + (index * WORD));
+    emitPush(RAX);
+}
+
+void JitCompiler::emitPopField(uint8_t index) {
+    masm.Load(RAX, R12, 0);
+    masm.SubImm(R12, WORD);
+
+    emitLoadSelf();
+    masm.Store(RDX, OBJECT_FIELDS + (index * WORD), RAX);
+    emitWriteBarrier(RDX, RDX, OBJECT_FIELDS + (index * WORD), RAX);
+}
+
+void JitCompiler::emitIncrementField(JitHelper helper, size_t bcIdx,
+                                     uint8_t index, bool push) {
+    Label slowPath;
+    Label done;
+
+    // r13 keeps self across the call of the fast path
+    emitLoadSelf();
+    masm.Mov(R13, RDX);
+    masm.Load(RDI, R13, OBJECT_FIELDS + (index * WORD));
+    masm.MovImm64(RAX, (uint64_t)Interpreter::getJitFastPath(BC_INC));
+    masm.Call(RAX);
+    masm.Test(RAX, RAX);
+    masm.J(COND_EQUAL, slowPath);
+
+    masm.Store(R13, OBJECT_FIELDS + (index * WORD), RAX);
+    if (push) {
+        masm.AddImm(R12, WORD);
+        masm.Store(R12, 0, RAX);
+    }
+    emitWriteBarrier(R13, R13, OBJECT_FIELDS + (index * WORD), RAX);
+    if (push) {
+        masm.Load(RAX, R12, 0);
+        emitWriteBarrier(RBX, R12, 0, RAX);
+    }
+    masm.Jmp(done);
+
+    masm.Bind(slowPath);
+    emitHelperCall(helper, bcIdx);
+    masm.Bind(done);
+}
+
+void JitCompiler::emitPushLiteral(uint8_t index) {
+    masm.Load(RDX, RBX, FRAME_METHOD);
+    masm.Load(RDX, RDX, METHOD_LITERALS);
+    masm.Load(RAX, RDX, index * WORD);
+    emitPush(RAX);
+}
+
+void JitCompiler::emitPushGlobal(size_t bcIdx, uint8_t index) {
+    Label unbound;
+    Label done;
+
+    masm.Load(RDX, RBX, FRAME_METHOD);
+    masm.Load(RDX, RDX, METHOD_LITERALS);
+    masm.Load(RDX, RDX, index * WORD);
+    masm.Load(RAX, RDX, ASSOCIATION_VALUE);
+    masm.Test(RAX, RAX);
+    masm.J(COND_EQUAL, unbound);
+    emitPush(RAX);
+    masm.Jmp(done);
+
+    // the interpreter sends #unknownGlobal:
+    masm.Bind(unbound);
+    emitHelperCall(Interpreter::getJitHelper(BC_PUSH_GLOBAL), bcIdx);
+    masm.Bind(done);
+}
+
+#if GC_TYPE == GENERATIONAL
+void JitCompiler::rememberOldHolder(VMObjectBase* holder) {
+    GetHeap<GenerationalHeap>()->rememberOldHolder(holder);
+}
+#endif
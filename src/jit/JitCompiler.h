@@ -0,0 +1,115 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "../misc/defs.h"
+#include "../vmobjects/ObjectFormats.h"
+#include "Assembler.h"
+
+// the number of invocations and loop iterations after which a method is
+// compiled
+#define JIT_COMPILE_THRESHOLD 1000
+
+class VMObjectBase;
+
+/**
+ * A baseline template JIT for x86-64.
+ *
+ * Each bytecode of a method is translated to a fixed sequence of machine code.
+ * The bytecodes that only move values between the stack, the locals,
+ * arguments, and literals, as well as the jumps, are implemented directly in
+ * machine code. All others call a helper that runs the interpreter's body of
+ * the bytecode, so that frames, sends, returns, and GC safepoints work exactly
+ * as in the interpreter. The arithmetic and comparison bytecodes first call
+ * their fast path, which does not need the interpreter state.
+ *
+ * Compiled code runs on the interpreter's frames, and has an entry point for
+ * every bytecode. When a helper changed the frame or the bytecode index, for
+ * instance for a send or a return, it tells compiled code where to continue:
+ * at an entry point of the compiled code of the new frame's method, or, if it
+ * has none, at the exit back to the interpreter. Thus, calls and returns
+ * between compiled methods do not go through the interpreter, and compiled
+ * code does not use the native stack for them.
+ *
+ * In compiled code, rbx holds the frame, and r12 the frame's stack pointer.
+ */
+class JitCompiler {
+public:
+    /// @return whether the method was compiled
+    static bool Compile(VMMethod* method);
+
+    /// Run compiled code, starting at one of the method's entry points, until
+    /// it needs to return to the interpreter.
+    static inline void Execute(void* entry) { enter(entry); }
+
+    /// @return the code that returns from compiled code to the interpreter
+    static inline void* GetExit() { return exitToInterpreter; }
+
+private:
+    explicit JitCompiler(VMMethod* method);
+
+    bool compile();
+    bool compileBytecode(size_t bcIdx, uint8_t bytecode);
+    bool compileJump(size_t bcIdx, uint8_t bytecode);
+
+    void emitReload();
+    void emitHelperCall(void* (*helper)(size_t), size_t bcIdx);
+    void emitFastPath(uint8_t bytecode,
+                      vm_oop_t (*fastPath)(vm_oop_t, vm_oop_t),
+                      void* (*helper)(size_t), size_t bcIdx);
+#if USE_TAGGING
+    /// Leave the result in rax.
+    /// @return whether there is a fast path for the bytecode
+    bool emitTaggedIntegerFastPath(uint8_t bytecode, Label& notApplicable);
+#endif
+    void emitLoadRoot(Register dst, void* root);
+    void emitCompareWithRoot(Register value, void* root);
+    /// @return the register that holds the frame of the context
+    Register emitLoadContext(uint8_t contextLevel);
+    void emitPush(Register value);
+    /// The barrier for a store of value into [slotBase + slotDisp], which
+    /// is a slot of holder. Clobbers all registers but rbx, r12, and r13.
+    void emitWriteBarrier(Register holder, Register slotBase, int32_t slotDisp,
+                          Register value);
+    void emitPushVariable(int32_t variablesOffset, uint8_t index,
+                          uint8_t contextLevel);
+    void emitPopVariable(int32_t variablesOffset, uint8_t index,
+                         uint8_t contextLevel);
+    void emitPushLiteral(uint8_t index);
+    void emitPushGlobal(size_t bcIdx, uint8_t index);
+
+    /// Load self into rdx.
+    void emitLoadSelf();
+    void emitPushField(uint8_t index);
+    void emitPopField(uint8_t index);
+    void emitIncrementField(void* (*helper)(size_t), size_t bcIdx,
+                            uint8_t index, bool push);
+
+    static bool generateEntryAndExit();
+
+#if GC_TYPE == GENERATIONAL
+    static void rememberOldHolder(VMObjectBase* holder);
+#endif
+
+    static void (*enter)(void* entry);
+    static void* exitToInterpreter;
+
+    // the offsets of the fields compiled code accesses
+    static const int32_t FRAME_CONTEXT;
+    static const int32_t FRAME_OUTER_CONTEXT;
+    static const int32_t FRAME_METHOD;
+    static const int32_t FRAME_ARGUMENTS;
+    static const int32_t FRAME_LOCALS;
+    static const int32_t FRAME_STACK_PTR;
+    static const int32_t METHOD_LITERALS;
+    static const int32_t ASSOCIATION_VALUE;
+
+    VMMethod* const method;
+
+    Assembler masm;
+
+    // the beginning of each bytecode, indexed by bytecode index
+    std::vector<Label> bytecodeLabels;
+};
@@ -16,6 +16,10 @@
 #include "../vmobjects/ObjectFormats.h"
 #include "../vmobjects/VMFrame.h"
 #include "CopyingHeap.h"
+#include "ParallelMarker.h"
+
+CopyingCollector::CopyingCollector(CopyingHeap* h)
+    : GarbageCollector(h), marker(gcThreads) {}
 
 static gc_oop_t copy_if_necessary(gc_oop_t oop) {
     // don't process tagged objects
@@ -49,6 +53,50 @@ static gc_oop_t copy_if_necessary(gc_oop_t oop) {
     return tmp_ptr(newObj);
 }
 
+static gc_oop_t copy_in_parallel(gc_oop_t oop) {
+    // don't process tagged objects
+    if (IS_TAGGED(oop)) {
+        return oop;
+    }
+
+    AbstractVMObject* obj = AS_OBJ(oop);
+    assert(IsValidObject(obj));
+
+    size_t gcField = obj->GetGCField();
+    if (gcField != 0) {
+        return (gc_oop_t)gcField;
+    }
+
+    assert(GetHeap<CopyingHeap>()->IsInOldBufferAndOldBufferIsValid(obj));
+
+    // other workers may clone the object at the same time, and only the
+    // clone that gets installed as forwarding pointer is used. The original
+    // stays intact, because other workers may still be copying it.
+    AbstractVMObject* newObj = obj->CloneForMovingGC();
+
+    assert(GetHeap<CopyingHeap>()->IsInCurrentBuffer(newObj));
+
+    if (!obj->CompareAndSwapGCField(gcField, (size_t)newObj)) {
+        return (gc_oop_t)gcField;
+    }
+
+    // the copies are not contiguous, so their fields are walked by the
+    // marker instead of a Cheney scan
+    ParallelMarker::Push(newObj);
+    return tmp_ptr(newObj);
+}
+
+void CopyingCollector::copyInParallel() {
+    // each worker copies into its own copy buffer
+    heap->collecting = true;
+    marker.Mark(&Universe::WalkGlobals, &copy_in_parallel);
+    heap->collecting = false;
+
+    for (auto& buffer : heap->copyBuffers) {
+        buffer = {};
+    }
+}
+
 void CopyingCollector::Collect() {
     DebugLog("CopyGC Collect\n");
 
@@ -60,15 +108,19 @@ void CopyingCollector::Collect() {
     heap->switchBuffers(increaseMemory);
     increaseMemory = false;
 
-    Universe::WalkGlobals(copy_if_necessary);
-
-    // now copy all objects that are referenced by the objects we have moved so
-    // far
-    auto* curObject = (AbstractVMObject*)(heap->currentBuffer);
-    while (curObject < heap->nextFreePosition) {
-        curObject->WalkObjects(copy_if_necessary);
-        curObject =
-            (AbstractVMObject*)((size_t)curObject + curObject->GetObjectSize());
+    if (gcThreads > 1) {
+        copyInParallel();
+    } else {
+        Universe::WalkGlobals(copy_if_necessary);
+
+        // now copy all objects that are referenced by the objects we have
+        // moved so far
+        auto* curObject = (AbstractVMObject*)(heap->currentBuffer);
+        while (curObject < heap->nextFreePosition) {
+            curObject->WalkObjects(copy_if_necessary);
+            curObject = (AbstractVMObject*)((size_t)curObject +
+                                            curObject->GetObjectSize());
+        }
     }
 
     heap->invalidateOldBuffer();
@@ -1,12 +1,19 @@
 #pragma once
 
 #include "GarbageCollector.h"
+#include "ParallelMarker.h"
 
 class CopyingHeap;
 
 class CopyingCollector : public GarbageCollector<CopyingHeap> {
 public:
-    explicit CopyingCollector(CopyingHeap* h) : GarbageCollector(h) {};
+    explicit CopyingCollector(CopyingHeap* h);
 
     void Collect() override;
+
+private:
+    /// Copy with all GC threads, which do not copy contiguously.
+    void copyInParallel();
+
+    ParallelMarker marker;
 };
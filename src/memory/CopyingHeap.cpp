@@ -3,13 +3,16 @@
 #include <cassert>
 #include <cstdlib>
 #include <cstring>
+#include <mutex>
 #include <string>
 
 #include "../misc/defs.h"  // NOLINT(misc-include-cleaner)
 #include "../vm/Print.h"
+#include "../vm/Universe.h"
 #include "../vmobjects/AbstractObject.h"
 #include "CopyingCollector.h"
 #include "Heap.h"
+#include "ParallelMarker.h"
 
 CopyingHeap::CopyingHeap(size_t objectSpaceSize)
     : Heap<CopyingHeap>(new CopyingCollector(this)),
@@ -19,7 +22,7 @@ CopyingHeap::CopyingHeap(size_t objectSpaceSize)
       collectionLimit((void*)((size_t)currentBuffer +
                               ((size_t)((double)objectSpaceSize * 0.9)))),
       oldBufferEnd((void*)((size_t)oldBuffer + objectSpaceSize)),
-      nextFreePosition(currentBuffer) {
+      nextFreePosition(currentBuffer), copyBuffers(gcThreads) {
     memset(currentBuffer, 0x0, objectSpaceSize);
     memset(oldBuffer, 0x0, objectSpaceSize);
 }
@@ -94,6 +97,10 @@ void CopyingHeap::invalidateOldBuffer() {
 }
 
 AbstractVMObject* CopyingHeap::AllocateObject(size_t size) {
+    if (unlikely(collecting)) {
+        return allocateCopy(size);
+    }
+
     auto* newObject = (AbstractVMObject*)nextFreePosition;
     nextFreePosition = (void*)((size_t)nextFreePosition + size);
     if (nextFreePosition > currentBufferEnd) {
@@ -109,6 +116,43 @@ AbstractVMObject* CopyingHeap::AllocateObject(size_t size) {
     return newObject;
 }
 
+AbstractVMObject* CopyingHeap::allocateCopy(size_t size) {
+    CopyBuffer& buffer = copyBuffers[ParallelMarker::CurrentWorkerId()];
+    if ((size_t)buffer.position + size > (size_t)buffer.end) {
+        // larger objects, and the ones close to the end of the current
+        // buffer, are copied without a copy buffer, so that less memory
+        // remains unused
+        void* memory = size <= COPY_BUFFER_SIZE / 4
+                           ? takeFromCurrentBuffer(COPY_BUFFER_SIZE)
+                           : nullptr;
+        if (memory == nullptr) {
+            memory = takeFromCurrentBuffer(size);
+            if (memory == nullptr) {
+                ErrorPrint("\nFailed to allocate " + to_string(size) +
+                           " Bytes.\n");
+                Quit(-1);
+            }
+            return (AbstractVMObject*)memory;
+        }
+        buffer.position = memory;
+        buffer.end = (void*)((size_t)memory + COPY_BUFFER_SIZE);
+    }
+
+    auto* newObject = (AbstractVMObject*)buffer.position;
+    buffer.position = (void*)((size_t)buffer.position + size);
+    return newObject;
+}
+
+void* CopyingHeap::takeFromCurrentBuffer(size_t size) {
+    std::lock_guard<std::mutex> const lock(copyBufferMutex);
+    if ((size_t)nextFreePosition + size > (size_t)currentBufferEnd) {
+        return nullptr;
+    }
+    void* memory = nextFreePosition;
+    nextFreePosition = (void*)((size_t)nextFreePosition + size);
+    return memory;
+}
+
 bool CopyingHeap::IsInCurrentBuffer(AbstractVMObject* obj) {
     if (obj == nullptr) {
         return true;
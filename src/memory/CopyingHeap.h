@@ -1,9 +1,15 @@
 #pragma once
 
 #include <cstring>
+#include <mutex>
+#include <vector>
 
 #include "Heap.h"
 
+// during a collection, each GC worker copies into its own buffer, which it
+// takes from the current buffer
+#define COPY_BUFFER_SIZE 8192U
+
 class CopyingHeap : public Heap<CopyingHeap> {
     friend class CopyingCollector;
 
@@ -18,6 +24,11 @@ private:
     void switchBuffers(bool increaseMemory);
     void invalidateOldBuffer();
 
+    AbstractVMObject* allocateCopy(size_t size);
+
+    /// Returns nullptr if the current buffer does not have enough space.
+    void* takeFromCurrentBuffer(size_t size);
+
     void* currentBuffer;
     void* collectionLimit;
     void* currentBufferEnd;
@@ -27,4 +38,14 @@ private:
 
     void* nextFreePosition;
     bool oldBufferIsValid{false};
+
+    // the copy buffers of different workers do not share a cache line
+    struct alignas(64) CopyBuffer {
+        void* position{nullptr};
+        void* end{nullptr};
+    };
+
+    bool collecting{false};
+    std::vector<CopyBuffer> copyBuffers;
+    std::mutex copyBufferMutex;
 };
@@ -1,7 +1,9 @@
 #include "GenerationalCollector.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cstddef>
+#include <cstdint>
 #include <vector>
 
 #include "../misc/debug.h"
@@ -11,11 +13,13 @@
 #include "../vmobjects/IntegerBox.h"
 #include "../vmobjects/ObjectFormats.h"
 #include "../vmobjects/VMFrame.h"
+#include "../vmobjects/VMObject.h"
 #include "../vmobjects/VMObjectBase.h"
 #include "GarbageCollector.h"
+#include "GenerationalHeap.h"
 
 GenerationalCollector::GenerationalCollector(GenerationalHeap* heap)
-    : GarbageCollector(heap) {}
+    : GarbageCollector(heap), marker(gcThreads) {}
 
 static gc_oop_t mark_object(gc_oop_t oop) {
     // don't process tagged objects
@@ -24,14 +28,36 @@ static gc_oop_t mark_object(gc_oop_t oop) {
     }
 
     AbstractVMObject* obj = AS_OBJ(oop);
+
+    // the object was evacuated already, the GC field is the forwarding
+    // pointer
+    size_t gcField = obj->GetGCField();
+    if (gcField > MASK_BITS_ALL) {
+        return (gc_oop_t)gcField;
+    }
     assert(IsValidObject(obj));
 
-    if ((obj->GetGCField() & MASK_OBJECT_IS_MARKED) != 0) {
+    auto* const heap = GetHeap<GenerationalHeap>();
+    if (heap->ShouldEvacuate(obj)) {
+        // the clone is allocated in a free block of the mature space. Other
+        // workers may clone the object at the same time, and only the clone
+        // that gets installed as forwarding pointer is used. The original
+        // stays intact, because other workers may still be copying it.
+        AbstractVMObject* newObj = obj->CloneForMovingGC();
+        if (!obj->CompareAndSwapGCField(gcField, (size_t)newObj)) {
+            return (gc_oop_t)gcField;
+        }
+        obj = newObj;
+        oop = tmp_ptr(newObj);
+    }
+
+    if (!heap->MarkMatureObject(obj)) {
         return oop;
     }
 
-    obj->SetGCField(MASK_OBJECT_IS_OLD | MASK_OBJECT_IS_MARKED);
-    obj->WalkObjects(&mark_object);
+    // the fields are walked by the marker, instead of recursively
+    obj->SetGCField(MASK_OBJECT_IS_OLD);
+    ParallelMarker::Push(obj);
 
     return oop;
 }
@@ -45,7 +71,7 @@ static gc_oop_t copy_if_necessary(gc_oop_t oop) {
     AbstractVMObject* obj = AS_OBJ(oop);
     assert(IsValidObject(obj));
 
-    size_t const gcField = obj->GetGCField();
+    size_t gcField = obj->GetGCField();
 
     // if this is an old object already, we don't have to copy
     if ((gcField & MASK_OBJECT_IS_OLD) != 0) {
@@ -58,64 +84,89 @@ static gc_oop_t copy_if_necessary(gc_oop_t oop) {
         return (gc_oop_t)gcField;
     }
 
-    // we have to clone ourselves
+    // we have to clone ourselves. Other workers may clone the object at the
+    // same time, and only the clone that gets installed as forwarding
+    // pointer is used, the others are left as garbage in the mature space.
+    // The original stays intact, because other workers may still be
+    // copying it.
     AbstractVMObject* newObj = obj->CloneForMovingGC();
 
-    if (DEBUG) {
-        obj->MarkObjectAsInvalid();
-    }
-
     assert((((size_t)newObj) & MASK_OBJECT_IS_MARKED) == 0);
     assert(obj->GetObjectSize() == newObj->GetObjectSize());
 
-    obj->SetGCField((size_t)newObj);
+    if (!obj->CompareAndSwapGCField(gcField, (size_t)newObj)) {
+        return (gc_oop_t)gcField;
+    }
     newObj->SetGCField(MASK_OBJECT_IS_OLD);
 
-    // walk recursively
-    newObj->WalkObjects(copy_if_necessary);
+    // the fields are walked by the marker, instead of recursively
+    ParallelMarker::Push(newObj);
 
     return tmp_ptr(newObj);
 }
 
-void GenerationalCollector::MinorCollection() {
-    DebugLog("GenGC MinorCollection\n");
+/// Walk the dirty cards of an old object, and clean them.
+static void walkDirtyCards(AbstractVMObject* obj, walk_heap_fn walk) {
+    size_t const numberOfCards =
+        GenerationalHeap::NumberOfCards(obj->GetObjectSize());
+    uint8_t* const cards = GenerationalHeap::CardFor(obj, obj);
+
+    // the card table is stored backwards from the object, and consecutive
+    // dirty cards are walked together
+    size_t i = 0;
+    while (i < numberOfCards) {
+        if (*(cards - i) == CARD_CLEAN) {
+            i += 1;
+            continue;
+        }
+
+        size_t const first = i;
+        while (i < numberOfCards && *(cards - i) == CARD_DIRTY) {
+            *(cards - i) = CARD_CLEAN;
+            i += 1;
+        }
+        obj->WalkObjectsInRange(walk, SHIFTED_PTR(obj, first * CARD_SIZE),
+                                SHIFTED_PTR(obj, i * CARD_SIZE));
+    }
+}
 
+void GenerationalCollector::walkMinorRoots(walk_heap_fn walk) {
     // walk all globals of universe, and implicily the interpreter
-    Universe::WalkGlobals(&copy_if_necessary);
+    Universe::WalkGlobals(walk);
 
     // and also all objects that have been detected by the write barriers
+    auto* const heap = GetHeap<GenerationalHeap>();
     for (size_t const& oldObj : heap->oldObjsWithRefToYoungObjs) {
         // content of oldObjsWithRefToYoungObjs is not altered while iteration,
         // because copy_if_necessary returns old objs only -> ignored by
         // write_barrier
         auto* obj = (AbstractVMObject*)oldObj;
         obj->SetGCField(MASK_OBJECT_IS_OLD);
-        obj->WalkObjects(&copy_if_necessary);
+        walkDirtyCards(obj, walk);
     }
     heap->oldObjsWithRefToYoungObjs.clear();
+}
+
+void GenerationalCollector::MinorCollection() {
+    DebugLog("GenGC MinorCollection\n");
+
+    // the survivors are promoted, and their fields are walked by all workers
+    marker.Mark(&walkMinorRoots, &copy_if_necessary);
     heap->nextFreePosition = heap->nursery;
 }
 
 void GenerationalCollector::MajorCollection() {
     DebugLog("GenGC MajorCollection\n");
 
-    // first we have to mark all objects (globals and current frame recursively)
-    Universe::WalkGlobals(&mark_object);
+    heap->matureSpace.StartCollection();
 
-    // now that all objects are marked we can safely delete all allocated
-    // objects that are not marked
-    vector<AbstractVMObject*> survivors;
-    for (auto* obj : heap->allocatedObjects) {
-        assert(IsValidObject(obj));
+    // first we have to mark all objects (globals and current frame
+    // transitively), which also evacuates the objects of sparse blocks
+    marker.Mark(&Universe::WalkGlobals, &mark_object);
 
-        if ((obj->GetGCField() & MASK_OBJECT_IS_MARKED) != 0) {
-            survivors.push_back(obj);
-            obj->SetGCField(MASK_OBJECT_IS_OLD);
-        } else {
-            heap->FreeObject(obj);
-        }
-    }
-    heap->allocatedObjects.swap(survivors);
+    // now that all objects are marked, the lines and blocks without marked
+    // objects can be reused
+    heap->matureSpace.Sweep();
 }
 
 void GenerationalCollector::Collect() {
@@ -125,9 +176,11 @@ void GenerationalCollector::Collect() {
     heap->resetGCTrigger();
 
     MinorCollection();
-    if (heap->matureObjectsSize > majorCollectionThreshold) {
+    if (heap->matureSpace.GetSize() > majorCollectionThreshold) {
         MajorCollection();
-        majorCollectionThreshold = 2 * heap->matureObjectsSize;
+        majorCollectionThreshold =
+            std::max((uintptr_t)(2 * heap->matureSpace.GetSize()),
+                     majorCollectionThreshold);
     }
     Timer::GCTimer.Halt();
 }
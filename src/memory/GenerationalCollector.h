@@ -2,6 +2,7 @@
 
 #include "../misc/defs.h"
 #include "GarbageCollector.h"
+#include "ParallelMarker.h"
 
 class GenerationalHeap;
 class GenerationalCollector : public GarbageCollector<GenerationalHeap> {
@@ -14,4 +15,10 @@ private:
     size_t matureObjectsSize{0};
     void MajorCollection();
     void MinorCollection();
+
+    /// The roots of a minor collection, which include the dirty cards of the
+    /// old objects remembered by the write barrier.
+    static void walkMinorRoots(walk_heap_fn walk);
+
+    ParallelMarker marker;
 };
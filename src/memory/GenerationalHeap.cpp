@@ -6,11 +6,13 @@
 #include <vector>
 
 #include "../vm/Print.h"
+#include "../vm/Universe.h"
 #include "../vmobjects/AbstractObject.h"
 #include "../vmobjects/ObjectFormats.h"
 #include "../vmobjects/VMObjectBase.h"
 #include "GenerationalCollector.h"
 #include "Heap.h"
+#include "ParallelMarker.h"
 
 using namespace std;
 
@@ -23,7 +25,8 @@ GenerationalHeap::GenerationalHeap(size_t objectSpaceSize)
 
       // our initial collection limit is 90% of objectSpaceSize
       collectionLimit((void*)((size_t)nursery +
-                              ((size_t)((double)objectSpaceSize * 0.9)))) {
+                              ((size_t)((double)objectSpaceSize * 0.9)))),
+      matureSpace(gcThreads) {
     memset(nursery, 0x0, objectSpaceSize);
 }
 
@@ -43,20 +46,42 @@ AbstractVMObject* GenerationalHeap::AllocateNurseryObject(size_t size) {
 }
 
 AbstractVMObject* GenerationalHeap::AllocateMatureObject(size_t size) {
-    auto* newObject = (AbstractVMObject*)malloc(size);
-    if (newObject == nullptr) {
-        ErrorPrint("\nFailed to allocate " + to_string(size) + " Bytes.\n");
-        Quit(-1);
-    }
-    allocatedObjects.push_back(newObject);
-    matureObjectsSize += size;
-    return newObject;
+    size_t const cardTableSize = PADDED_SIZE(NumberOfCards(size));
+    // the GC workers promote and evacuate objects with their own allocators
+    void* memory = matureSpace.Allocate(cardTableSize + size,
+                                        ParallelMarker::CurrentWorkerId());
+    memset(memory, CARD_CLEAN, cardTableSize);
+    return (AbstractVMObject*)((size_t)memory + cardTableSize);
+}
+
+bool GenerationalHeap::MarkMatureObject(AbstractVMObject* obj) {
+    size_t const size = obj->GetObjectSize();
+    size_t const cardTableSize = PADDED_SIZE(NumberOfCards(size));
+    return matureSpace.Mark((void*)((size_t)obj - cardTableSize),
+                            cardTableSize + size);
+}
+
+bool GenerationalHeap::ShouldEvacuate(AbstractVMObject* obj) const {
+    size_t const size = obj->GetObjectSize();
+    size_t const cardTableSize = PADDED_SIZE(NumberOfCards(size));
+    return matureSpace.ShouldEvacuate((void*)((size_t)obj - cardTableSize),
+                                      cardTableSize + size);
+}
+
+void GenerationalHeap::rememberOldHolder(VMObjectBase* holder) {
+    oldObjsWithRefToYoungObjs.push_back((size_t)holder);
+    holder->SetGCField(holder->GetGCField() | MASK_SEEN_BY_WRITE_BARRIER);
 }
 
-void GenerationalHeap::writeBarrier_OldHolder(VMObjectBase* holder,
-                                              vm_oop_t referencedObject) {
+void GenerationalHeap::dirtyAllCards(VMObjectBase* holder,
+                                     vm_oop_t referencedObject) {
     if (isObjectInNursery(referencedObject)) {
-        oldObjsWithRefToYoungObjs.push_back((size_t)holder);
-        holder->SetGCField(holder->GetGCField() | MASK_SEEN_BY_WRITE_BARRIER);
+        size_t const numberOfCards = NumberOfCards(
+            static_cast<AbstractVMObject*>(holder)->GetObjectSize());
+        memset(CardFor(holder, holder) - (numberOfCards - 1), CARD_DIRTY,
+               numberOfCards);
+        if ((holder->GetGCField() & MASK_SEEN_BY_WRITE_BARRIER) == 0) {
+            rememberOldHolder(holder);
+        }
     }
 }
@@ -1,11 +1,13 @@
 #pragma once
 
 #include <cassert>
+#include <cstdint>
 
 #include "../misc/defs.h"
 #include "../vm/IsValidObject.h"
 #include "../vmobjects/VMObjectBase.h"
 #include "Heap.h"
+#include "MatureSpace.h"
 
 #ifdef UNITTESTS
 struct VMObjectCompare {
@@ -17,16 +19,59 @@ struct VMObjectCompare {
 };
 #endif
 
+// the mature space is divided into cards of 512 bytes, and the write barrier
+// dirties the card of the slot that gets a reference into the nursery
+#define CARD_SHIFT 9U
+#define CARD_SIZE (1U << CARD_SHIFT)
+#define CARD_CLEAN 0
+#define CARD_DIRTY 1
+
+/**
+ * Each mature object is preceded by the card table for the memory it
+ * occupies, with one byte per card. The table is stored backwards from the
+ * start of the object, so that the write barrier finds the card of a slot
+ * without knowing the size of the object. A minor collection then only scans
+ * the dirty cards of the old objects the write barrier remembered.
+ *
+ * The card table and the object are allocated together in the mature space.
+ */
 class GenerationalHeap : public Heap<GenerationalHeap> {
     friend class GenerationalCollector;
+    friend class JitCompiler;
 
 public:
     explicit GenerationalHeap(size_t objectSpaceSize = 1048576);
     AbstractVMObject* AllocateNurseryObject(size_t size);
     AbstractVMObject* AllocateMatureObject(size_t size);
+
+    /// Mark the allocation of a mature object during a major collection,
+    /// returns false if it was marked already.
+    bool MarkMatureObject(AbstractVMObject* obj);
+
+    /// Whether the mature object is in a block that gets evacuated.
+    [[nodiscard]] bool ShouldEvacuate(AbstractVMObject* obj) const;
+
     [[nodiscard]] size_t GetMaxNurseryObjectSize() const;
+
+    /// The barrier for a store into the given slot of the holder.
+    void writeBarrier(VMObjectBase* holder, void* slot,
+                      vm_oop_t referencedObject);
+
+    /// The barrier for stores that are not into a slot of the holder, for
+    /// instance into its inline caches. It dirties all cards of the holder.
     void writeBarrier(VMObjectBase* holder, vm_oop_t referencedObject);
+
     inline bool isObjectInNursery(vm_oop_t obj);
+
+    [[nodiscard]] static inline uint8_t* CardFor(VMObjectBase* holder,
+                                                 void* slot) {
+        return (uint8_t*)((size_t)holder - 1 -
+                          (((size_t)slot - (size_t)holder) >> CARD_SHIFT));
+    }
+
+    [[nodiscard]] static inline size_t NumberOfCards(size_t objectSize) {
+        return (objectSize + CARD_SIZE - 1) >> CARD_SHIFT;
+    }
 #ifdef UNITTESTS
     std::set<pair<vm_oop_t, vm_oop_t>, VMObjectCompare> writeBarrierCalledOn;
 #endif
@@ -35,13 +80,12 @@ private:
     size_t nursery_end;
     size_t nurserySize;
     size_t maxNurseryObjSize;
-    size_t matureObjectsSize{0};
     void* nextFreePosition;
-    void writeBarrier_OldHolder(VMObjectBase* holder,
-                                vm_oop_t referencedObject);
+    void rememberOldHolder(VMObjectBase* holder);
+    void dirtyAllCards(VMObjectBase* holder, vm_oop_t referencedObject);
     void* collectionLimit;
     vector<size_t> oldObjsWithRefToYoungObjs;
-    vector<AbstractVMObject*> allocatedObjects;
+    MatureSpace matureSpace;
 };
 
 inline bool GenerationalHeap::isObjectInNursery(vm_oop_t obj) {
@@ -54,6 +98,25 @@ inline size_t GenerationalHeap::GetMaxNurseryObjectSize() const {
     return maxNurseryObjSize;
 }
 
+inline void GenerationalHeap::writeBarrier(VMObjectBase* holder, void* slot,
+                                           vm_oop_t referencedObject) {
+#ifdef UNITTESTS
+    writeBarrierCalledOn.insert(make_pair(holder, referencedObject));
+#endif
+
+    assert(IsValidObject(referencedObject));
+    assert(IsValidObject(holder));
+
+    const size_t gcfield = *(((size_t*)holder) + 1);
+    if ((gcfield & MASK_OBJECT_IS_OLD) != 0 &&
+        isObjectInNursery(referencedObject)) {
+        *CardFor(holder, slot) = CARD_DIRTY;
+        if ((gcfield & MASK_SEEN_BY_WRITE_BARRIER) == 0) {
+            rememberOldHolder(holder);
+        }
+    }
+}
+
 inline void GenerationalHeap::writeBarrier(VMObjectBase* holder,
                                            vm_oop_t referencedObject) {
 #ifdef UNITTESTS
@@ -64,8 +127,7 @@ inline void GenerationalHeap::writeBarrier(VMObjectBase* holder,
     assert(IsValidObject(holder));
 
     const size_t gcfield = *(((size_t*)holder) + 1);
-    if ((gcfield & 6U /* MASK_OBJECT_IS_OLD + MASK_SEEN_BY_WRITE_BARRIER */) ==
-        2U /* MASK_OBJECT_IS_OLD */) {
-        writeBarrier_OldHolder(holder, referencedObject);
+    if ((gcfield & MASK_OBJECT_IS_OLD) != 0) {
+        dirtyAllCards(holder, referencedObject);
     }
 }
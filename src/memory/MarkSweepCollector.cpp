@@ -1,7 +1,9 @@
 #include "MarkSweepCollector.h"
 
 #include <cstddef>
-#include <vector>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
 
 #include "../memory/Heap.h"
 #include "../misc/debug.h"
@@ -10,9 +12,36 @@
 #include "../vmobjects/IntegerBox.h"
 #include "../vmobjects/ObjectFormats.h"
 #include "../vmobjects/VMFrame.h"
+#include "../vmobjects/VMObject.h"
 #include "MarkSweepHeap.h"
 
-#define GC_MARKED 3456
+MarkSweepCollector::MarkSweepCollector(MarkSweepHeap* heap)
+    : GarbageCollector(heap), marker(gcThreads) {}
+
+/// Mark the object, and count it as live. Returns false if it was marked
+/// already. Other GC workers may mark at the same time.
+static bool mark(AbstractVMObject* obj) {
+    if (obj->GetObjectSize() > MAX_SMALL_OBJECT_SIZE) {
+        LargeCell* large = (LargeCell*)obj - 1;
+        if (__atomic_exchange_n(&large->marked, true, __ATOMIC_RELAXED)) {
+            return false;
+        }
+        ParallelMarker::CountLive(large->size);
+        return true;
+    }
+
+    auto* chunk = (Chunk*)((size_t)obj & ~((size_t)CHUNK_SIZE - 1));
+    size_t const word = ((size_t)obj - (size_t)chunk) / sizeof(void*);
+    uint64_t const bit = (uint64_t)1U << (word % 64);
+    if ((__atomic_fetch_or(&chunk->markBits[word / 64], bit,
+                           __ATOMIC_RELAXED) &
+         bit) != 0) {
+        return false;
+    }
+    __atomic_fetch_add(&chunk->liveCells, 1, __ATOMIC_RELAXED);
+    ParallelMarker::CountLive(chunk->cellSize);
+    return true;
+}
 
 void MarkSweepCollector::Collect() {
     DebugLog("MarkSweep Collect\n");
@@ -22,35 +51,76 @@ void MarkSweepCollector::Collect() {
     // reset collection trigger
     heap->resetGCTrigger();
 
-    // now mark all reachables
+    // the chunks the allocator did not reach since the last collection still
+    // have their mark bits, they are swept after this collection instead
+    for (size_t i = 0; i < heap->numberOfSizeClasses; i += 1) {
+        for (Chunk* chunk = heap->sizeClasses[i].chunks; chunk != nullptr;
+             chunk = chunk->next) {
+            if (!chunk->swept) {
+                memset(chunk->markBits, 0, sizeof(chunk->markBits));
+            }
+            chunk->liveCells = 0;
+        }
+    }
+
+    // now mark all reachables, which also counts the live bytes
     markReachableObjects();
+    heap->spcAlloc = marker.GetLiveBytes();
 
-    // in this survivors stack we will remember all objects that survived
-    auto* survivors = new vector<AbstractVMObject*>();
-    size_t survivorsSize = 0;
-
-    vector<AbstractVMObject*>::iterator iter;
-    for (iter = heap->allocatedObjects->begin();
-         iter != heap->allocatedObjects->end();
-         iter++) {
-        if ((*iter)->GetGCField() == GC_MARKED) {
-            // object ist marked -> let it survive
-            survivors->push_back(*iter);
-            survivorsSize += (*iter)->GetObjectSize();
-            (*iter)->SetGCField(0);
+    // the chunks without live cells can be reused by any size class right
+    // away, all others are swept lazily when allocation gets to them
+    Chunk* emptyChunks = nullptr;
+    size_t usedChunks = 0;
+    for (size_t i = 0; i < heap->numberOfSizeClasses; i += 1) {
+        SizeClass& sizeClass = heap->sizeClasses[i];
+        Chunk** link = &sizeClass.chunks;
+        sizeClass.lastChunk = nullptr;
+        while (*link != nullptr) {
+            Chunk* chunk = *link;
+            if (chunk->liveCells == 0) {
+                *link = chunk->next;
+                chunk->next = emptyChunks;
+                emptyChunks = chunk;
+            } else {
+                usedChunks += 1;
+                chunk->swept = false;
+                sizeClass.lastChunk = chunk;
+                link = &chunk->next;
+            }
+        }
+        sizeClass.currentChunk = nullptr;
+        sizeClass.freeList = nullptr;
+    }
+
+    // keep as many empty chunks as there are used ones, and give the rest
+    // back to the system
+    while (emptyChunks != nullptr) {
+        Chunk* chunk = emptyChunks;
+        emptyChunks = chunk->next;
+        if (heap->numberOfFreeChunks < usedChunks) {
+            chunk->next = heap->freeChunks;
+            heap->freeChunks = chunk;
+            heap->numberOfFreeChunks += 1;
         } else {
-            // not marked -> kill it
-            heap->FreeObject(*iter);
+            free(chunk);
         }
     }
 
-    delete heap->allocatedObjects;
-    heap->allocatedObjects = survivors;
+    LargeCell** link = &heap->largeObjects;
+    while (*link != nullptr) {
+        LargeCell* large = *link;
+        if (large->marked) {
+            large->marked = false;
+            link = &large->next;
+        } else {
+            *link = large->next;
+            free(large);
+        }
+    }
 
-    heap->spcAlloc = survivorsSize;
     // TODO(smarr): Maybe choose another constant to calculate new
     // collectionLimit here
-    heap->collectionLimit = 2 * survivorsSize;
+    heap->collectionLimit = 2 * heap->spcAlloc;
     Timer::GCTimer.Halt();
 }
 
@@ -60,17 +130,14 @@ static gc_oop_t mark_object(gc_oop_t oop) {
     }
 
     AbstractVMObject* obj = AS_OBJ(oop);
-
-    if (obj->GetGCField() != 0) {
-        return oop;
+    if (mark(obj)) {
+        // the fields are walked by the marker, instead of recursively
+        ParallelMarker::Push(obj);
     }
-
-    obj->SetGCField(GC_MARKED);
-    obj->WalkObjects(mark_object);
     return oop;
 }
 
 void MarkSweepCollector::markReachableObjects() {
     // This walks the globals of the universe, and the interpreter
-    Universe::WalkGlobals(mark_object);
+    marker.Mark(&Universe::WalkGlobals, mark_object);
 }
@@ -2,13 +2,16 @@
 
 #include "../misc/defs.h"
 #include "GarbageCollector.h"
+#include "ParallelMarker.h"
 
 class MarkSweepHeap;
 class MarkSweepCollector : public GarbageCollector<MarkSweepHeap> {
 public:
-    explicit MarkSweepCollector(MarkSweepHeap* heap) : GarbageCollector(heap) {}
+    explicit MarkSweepCollector(MarkSweepHeap* heap);
     void Collect() override;
 
 private:
-    static void markReachableObjects();
+    void markReachableObjects();
+
+    ParallelMarker marker;
 };
@@ -1,35 +1,155 @@
 #include "MarkSweepHeap.h"
 
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
 #include <cstdlib>
 #include <cstring>
 #include <string>
-#include <vector>
 
 #include "../memory/Heap.h"
 #include "../vm/Print.h"
 #include "../vmobjects/AbstractObject.h"
+#include "../vmobjects/VMObject.h"
 #include "MarkSweepCollector.h"
 
 MarkSweepHeap::MarkSweepHeap(size_t objectSpaceSize)
     : Heap<MarkSweepHeap>(new MarkSweepCollector(this)),
-      allocatedObjects(new vector<AbstractVMObject*>()),
       // our initial collection limit is 90% of objectSpaceSize
-      collectionLimit((size_t)((double)objectSpaceSize * 0.9)) {}
+      collectionLimit((size_t)((double)objectSpaceSize * 0.9)) {
+    size_t cellSize = 2 * sizeof(void*);
+    size_t words = 0;
+    while (cellSize <= MAX_SMALL_OBJECT_SIZE) {
+        sizeClasses[numberOfSizeClasses].cellSize = cellSize;
+        for (; words * sizeof(void*) <= cellSize; words += 1) {
+            sizeClassIndex[words] = (uint8_t)numberOfSizeClasses;
+        }
+        numberOfSizeClasses += 1;
+
+        size_t powerOfTwo = cellSize;
+        while ((powerOfTwo & (powerOfTwo - 1)) != 0) {
+            powerOfTwo &= powerOfTwo - 1;
+        }
+        cellSize += max(sizeof(void*), powerOfTwo / 4);
+    }
+    assert(numberOfSizeClasses <= sizeof(sizeClasses) / sizeof(SizeClass));
+}
 
 AbstractVMObject* MarkSweepHeap::AllocateObject(size_t size) {
-    auto* newObject = (AbstractVMObject*)malloc(size);
-    if (newObject == nullptr) {
-        ErrorPrint("\nFailed to allocate " + to_string(size) + " Bytes.\n");
-        Quit(-1);
+    void* newObject = nullptr;
+    if (size > MAX_SMALL_OBJECT_SIZE) {
+        newObject = allocateLarge(size);
+    } else {
+        SizeClass& sizeClass =
+            sizeClasses[sizeClassIndex[size / sizeof(void*)]];
+        FreeCell* cell = sizeClass.freeList;
+        if (cell == nullptr) {
+            cell = refill(sizeClass);
+        }
+        sizeClass.freeList = cell->next;
+        spcAlloc += sizeClass.cellSize;
+        newObject = cell;
     }
-    spcAlloc += size;
-    memset((void*)newObject, 0, size);
-    // AbstractObjects (Integer,...) have no Size field anymore -> set within
-    // VMObject's new operator
-    allocatedObjects->push_back(newObject);
+
     // let's see if we have to trigger the GC
     if (spcAlloc >= collectionLimit) {
         requestGC();
     }
-    return newObject;
+    return (AbstractVMObject*)newObject;
+}
+
+FreeCell* MarkSweepHeap::refill(SizeClass& sizeClass) {
+    // take the free list of the next chunk that has free cells
+    Chunk* chunk = sizeClass.currentChunk == nullptr
+                       ? sizeClass.chunks
+                       : sizeClass.currentChunk->next;
+    while (chunk != nullptr) {
+        sizeClass.currentChunk = chunk;
+        if (!chunk->swept) {
+            sweepChunk(chunk);
+        }
+        if (chunk->freeList != nullptr) {
+            FreeCell* cell = chunk->freeList;
+            chunk->freeList = nullptr;
+            return cell;
+        }
+        chunk = chunk->next;
+    }
+
+    // all chunks are full, carve an empty one into cells
+    if (freeChunks != nullptr) {
+        chunk = freeChunks;
+        freeChunks = chunk->next;
+        numberOfFreeChunks -= 1;
+    } else {
+        chunk = (Chunk*)aligned_alloc(CHUNK_SIZE, CHUNK_SIZE);
+        if (chunk == nullptr) {
+            ErrorPrint("\nFailed to allocate a chunk of " +
+                       to_string(sizeClass.cellSize) + " Byte cells.\n");
+            Quit(-1);
+        }
+    }
+    memset(chunk->markBits, 0, sizeof(chunk->markBits));
+    chunk->next = nullptr;
+    chunk->freeList = nullptr;
+    chunk->cellSize = sizeClass.cellSize;
+    chunk->liveCells = 0;
+    chunk->swept = true;
+
+    if (sizeClass.lastChunk == nullptr) {
+        sizeClass.chunks = chunk;
+    } else {
+        sizeClass.lastChunk->next = chunk;
+    }
+    sizeClass.lastChunk = chunk;
+    sizeClass.currentChunk = chunk;
+
+    size_t const numberOfCells =
+        (CHUNK_SIZE - CHUNK_HEADER_SIZE) / sizeClass.cellSize;
+    auto* const first = (FreeCell*)SHIFTED_PTR(chunk, CHUNK_HEADER_SIZE);
+    FreeCell* cell = first;
+    for (size_t i = 1; i < numberOfCells; i += 1) {
+        auto* const next = (FreeCell*)SHIFTED_PTR(cell, sizeClass.cellSize);
+        cell->next = next;
+        cell = next;
+    }
+    cell->next = nullptr;
+    return first;
+}
+
+void MarkSweepHeap::sweepChunk(Chunk* chunk) {
+    size_t const cellSize = chunk->cellSize;
+    size_t const numberOfCells = (CHUNK_SIZE - CHUNK_HEADER_SIZE) / cellSize;
+
+    // rebuild the free list from the unmarked cells
+    FreeCell** tail = &chunk->freeList;
+    size_t offset = CHUNK_HEADER_SIZE;
+    for (size_t i = 0; i < numberOfCells; i += 1, offset += cellSize) {
+        size_t const word = offset / sizeof(void*);
+        uint64_t const bit = (uint64_t)1U << (word % 64);
+        if ((chunk->markBits[word / 64] & bit) == 0) {
+            auto* cell = (FreeCell*)SHIFTED_PTR(chunk, offset);
+            *tail = cell;
+            tail = &cell->next;
+        }
+    }
+    *tail = nullptr;
+
+    memset(chunk->markBits, 0, sizeof(chunk->markBits));
+    chunk->swept = true;
+}
+
+void* MarkSweepHeap::allocateLarge(size_t size) {
+    auto* large = (LargeCell*)malloc(sizeof(LargeCell) + size);
+    if (large == nullptr) {
+        ErrorPrint("\nFailed to allocate " + to_string(size) + " Bytes.\n");
+        Quit(-1);
+    }
+    large->size = sizeof(LargeCell) + size;
+    large->marked = false;
+    large->next = largeObjects;
+    largeObjects = large;
+
+    spcAlloc += large->size;
+    return (void*)(large + 1);
 }
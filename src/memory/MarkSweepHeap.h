@@ -1,8 +1,51 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+
 #include "../misc/defs.h"
 #include "Heap.h"
 
+// small objects are allocated from chunks of 64 KB, which are divided into
+// cells of a single size class
+#define CHUNK_SHIFT 16U
+#define CHUNK_SIZE (1U << CHUNK_SHIFT)
+#define MAX_SMALL_OBJECT_SIZE 2048U
+
+struct FreeCell {
+    FreeCell* next;
+};
+
+/// The header at the start of each chunk. The mark bits, one per word, are
+/// kept on the side, so that the objects are only visited for marking. After
+/// a collection, a chunk is only swept when allocation gets to it.
+struct Chunk {
+    Chunk* next;
+    FreeCell* freeList;
+    size_t cellSize;
+    size_t liveCells;
+    bool swept;
+    uint64_t markBits[CHUNK_SIZE / sizeof(void*) / 64];
+};
+
+#define CHUNK_HEADER_SIZE PADDED_SIZE(sizeof(Chunk))
+
+/// The chunks of one size class, and the free list allocation takes from.
+struct SizeClass {
+    size_t cellSize;
+    Chunk* chunks;
+    Chunk* lastChunk;
+    Chunk* currentChunk;
+    FreeCell* freeList;
+};
+
+/// The header of an object that is too large for the chunks.
+struct LargeCell {
+    LargeCell* next;
+    size_t size;
+    bool marked;
+};
+
 class MarkSweepHeap : public Heap<MarkSweepHeap> {
     friend class MarkSweepCollector;
 
@@ -11,7 +54,21 @@ public:
     AbstractVMObject* AllocateObject(size_t size);
 
 private:
-    vector<AbstractVMObject*>* allocatedObjects;
+    FreeCell* refill(SizeClass& sizeClass);
+    static void sweepChunk(Chunk* chunk);
+    void* allocateLarge(size_t size);
+
+    // the size classes grow by a quarter of the power of two below them, and
+    // objects are mapped to them by their size in words
+    SizeClass sizeClasses[64]{};
+    size_t numberOfSizeClasses{0};
+    uint8_t sizeClassIndex[(MAX_SMALL_OBJECT_SIZE / sizeof(void*)) + 1]{};
+
+    // empty chunks are shared by all size classes
+    Chunk* freeChunks{nullptr};
+    size_t numberOfFreeChunks{0};
+
+    LargeCell* largeObjects{nullptr};
     size_t spcAlloc{0};
     size_t collectionLimit;
 };
@@ -0,0 +1,252 @@
+#include "MatureSpace.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "../vm/Print.h"
+
+using namespace std;
+
+MatureSpace::MatureSpace(size_t numberOfAllocators)
+    : allocators(max(numberOfAllocators, (size_t)1)) {}
+
+MatureSpace::~MatureSpace() {
+    for (MatureBlock* block : blocks) {
+        free(block);
+    }
+    for (LargeObject* large : largeObjects) {
+        free(large);
+    }
+}
+
+void* MatureSpace::Allocate(size_t size, size_t allocator) {
+    if (size > LARGE_OBJECT_SIZE) {
+        return allocateLarge(size);
+    }
+
+    assert(allocator < allocators.size());
+    Allocator& alloc = allocators[allocator];
+    if (collecting) {
+        return allocateInFreeBlock(alloc.evacuation, size);
+    }
+
+    alloc.allocated += size;
+    void* result = bump(alloc.hole, size);
+    while (result == nullptr) {
+        if (size > LINE_SIZE) {
+            // don't skip over holes that are too small for a medium object
+            return allocateInFreeBlock(alloc.overflow, size);
+        }
+        nextHole(alloc);
+        result = bump(alloc.hole, size);
+    }
+    return result;
+}
+
+void* MatureSpace::allocateLarge(size_t size) {
+    auto* large = (LargeObject*)malloc(sizeof(LargeObject) + size);
+    if (large == nullptr) {
+        ErrorPrint("\nFailed to allocate " + to_string(size) + " Bytes.\n");
+        Quit(-1);
+    }
+    large->size = sizeof(LargeObject) + size;
+    large->marked = false;
+
+    std::lock_guard<std::mutex> const lock(mutex);
+    largeObjects.push_back(large);
+    this->size += large->size;
+    return (void*)(large + 1);
+}
+
+void* MatureSpace::allocateInFreeBlock(Region& region, size_t size) {
+    void* result = bump(region, size);
+    if (result != nullptr) {
+        return result;
+    }
+
+    MatureBlock* block = nullptr;
+    {
+        std::lock_guard<std::mutex> const lock(mutex);
+        block = takeFreeBlock();
+    }
+    region.cursor = (uint8_t*)block + (FIRST_LINE * LINE_SIZE);
+    region.limit = (uint8_t*)block + BLOCK_SIZE;
+    return bump(region, size);
+}
+
+void MatureSpace::nextHole(Allocator& alloc) {
+    while (true) {
+        MatureBlock* const block = alloc.currentBlock;
+        if (block != nullptr) {
+            uint8_t const* marks = block->lineMarks;
+            size_t start = alloc.nextLine;
+            while (start < LINES_PER_BLOCK && marks[start] != 0) {
+                start += 1;
+            }
+            size_t end = start;
+            while (end < LINES_PER_BLOCK && marks[end] == 0) {
+                end += 1;
+            }
+
+            if (start < end) {
+                alloc.hole.cursor = (uint8_t*)block + (start * LINE_SIZE);
+                alloc.hole.limit = (uint8_t*)block + (end * LINE_SIZE);
+                alloc.nextLine = end;
+                return;
+            }
+        }
+
+        std::lock_guard<std::mutex> const lock(mutex);
+        if (recyclableBlocks.empty()) {
+            alloc.currentBlock = takeFreeBlock();
+        } else {
+            alloc.currentBlock = recyclableBlocks.back();
+            recyclableBlocks.pop_back();
+        }
+        alloc.nextLine = FIRST_LINE;
+    }
+}
+
+MatureBlock* MatureSpace::takeFreeBlock() {
+    MatureBlock* block = nullptr;
+    if (freeBlocks.empty()) {
+        block = (MatureBlock*)aligned_alloc(BLOCK_SIZE, BLOCK_SIZE);
+        if (block == nullptr) {
+            ErrorPrint("\nFailed to allocate a block of the mature space.\n");
+            Quit(-1);
+        }
+        memset(block, 0, sizeof(MatureBlock));
+        blocks.push_back(block);
+    } else {
+        block = freeBlocks.back();
+        freeBlocks.pop_back();
+    }
+
+    block->liveLines = 0;
+    block->evacuate = false;
+    return block;
+}
+
+void MatureSpace::StartCollection() {
+    collecting = true;
+
+    size_t candidates = 0;
+    for (MatureBlock* block : blocks) {
+        memset(block->lineMarks, 0, sizeof(block->lineMarks));
+        memset(block->markBits, 0, sizeof(block->markBits));
+        block->evacuate = block->liveLines != 0 &&
+                          block->liveLines <= EVACUATION_THRESHOLD;
+        if (block->evacuate) {
+            candidates += 1;
+        }
+        block->liveLines = 0;
+    }
+
+    // evacuating a single block into a free one does not gain anything
+    if (candidates < 2) {
+        for (MatureBlock* block : blocks) {
+            block->evacuate = false;
+        }
+    }
+}
+
+bool MatureSpace::Mark(void* start, size_t size) {
+    if (size > LARGE_OBJECT_SIZE) {
+        LargeObject* large = (LargeObject*)start - 1;
+        return !__atomic_exchange_n(&large->marked, true, __ATOMIC_RELAXED);
+    }
+
+    MatureBlock* block = BlockOf(start);
+    size_t const offset = (size_t)start - (size_t)block;
+    size_t const word = offset / sizeof(void*);
+    uint64_t const bit = (uint64_t)1U << (word % 64);
+    if ((__atomic_fetch_or(&block->markBits[word / 64], bit,
+                           __ATOMIC_RELAXED) &
+         bit) != 0) {
+        return false;
+    }
+
+    // count the lines as they get marked, so that sweeping does not need to
+    // look at them. Neighbouring allocations may be marked by other workers.
+    size_t const lastLine = (offset + size - 1) >> LINE_SHIFT;
+    for (size_t line = offset >> LINE_SHIFT; line <= lastLine; line += 1) {
+        if (block->lineMarks[line] == 0 &&
+            __atomic_exchange_n(&block->lineMarks[line], 1,
+                                __ATOMIC_RELAXED) == 0) {
+            __atomic_fetch_add(&block->liveLines, 1, __ATOMIC_RELAXED);
+        }
+    }
+    return true;
+}
+
+size_t MatureSpace::GetSize() const {
+    size_t allocated = size;
+    for (Allocator const& alloc : allocators) {
+        allocated += alloc.allocated;
+    }
+    return allocated;
+}
+
+bool MatureSpace::ShouldEvacuate(void* start, size_t size) const {
+    return size <= LARGE_OBJECT_SIZE && BlockOf(start)->evacuate;
+}
+
+void MatureSpace::Sweep() {
+    size = 0;
+    recyclableBlocks.clear();
+
+    vector<MatureBlock*> usedBlocks;
+    vector<MatureBlock*> emptyBlocks;
+    for (MatureBlock* block : blocks) {
+        size_t const liveLines = block->liveLines;
+        block->evacuate = false;
+
+        if (liveLines == 0) {
+            emptyBlocks.push_back(block);
+            continue;
+        }
+        usedBlocks.push_back(block);
+        if (liveLines < LINES_PER_BLOCK - FIRST_LINE) {
+            recyclableBlocks.push_back(block);
+        }
+        size += liveLines * LINE_SIZE;
+    }
+
+    // keep as many free blocks as there are used ones, and give the rest
+    // back to the system
+    freeBlocks.clear();
+    blocks.swap(usedBlocks);
+    size_t const reserve = blocks.size();
+    for (MatureBlock* block : emptyBlocks) {
+        if (freeBlocks.size() < reserve) {
+            freeBlocks.push_back(block);
+            blocks.push_back(block);
+        } else {
+            free(block);
+        }
+    }
+
+    vector<LargeObject*> survivors;
+    for (LargeObject* large : largeObjects) {
+        if (large->marked) {
+            large->marked = false;
+            survivors.push_back(large);
+            size += large->size;
+        } else {
+            free(large);
+        }
+    }
+    largeObjects.swap(survivors);
+
+    for (Allocator& alloc : allocators) {
+        alloc = Allocator();
+    }
+    collecting = false;
+}
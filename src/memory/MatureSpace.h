@@ -0,0 +1,134 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "../misc/defs.h"
+
+// the mature space is a set of 32 KB blocks, which are divided into lines of
+// 128 bytes
+#define BLOCK_SHIFT 15U
+#define BLOCK_SIZE (1U << BLOCK_SHIFT)
+#define LINE_SHIFT 7U
+#define LINE_SIZE (1U << LINE_SHIFT)
+#define LINES_PER_BLOCK (BLOCK_SIZE / LINE_SIZE)
+
+// allocations larger than this are not placed into blocks
+#define LARGE_OBJECT_SIZE (BLOCK_SIZE / 4)
+
+// blocks in which the last collection found at most this many live lines are
+// evacuated by the next one
+#define EVACUATION_THRESHOLD (LINES_PER_BLOCK / 4)
+
+/// The header at the start of each block. The line marks and the mark bits,
+/// one per word, are kept on the side, so that a collection can clear them
+/// without visiting the objects.
+struct MatureBlock {
+    uint8_t lineMarks[LINES_PER_BLOCK];
+    uint64_t markBits[BLOCK_SIZE / sizeof(void*) / 64];
+    size_t liveLines;
+    bool evacuate;
+};
+
+// the first line that is not occupied by the block header
+#define FIRST_LINE ((sizeof(MatureBlock) + LINE_SIZE - 1) / LINE_SIZE)
+
+/// The header of an allocation in the large object space.
+struct LargeObject {
+    size_t size;
+    bool marked;
+};
+
+/**
+ * A mark-region space in the style of Immix. Allocation bumps a pointer
+ * through the holes of free lines in recyclable blocks, and then through free
+ * blocks. A collection marks the lines of the live allocations and recycles
+ * the lines and blocks without any live allocation. Sparse blocks are
+ * evacuated during marking, their allocations are copied into free blocks.
+ *
+ * Each GC worker has its own allocator, which takes whole blocks from the
+ * space, so that only taking a block needs a lock. The program allocates
+ * with the allocator of the first worker.
+ *
+ * The space only manages memory, the collector tells it which allocations
+ * are live.
+ */
+class MatureSpace {
+public:
+    explicit MatureSpace(size_t numberOfAllocators = 1);
+    ~MatureSpace();
+
+    /// Allocate from the holes of the space, or during a collection, from
+    /// free blocks only. Each allocator may only be used by one thread.
+    void* Allocate(size_t size, size_t allocator = 0);
+
+    /// Clear all marks, and select the blocks to be evacuated.
+    void StartCollection();
+
+    /// Mark the allocation and the lines it occupies, returns false if the
+    /// allocation was marked already. Marking is atomic, so that it can be
+    /// done by several threads.
+    bool Mark(void* start, size_t size);
+
+    /// Whether the allocation needs to be moved out of its block.
+    [[nodiscard]] bool ShouldEvacuate(void* start, size_t size) const;
+
+    /// Recycle the blocks without marked lines. The holes in the other blocks
+    /// are only looked for when allocation gets to them.
+    void Sweep();
+
+    /// The number of bytes in used lines and large objects.
+    [[nodiscard]] size_t GetSize() const;
+
+private:
+    struct Region {
+        uint8_t* cursor{nullptr};
+        uint8_t* limit{nullptr};
+    };
+
+    // small allocations go into the holes of the current block, medium ones
+    // that do not fit the current hole go into the overflow region. The
+    // allocators of different threads do not share a cache line.
+    struct alignas(64) Allocator {
+        MatureBlock* currentBlock{nullptr};
+        size_t nextLine{0};
+        Region hole;
+        Region overflow;
+        Region evacuation;
+        size_t allocated{0};
+    };
+
+    [[nodiscard]] static inline MatureBlock* BlockOf(void* start) {
+        return (MatureBlock*)((size_t)start & ~((size_t)BLOCK_SIZE - 1));
+    }
+
+    static inline void* bump(Region& region, size_t size) {
+        if (region.cursor + size > region.limit) {
+            return nullptr;
+        }
+        void* result = region.cursor;
+        region.cursor += size;
+        return result;
+    }
+
+    void* allocateLarge(size_t size);
+    void* allocateInFreeBlock(Region& region, size_t size);
+    void nextHole(Allocator& alloc);
+
+    /// Only to be called with the mutex held.
+    MatureBlock* takeFreeBlock();
+
+    std::vector<Allocator> allocators;
+
+    // the blocks and large objects are shared by all allocators
+    std::mutex mutex;
+    std::vector<MatureBlock*> blocks;
+    std::vector<MatureBlock*> recyclableBlocks;
+    std::vector<MatureBlock*> freeBlocks;
+    std::vector<LargeObject*> largeObjects;
+
+    bool collecting{false};
+    size_t size{0};
+};
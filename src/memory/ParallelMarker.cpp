@@ -0,0 +1,168 @@
+#include "ParallelMarker.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "../vmobjects/AbstractObject.h"
+#include "../vmobjects/ObjectFormats.h"
+
+thread_local ParallelMarker::Worker* ParallelMarker::currentWorker = nullptr;
+
+ParallelMarker::ParallelMarker(size_t numberOfWorkers) {
+    numberOfWorkers = std::max(numberOfWorkers, (size_t)1);
+    for (size_t id = 0; id < numberOfWorkers; id += 1) {
+        workers.push_back(std::make_unique<Worker>(id));
+    }
+
+    // the thread that collects is the first worker
+    for (size_t id = 1; id < numberOfWorkers; id += 1) {
+        helpers.emplace_back(&ParallelMarker::runHelper, this, id);
+    }
+}
+
+ParallelMarker::~ParallelMarker() {
+    {
+        std::lock_guard<std::mutex> const lock(mutex);
+        shuttingDown = true;
+    }
+    startMarking.notify_all();
+    for (std::thread& helper : helpers) {
+        helper.join();
+    }
+}
+
+void ParallelMarker::Mark(void (*walkRoots)(walk_heap_fn),
+                          walk_heap_fn walk) {
+    this->walk = walk;
+    for (auto& worker : workers) {
+        worker->liveBytes = 0;
+    }
+
+    // this thread is not idle before it traced, so the helpers cannot
+    // finish while it walks the roots
+    idleWorkers = 0;
+    if (!helpers.empty()) {
+        {
+            std::lock_guard<std::mutex> const lock(mutex);
+            markingRound += 1;
+            runningHelpers = helpers.size();
+        }
+        startMarking.notify_all();
+    }
+
+    // the roots are updated in place, and thus only walked by this thread,
+    // while the helpers steal the objects it pushes
+    currentWorker = workers[0].get();
+    walkRoots(walk);
+
+    trace(0);
+
+    if (!helpers.empty()) {
+        std::unique_lock<std::mutex> lock(mutex);
+        helpersDone.wait(lock, [this] { return runningHelpers == 0; });
+    }
+}
+
+size_t ParallelMarker::GetLiveBytes() const {
+    size_t liveBytes = 0;
+    for (auto const& worker : workers) {
+        liveBytes += worker->liveBytes;
+    }
+    return liveBytes;
+}
+
+void ParallelMarker::trace(size_t id) {
+    Worker& worker = *workers[id];
+    while (true) {
+        AbstractVMObject* obj = nullptr;
+        if (!worker.markStack.empty()) {
+            obj = worker.markStack.back();
+            worker.markStack.pop_back();
+            shareWork(worker);
+        } else {
+            obj = worker.sharedStack.Pop();
+            if (obj == nullptr) {
+                obj = steal(id);
+            }
+        }
+        if (obj != nullptr) {
+            obj->WalkObjects(walk);
+            continue;
+        }
+
+        // an idle worker has empty stacks and does not push, so once all
+        // workers are idle, marking is complete
+        idleWorkers += 1;
+        while (true) {
+            if (idleWorkers == workers.size()) {
+                return;
+            }
+            if (!allSharedStacksEmpty()) {
+                idleWorkers -= 1;
+                break;
+            }
+            std::this_thread::yield();
+        }
+    }
+}
+
+void ParallelMarker::shareWork(Worker& worker) {
+    if (helpers.empty() || worker.markStack.size() < 2 ||
+        !worker.sharedStack.IsEmpty()) {
+        return;
+    }
+
+    // the worker keeps the older half of its mark stack
+    size_t const keep = worker.markStack.size() / 2;
+    for (size_t i = keep; i < worker.markStack.size(); i += 1) {
+        worker.sharedStack.Push(worker.markStack[i]);
+    }
+    worker.markStack.resize(keep);
+}
+
+AbstractVMObject* ParallelMarker::steal(size_t id) {
+    size_t const numberOfWorkers = workers.size();
+    for (size_t i = 1; i < numberOfWorkers; i += 1) {
+        AbstractVMObject* obj =
+            workers[(id + i) % numberOfWorkers]->sharedStack.Steal();
+        if (obj != nullptr) {
+            return obj;
+        }
+    }
+    return nullptr;
+}
+
+bool ParallelMarker::allSharedStacksEmpty() const {
+    return std::all_of(workers.begin(), workers.end(), [](auto const& worker) {
+        return worker->sharedStack.IsEmpty();
+    });
+}
+
+void ParallelMarker::runHelper(size_t id) {
+    currentWorker = workers[id].get();
+
+    size_t round = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            startMarking.wait(lock, [this, round] {
+                return shuttingDown || markingRound != round;
+            });
+            if (shuttingDown) {
+                return;
+            }
+            round = markingRound;
+        }
+
+        trace(id);
+
+        {
+            std::lock_guard<std::mutex> const lock(mutex);
+            runningHelpers -= 1;
+        }
+        helpersDone.notify_one();
+    }
+}
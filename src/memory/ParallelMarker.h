@@ -0,0 +1,90 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "../misc/defs.h"
+#include "../vmobjects/ObjectFormats.h"
+#include "WorkStealingDeque.h"
+
+/**
+ * Traces the object graph with a number of GC worker threads. Each worker has
+ * its own mark stack, so that marking does not recurse on the C stack. The
+ * mark stack is private, and the worker moves part of it to its
+ * work-stealing deque whenever the deque ran empty, so that idle workers can
+ * steal work without the owner paying for synchronization on each push.
+ *
+ * The collector provides the function that is applied to each reference. It
+ * marks the object atomically, and pushes it with Push() when it was not
+ * marked before. The function returns the reference to be stored, which
+ * allows objects to be moved while marking. The copying collectors push the
+ * copies, and their forwarding pointers serve as marks.
+ */
+class ParallelMarker {
+public:
+    explicit ParallelMarker(size_t numberOfWorkers);
+    ~ParallelMarker();
+
+    ParallelMarker(const ParallelMarker&) = delete;
+    ParallelMarker& operator=(const ParallelMarker&) = delete;
+
+    /// Apply the function to the roots on this thread, and to the fields of
+    /// all pushed objects, with all workers. The other workers start on the
+    /// pushed objects while the roots are still being walked.
+    void Mark(void (*walkRoots)(walk_heap_fn), walk_heap_fn walk);
+
+    /// Push a newly marked object onto the mark stack of the current worker.
+    static inline void Push(AbstractVMObject* obj) {
+        currentWorker->markStack.push_back(obj);
+    }
+
+    /// Add to the live bytes counted by the current worker.
+    static inline void CountLive(size_t bytes) {
+        currentWorker->liveBytes += bytes;
+    }
+
+    /// The index of the worker on this thread, which is 0 for the thread
+    /// that runs the program and collects.
+    static inline size_t CurrentWorkerId() {
+        return currentWorker == nullptr ? 0 : currentWorker->id;
+    }
+
+    /// The live bytes counted by all workers during the last Mark().
+    [[nodiscard]] size_t GetLiveBytes() const;
+
+private:
+    struct Worker {
+        explicit Worker(size_t id) : id(id) {}
+
+        size_t const id;
+        std::vector<AbstractVMObject*> markStack;
+        WorkStealingDeque<AbstractVMObject> sharedStack;
+        size_t liveBytes{0};
+    };
+
+    void trace(size_t id);
+    void shareWork(Worker& worker);
+    AbstractVMObject* steal(size_t id);
+    [[nodiscard]] bool allSharedStacksEmpty() const;
+    void runHelper(size_t id);
+
+    static thread_local Worker* currentWorker;
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    walk_heap_fn walk{nullptr};
+    std::atomic<size_t> idleWorkers{0};
+
+    // the helper threads are started once, and wait for the next Mark()
+    std::vector<std::thread> helpers;
+    std::mutex mutex;
+    std::condition_variable startMarking;
+    std::condition_variable helpersDone;
+    size_t markingRound{0};
+    size_t runningHelpers{0};
+    bool shuttingDown{false};
+};
@@ -0,0 +1,136 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * The work-stealing deque of Chase and Lev, with the memory orderings of Lê
+ * et al., "Correct and Efficient Work-Stealing for Weak Memory Models". The
+ * owner pushes and pops at the bottom, other threads steal from the top.
+ *
+ * The elements are pointers, and nullptr signals an empty deque or a lost
+ * race. The arrays outgrown by the deque are kept until it is destroyed,
+ * because a thief may still read from them.
+ */
+template <class T>
+class WorkStealingDeque {
+public:
+    /// The capacity needs to be a power of two.
+    explicit WorkStealingDeque(size_t initialCapacity = 1024)
+        : array(new Array(initialCapacity)) {}
+
+    ~WorkStealingDeque() {
+        delete array.load(std::memory_order_relaxed);
+        for (Array* retired : retiredArrays) {
+            delete retired;
+        }
+    }
+
+    WorkStealingDeque(const WorkStealingDeque&) = delete;
+    WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+    /// Only to be called by the owner.
+    void Push(T* element) {
+        int64_t const b = bottom.load(std::memory_order_relaxed);
+        int64_t const t = top.load(std::memory_order_acquire);
+        Array* a = array.load(std::memory_order_relaxed);
+        if (b - t > (int64_t)a->capacity - 1) {
+            a = grow(a, b, t);
+        }
+        a->Put(b, element);
+        std::atomic_thread_fence(std::memory_order_release);
+        bottom.store(b + 1, std::memory_order_relaxed);
+    }
+
+    /// Only to be called by the owner.
+    T* Pop() {
+        int64_t const b = bottom.load(std::memory_order_relaxed) - 1;
+        Array* a = array.load(std::memory_order_relaxed);
+        bottom.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t t = top.load(std::memory_order_relaxed);
+
+        if (t > b) {
+            // the deque was empty
+            bottom.store(b + 1, std::memory_order_relaxed);
+            return nullptr;
+        }
+
+        T* element = a->Get(b);
+        if (t == b) {
+            // the last element, which a thief may take at the same time
+            if (!top.compare_exchange_strong(t, t + 1,
+                                             std::memory_order_seq_cst,
+                                             std::memory_order_relaxed)) {
+                element = nullptr;
+            }
+            bottom.store(b + 1, std::memory_order_relaxed);
+        }
+        return element;
+    }
+
+    /// May be called by any thread.
+    T* Steal() {
+        int64_t t = top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t const b = bottom.load(std::memory_order_acquire);
+        if (t >= b) {
+            return nullptr;
+        }
+
+        Array* a = array.load(std::memory_order_acquire);
+        T* element = a->Get(t);
+        if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                         std::memory_order_relaxed)) {
+            return nullptr;
+        }
+        return element;
+    }
+
+    /// Whether the deque looked empty, which may be outdated right away.
+    [[nodiscard]] bool IsEmpty() const {
+        return bottom.load(std::memory_order_relaxed) <=
+               top.load(std::memory_order_relaxed);
+    }
+
+private:
+    struct Array {
+        explicit Array(size_t capacity)
+            : capacity(capacity), elements(new std::atomic<T*>[capacity]) {}
+        ~Array() { delete[] elements; }
+
+        Array(const Array&) = delete;
+        Array& operator=(const Array&) = delete;
+
+        [[nodiscard]] T* Get(int64_t index) const {
+            return elements[(size_t)index & (capacity - 1)].load(
+                std::memory_order_relaxed);
+        }
+
+        void Put(int64_t index, T* element) {
+            elements[(size_t)index & (capacity - 1)].store(
+                element, std::memory_order_relaxed);
+        }
+
+        size_t const capacity;
+        std::atomic<T*>* const elements;
+    };
+
+    Array* grow(Array* old, int64_t b, int64_t t) {
+        auto* grown = new Array(old->capacity * 2);
+        for (int64_t i = t; i < b; i += 1) {
+            grown->Put(i, old->Get(i));
+        }
+        retiredArrays.push_back(old);
+        array.store(grown, std::memory_order_release);
+        return grown;
+    }
+
+    // the owner and the thieves should not contend for the same cache line
+    alignas(64) std::atomic<int64_t> top{0};
+    alignas(64) std::atomic<int64_t> bottom{0};
+    std::atomic<Array*> array;
+    std::vector<Array*> retiredArrays;
+};
@@ -74,6 +74,8 @@ class GenerationalHeap;
 typedef GenerationalHeap HEAP_CLS;
   #define write_barrier(obj, value_ptr) \
       ((GetHeap<GenerationalHeap>())->writeBarrier(obj, value_ptr))
+  #define write_barrier_at(obj, slot, value_ptr) \
+      ((GetHeap<GenerationalHeap>())->writeBarrier(obj, slot, value_ptr))
   #define ALLOC_MATURE , true
   #define ALLOC_OUTSIDE_NURSERY(X) , (X)
   #define ALLOC_OUTSIDE_NURSERY_DECL , bool outsideNursery = false
@@ -81,6 +83,7 @@ typedef GenerationalHeap HEAP_CLS;
 class CopyingHeap;
 typedef CopyingHeap HEAP_CLS;
   #define write_barrier(obj, value_ptr)
+  #define write_barrier_at(obj, slot, value_ptr)
   #define ALLOC_MATURE
   #define ALLOC_OUTSIDE_NURSERY(X)
   #define ALLOC_OUTSIDE_NURSERY_DECL
@@ -88,6 +91,7 @@ typedef CopyingHeap HEAP_CLS;
 class MarkSweepHeap;
 typedef MarkSweepHeap HEAP_CLS;
   #define write_barrier(obj, value_ptr)
+  #define write_barrier_at(obj, slot, value_ptr)
   #define ALLOC_MATURE
   #define ALLOC_OUTSIDE_NURSERY(X)
   #define ALLOC_OUTSIDE_NURSERY_DECL
@@ -95,6 +99,7 @@ typedef MarkSweepHeap HEAP_CLS;
 class DebugCopyingHeap;
 typedef DebugCopyingHeap HEAP_CLS;
   #define write_barrier(obj, value_ptr)
+  #define write_barrier_at(obj, slot, value_ptr)
   #define ALLOC_MATURE
   #define ALLOC_OUTSIDE_NURSERY(X)
   #define ALLOC_OUTSIDE_NURSERY_DECL
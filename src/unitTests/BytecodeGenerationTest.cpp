@@ -11,6 +11,8 @@
 
 #include "../interpreter/bytecodes.h"
 #include "../misc/StringUtil.h"
+#include "../vm/Globals.h"
+#include "../vmobjects/VMInvokable.h"
 #include "../vmobjects/VMMethod.h"
 #include "TestWithParsing.h"
 
@@ -140,6 +142,15 @@ void BytecodeGenerationTest::testSendDupPopFieldReturnLocalPeriod() {
            BC_RETURN_LOCAL});
 }
 
+void BytecodeGenerationTest::testSuperSend() {
+    auto bytecodes = methodToBytecode("test = ( ^ super method: 1 )");
+
+    // the second operand is the literal that caches the target
+    check(bytecodes,
+          {BC_PUSH_SELF, BC_PUSH_1, BC(BC_SUPER_SEND, 0, 1), BC_RETURN_LOCAL});
+    CPPUNIT_ASSERT(_mgenc->GetLiteral(1) == load_ptr(nilObject));
+}
+
 void BytecodeGenerationTest::testBlockDupPopArgumentPopReturnArg() {
     auto bytecodes = blockToBytecode("[:arg | arg := 1. arg ]");
 
@@ -518,29 +529,80 @@ void BytecodeGenerationTest::testInliningOfToDo() {
     check(bytecodes,
           {BC_PUSH_1, BC_PUSH_CONSTANT_0,
            BC_DUP_SECOND,  // stack: Top[1, 2, 1]
+           BC_PUSH_1,      // the step
 
-           BC(BC_JUMP_IF_GREATER, 11, 0),  // consume only on jump
-           BC_DUP,
+           // moves counter, limit, and step into loop slot 0
+           BC(BC_LOOP_START, 13, 0, 0),
+           BC(BC_LOOP_COUNTER, 0),  // box the counter, the block reads it
 
            BC_POP_LOCAL_0,   // store the i into the local (arg becomes local
                              // after inlining)
            BC_PUSH_LOCAL_0,  // push the local on the stack as part of the
                              // block's code
            BC_POP,           // cleanup after block
-           BC_INC,           // increment top, the iteration counter
 
-           // jump back to the jump_if_greater bytecode
-           BC(BC_JUMP_BACKWARD, 8, 0),
+           // increment the counter, and jump back to the loop's body
+           BC(BC_LOOP_NEXT, 5, 0, 0),
+
+           // loop_start target
+           BC_RETURN_SELF});
+}
+
+void BytecodeGenerationTest::testInliningOfToDoWithUnreadArgument() {
+    auto bytecodes = methodToBytecode("test = ( 1 to: 2 do: [:i | 3 ] )");
+    check(bytecodes,
+          {BC_PUSH_1, BC_PUSH_CONSTANT_0, BC_DUP_SECOND, BC_PUSH_1,
+           BC(BC_LOOP_START, 10, 0, 0),
+
+           // the counter stays unboxed in its slot
+           BC_PUSH_CONSTANT_1, BC_POP, BC(BC_LOOP_NEXT, 2, 0, 0),
+           BC_RETURN_SELF});
+}
+
+void BytecodeGenerationTest::testInliningOfToByDo() {
+    auto bytecodes =
+        methodToBytecode("test = ( 10 to: 1 by: -2 do: [:i | i ] )");
+    check(bytecodes,
+          {BC_PUSH_CONSTANT_0, BC_PUSH_1, BC_DUP_SECOND,
+           BC_PUSH_CONSTANT_1,  // the step, kept in the loop slots
+
+           // a negative step counts down
+           BC(BC_LOOP_START, 13, 0, 0), BC(BC_LOOP_COUNTER, 0),
+           BC_POP_LOCAL_0, BC_PUSH_LOCAL_0, BC_POP, BC(BC_LOOP_NEXT, 5, 0, 0),
 
-           // jump_if_greater target
            BC_RETURN_SELF});
 }
 
+void BytecodeGenerationTest::testInliningOfTimesRepeat() {
+    auto bytecodes =
+        methodToBytecode("test: arg = ( 3 timesRepeat: [ arg ] )");
+    check(bytecodes,
+          {BC_PUSH_CONSTANT_0,
+           BC_DUP,     // the receiver is the limit
+           BC_PUSH_1,  // and the iteration counter starts at 1
+           BC_PUSH_1,  // with a step of 1
+           BC(BC_LOOP_START, 10, 0, 0), BC_PUSH_ARG_1, BC_POP,
+           BC(BC_LOOP_NEXT, 2, 0, 0), BC_RETURN_SELF});
+}
+
+void BytecodeGenerationTest::testInliningOfUnaryWhileTrue() {
+    auto bytecodes = methodToBytecode(R"""(   test: arg = (
+                                                #start.
+                                                [ arg ] whileTrue.
+                                                #end
+                                            ) )""");
+    check(bytecodes,
+          {BC_PUSH_CONSTANT_0, BC_POP, BC_PUSH_ARG_1,
+           BC(BC_JUMP_ON_FALSE_POP, 6, 0), BC(BC_JUMP_BACKWARD, 4, 0),
+           BC_PUSH_NIL, BC_POP, BC_PUSH_CONSTANT_1, BC_RETURN_SELF});
+}
+
 static std::vector<uint8_t> GetBytecodes(VMMethod* method) {
     std::vector<uint8_t> bcs(method->bcLength);
 
     for (size_t i = 0; i < method->bcLength; i += 1) {
-        bcs.at(i) = method->GetBytecode(i);
+        // superinstructions are checked as the bytecodes they combine
+        bcs.at(i) = BaseBytecode(method->GetBytecode(i));
     }
     return bcs;
 }
@@ -558,20 +620,20 @@ void BytecodeGenerationTest::testToDoBlockBlockInlinedSelf() {
     check(bytecodes,
           {BC_PUSH_1, BC_PUSH_CONSTANT_0,
            BC_DUP_SECOND,  // stack: Top[1, 2, 1]
+           BC_PUSH_1,      // the step
 
-           BC(BC_JUMP_IF_GREATER, 15, 0),  // consume only on jump
-           BC_DUP,
+           BC(BC_LOOP_START, 17, 0, 0), BC(BC_LOOP_COUNTER, 0),
 
-           BC_POP_LOCAL_2,                        // store the `a`
-           BC_PUSH_LOCAL_0,                       // push the `l1` on the stack
-           BC(BC_PUSH_BLOCK, 1), BC(BC_SEND, 2),  // send #do:
+           BC_POP_LOCAL_2,        // store the `a`
+           BC_PUSH_LOCAL_0,       // push the `l1` on the stack
+           BC(BC_PUSH_BLOCK, 1),  //~
+           BC(BC_SEND_2, 2),      // send #do:
            BC_POP,
-           BC_INC,  // increment top, the iteration counter
 
-           // jump back to the jump_if_greater bytecode
-           BC(BC_JUMP_BACKWARD, 12, 0),
+           // jump back to the loop's body
+           BC(BC_LOOP_NEXT, 9, 0, 0),
 
-           // jump_if_greater target
+           // loop_start target
            BC_RETURN_SELF});
 
     auto* block = (VMMethod*)_mgenc->GetLiteral(1);
@@ -583,6 +645,40 @@ void BytecodeGenerationTest::testToDoBlockBlockInlinedSelf() {
           block);
 }
 
+void BytecodeGenerationTest::testNonEscapingBlockArguments() {
+    methodToBytecode(R"""(
+                       test: arr = (
+                         arr do: [:e | e ].
+                         arr do: [:e | [ e ] ].
+                         arr foo: [:e | e ].
+                         arr detect: [:e | e ] ifNone: [ nil ]
+                       ) )""");
+
+    // literals: block, #do:, block, block, #foo:, block, block,
+    // #detect:ifNone:
+    auto* doBlock = (VMInvokable*)_mgenc->GetLiteral(0);
+    CPPUNIT_ASSERT_EQUAL((uint8_t)(RECEIVER_ARRAY | RECEIVER_VECTOR),
+                         doBlock->GetNonEscapingReceivers());
+    CPPUNIT_ASSERT_EQUAL((uint8_t)0, doBlock->GetArgumentIndexInSend());
+
+    // creates a block, which could capture the block's frame
+    auto* nestingBlock = (VMInvokable*)_mgenc->GetLiteral(2);
+    CPPUNIT_ASSERT_EQUAL((uint8_t)0, nestingBlock->GetNonEscapingReceivers());
+
+    auto* unknownSendBlock = (VMInvokable*)_mgenc->GetLiteral(3);
+    CPPUNIT_ASSERT_EQUAL((uint8_t)0,
+                         unknownSendBlock->GetNonEscapingReceivers());
+
+    auto* detectBlock = (VMInvokable*)_mgenc->GetLiteral(5);
+    auto* ifNoneBlock = (VMInvokable*)_mgenc->GetLiteral(6);
+    CPPUNIT_ASSERT_EQUAL((uint8_t)RECEIVER_ARRAY,
+                         detectBlock->GetNonEscapingReceivers());
+    CPPUNIT_ASSERT_EQUAL((uint8_t)0, detectBlock->GetArgumentIndexInSend());
+    CPPUNIT_ASSERT_EQUAL((uint8_t)RECEIVER_ARRAY,
+                         ifNoneBlock->GetNonEscapingReceivers());
+    CPPUNIT_ASSERT_EQUAL((uint8_t)1, ifNoneBlock->GetArgumentIndexInSend());
+}
+
 void BytecodeGenerationTest::testToDoWithMoreEmbeddedBlocksAndArgAccess() {
     auto bytecodes = methodToBytecode(R"""(
                                         transferEntries: oldStorage = (
@@ -599,40 +695,39 @@ void BytecodeGenerationTest::testToDoWithMoreEmbeddedBlocksAndArgAccess() {
     check(bytecodes,
           {BC_PUSH_1, BC_PUSH_ARG_1, BC(BC_SEND_1, 0),
            BC_DUP_SECOND,  //~
+           BC_PUSH_1,      // the step
 
-           BC(BC_JUMP_IF_GREATER, 20, 0),  // consume only on jump
-           BC_DUP,
+           BC(BC_LOOP_START, 22, 0, 0), BC(BC_LOOP_COUNTER, 0),
 
-           BC_POP_LOCAL_0,   // i
-           BC_PUSH_ARG_1,    // oldStorage
-           BC_PUSH_LOCAL_0,  // i
-           BC(BC_SEND, 1),   // #at:
+           BC_POP_LOCAL_0,    // i
+           BC_PUSH_ARG_1,     // oldStorage
+           BC_PUSH_LOCAL_0,   // i
+           BC(BC_SEND_2, 1),  // #at:
 
            BC_POP_LOCAL_1,        // current
            BC_PUSH_LOCAL_1,       // current
            BC(BC_PUSH_BLOCK, 2),  // ~
-           BC(BC_SEND, 3),        // send #notInlined:
+           BC(BC_SEND_2, 3),      // send #notInlined:
            BC_POP,
-           BC_INC,  // increment top, the iteration counter
 
-           // jump back to the jump_if_greater bytecode
-           BC(BC_JUMP_BACKWARD, 17, 0),
+           // jump back to the loop's body
+           BC(BC_LOOP_NEXT, 14, 0, 0),
 
-           // jump_if_greater target
+           // loop_start target
            BC_RETURN_SELF});
 
     auto* block = (VMMethod*)_mgenc->GetLiteral(2);
     check(GetBytecodes(block),
-          {BC(BC_PUSH_ARGUMENT, 1, 1),   // oldStorage
-           BC(BC_PUSH_LOCAL, 0, 1),      // i
-           BC_PUSH_NIL, BC(BC_SEND, 0),  // #at:put:
+          {BC(BC_PUSH_ARGUMENT, 1, 1),     // oldStorage
+           BC(BC_PUSH_LOCAL, 0, 1),        // i
+           BC_PUSH_NIL, BC(BC_SEND_3, 0),  // #at:put:
            BC_POP,
 
            BC(BC_PUSH_LOCAL, 1, 1),  // current
            BC(BC_SEND_1, 1),         // #next
            BC(BC_PUSH_BLOCK, 2),     //~
            BC(BC_PUSH_BLOCK, 3),     //~
-           BC(BC_SEND, 4),           // #noInline:noInline:
+           BC(BC_SEND_3, 4),         // #noInline:noInline:
            BC_RETURN_LOCAL},
           block);
 
@@ -653,7 +748,7 @@ void BytecodeGenerationTest::testToDoWithMoreEmbeddedBlocksAndArgAccess() {
            BC(BC_PUSH_ARGUMENT, 1, 2),  // oldStorage
            BC(BC_PUSH_LOCAL, 0, 2),     // i
            BC(BC_PUSH_LOCAL, 1, 2),     // current
-           BC(BC_SEND, 0),              // #splitBucket:bucket:head:
+           BC(BC_SEND_N, 0),            // #splitBucket:bucket:head:
            BC_RETURN_LOCAL},
           block3);
 }
@@ -691,7 +786,7 @@ void BytecodeGenerationTest::testKeywordIfTrueArg() {
                                                  ) )""");
     check(bytecodes,
           {BC_PUSH_CONSTANT_0, BC_POP, BC_PUSH_SELF, BC_PUSH_CONSTANT_1,
-           BC(BC_SEND, 2), BC(BC_JUMP_ON_FALSE_TOP_NIL, 4, 0), BC_PUSH_ARG_1,
+           BC(BC_SEND_2, 2), BC(BC_JUMP_ON_FALSE_TOP_NIL, 4, 0), BC_PUSH_ARG_1,
            BC_POP, BC(BC_PUSH_CONSTANT, 3), BC_RETURN_SELF});
 }
 
@@ -732,7 +827,7 @@ void BytecodeGenerationTest::testNestedIfs() {
         bytecodes,
         {BC_PUSH_CONSTANT_0, BC(BC_JUMP_ON_FALSE_TOP_NIL, 12, 0),
          BC_PUSH_CONSTANT_1, BC(BC_JUMP_ON_TRUE_TOP_NIL, 8, 0), BC_PUSH_FIELD_0,
-         BC_PUSH_ARG_1, BC(BC_SEND, 2), BC_RETURN_LOCAL, BC_RETURN_SELF});
+         BC_PUSH_ARG_1, BC(BC_SUB, 2), BC_RETURN_LOCAL, BC_RETURN_SELF});
 }
 
 void BytecodeGenerationTest::testNestedIfsAndLocals() {
@@ -764,13 +859,13 @@ void BytecodeGenerationTest::testNestedIfsAndLocals() {
                       BC(BC_POP_LOCAL, 7, 0),
                       BC(BC_PUSH_LOCAL, 8, 0),
                       BC(BC_PUSH_LOCAL, 9, 0),
-                      BC(BC_SEND, 4),
+                      BC(BC_SUB, 4),
                       BC(BC_PUSH_LOCAL, 5, 0),
-                      BC(BC_SEND, 4),
+                      BC(BC_SUB, 4),
                       BC(BC_PUSH_LOCAL, 6, 0),
-                      BC(BC_SEND, 4),
+                      BC(BC_SUB, 4),
                       BC(BC_PUSH_LOCAL, 3, 0),
-                      BC(BC_SEND, 4),
+                      BC(BC_SUB, 4),
                       BC_RETURN_LOCAL,
                       BC_RETURN_SELF});
 }
@@ -790,6 +885,29 @@ void BytecodeGenerationTest::incDecBytecodes(const std::string& sel,
     tearDown();
 }
 
+void BytecodeGenerationTest::testSpecialSendBytecodes() {
+    specialSendBytecodes("+", BC_ADD);
+    specialSendBytecodes("-", BC_SUB);
+    specialSendBytecodes("*", BC_MUL);
+    specialSendBytecodes("<", BC_LT);
+    specialSendBytecodes(">", BC_GT);
+    specialSendBytecodes("<=", BC_LE);
+    specialSendBytecodes(">=", BC_GE);
+    specialSendBytecodes("=", BC_EQ);
+    specialSendBytecodes("==", BC_EQ_EQ);
+}
+
+void BytecodeGenerationTest::specialSendBytecodes(const std::string& sel,
+                                                  uint8_t bc) {
+    std::string source = "test: arg = ( ^ arg " + sel + " arg )";
+    auto bytecodes = methodToBytecode(source.data());
+
+    check(bytecodes,
+          {BC_PUSH_ARG_1, BC_PUSH_ARG_1, BC(bc, 0), BC_RETURN_LOCAL});
+
+    tearDown();
+}
+
 void BytecodeGenerationTest::testIfTrueAndIncField() {
     addField("field");
 
@@ -802,7 +920,7 @@ void BytecodeGenerationTest::testIfTrueAndIncField() {
 
     check(bytecodes,
           {BC_PUSH_CONSTANT_0, BC_POP, BC_PUSH_SELF, BC_PUSH_CONSTANT_1,
-           BC(BC_SEND, 2), BC(BC_JUMP_ON_FALSE_TOP_NIL, 5, 0),
+           BC(BC_SEND_2, 2), BC(BC_JUMP_ON_FALSE_TOP_NIL, 5, 0),
            BC(BC_INC_FIELD_PUSH, 0), BC_POP, BC(BC_PUSH_CONSTANT, 3),
            BC_RETURN_SELF});
 }
@@ -817,7 +935,7 @@ void BytecodeGenerationTest::testIfTrueAndIncArg() {
 
     check(bytecodes,
           {BC_PUSH_CONSTANT_0, BC_POP, BC_PUSH_SELF, BC_PUSH_CONSTANT_1,
-           BC(BC_SEND, 2), BC(BC_JUMP_ON_FALSE_TOP_NIL, 5, 0), BC_PUSH_ARG_1,
+           BC(BC_SEND_2, 2), BC(BC_JUMP_ON_FALSE_TOP_NIL, 5, 0), BC_PUSH_ARG_1,
            BC_INC, BC_POP, BC(BC_PUSH_CONSTANT, 3), BC_RETURN_SELF});
 }
 
@@ -1268,7 +1386,7 @@ void BytecodeGenerationTest::testFieldReadIncWrite() {
                       BC_PUSH_CONSTANT_0, BC_POP_LOCAL_0,
 
                       // iter > 0
-                      BC_PUSH_LOCAL_0, BC_PUSH_0, BC(BC_SEND, 1),
+                      BC_PUSH_LOCAL_0, BC_PUSH_0, BC(BC_GT, 1),
 
                       // whileTrue
                       BC(BC_JUMP_ON_FALSE_POP, 14, 0),
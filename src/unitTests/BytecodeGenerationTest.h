@@ -26,6 +26,7 @@ class BytecodeGenerationTest : public TestWithParsing {
     CPPUNIT_TEST(testDupPopFieldNReturnSelf);
     CPPUNIT_TEST(testSendDupPopFieldReturnLocal);
     CPPUNIT_TEST(testSendDupPopFieldReturnLocalPeriod);
+    CPPUNIT_TEST(testSuperSend);
     CPPUNIT_TEST(testBlockDupPopArgumentPopReturnArg);
     CPPUNIT_TEST(testBlockDupPopArgumentImplicitReturn);
     CPPUNIT_TEST(testBlockDupPopArgumentImplicitReturnDot);
@@ -53,8 +54,13 @@ class BytecodeGenerationTest : public TestWithParsing {
     CPPUNIT_TEST(testInliningOfAnd);
 
     CPPUNIT_TEST(testInliningOfToDo);
+    CPPUNIT_TEST(testInliningOfToDoWithUnreadArgument);
+    CPPUNIT_TEST(testInliningOfToByDo);
+    CPPUNIT_TEST(testInliningOfTimesRepeat);
+    CPPUNIT_TEST(testInliningOfUnaryWhileTrue);
     CPPUNIT_TEST(testToDoBlockBlockInlinedSelf);
     CPPUNIT_TEST(testToDoWithMoreEmbeddedBlocksAndArgAccess);
+    CPPUNIT_TEST(testNonEscapingBlockArguments);
 
     CPPUNIT_TEST(testIfArg);
     CPPUNIT_TEST(testKeywordIfTrueArg);
@@ -65,6 +71,7 @@ class BytecodeGenerationTest : public TestWithParsing {
     CPPUNIT_TEST(testNestedIfsAndLocals);
 
     CPPUNIT_TEST(testIncDecBytecodes);
+    CPPUNIT_TEST(testSpecialSendBytecodes);
     CPPUNIT_TEST(testIfTrueAndIncField);
     CPPUNIT_TEST(testIfTrueAndIncArg);
 
@@ -100,6 +107,7 @@ private:
     void testDupPopFieldNReturnSelf();
     void testSendDupPopFieldReturnLocal();
     void testSendDupPopFieldReturnLocalPeriod();
+    void testSuperSend();
 
     void testBlockDupPopArgumentPopReturnArg();
     void testBlockDupPopArgumentImplicitReturn();
@@ -152,8 +160,13 @@ private:
     void inliningOfAnd(std::string selector);
 
     void testInliningOfToDo();
+    void testInliningOfToDoWithUnreadArgument();
+    void testInliningOfToByDo();
+    void testInliningOfTimesRepeat();
+    void testInliningOfUnaryWhileTrue();
     void testToDoBlockBlockInlinedSelf();
     void testToDoWithMoreEmbeddedBlocksAndArgAccess();
+    void testNonEscapingBlockArguments();
 
     static void testJumpQueuesOrdering();
 
@@ -162,6 +175,8 @@ private:
 
     void testIncDecBytecodes();
     void incDecBytecodes(const std::string& sel, uint8_t bc);
+    void testSpecialSendBytecodes();
+    void specialSendBytecodes(const std::string& sel, uint8_t bc);
 
     void testIfTrueAndIncField();
     void testIfTrueAndIncArg();
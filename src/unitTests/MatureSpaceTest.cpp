@@ -0,0 +1,96 @@
+#include "MatureSpaceTest.h"
+
+#include <cppunit/TestAssert.h>
+#include <cstddef>
+#include <vector>
+
+#include "../memory/MatureSpace.h"
+
+void MatureSpaceTest::testRecycleLines() {
+    MatureSpace space;
+
+    // two allocations per line, enough to fill more than one block
+    vector<void*> allocations;
+    for (size_t i = 0; i < 500; i += 1) {
+        allocations.push_back(space.Allocate(LINE_SIZE / 2));
+    }
+
+    space.StartCollection();
+    CPPUNIT_ASSERT(space.Mark(allocations[0], LINE_SIZE / 2));
+    CPPUNIT_ASSERT(!space.Mark(allocations[0], LINE_SIZE / 2));
+    CPPUNIT_ASSERT(space.Mark(allocations[1], LINE_SIZE / 2));
+    space.Sweep();
+
+    CPPUNIT_ASSERT_EQUAL((size_t)LINE_SIZE, space.GetSize());
+
+    // allocation continues in the line after the live one
+    void* reused = space.Allocate(LINE_SIZE / 2);
+    CPPUNIT_ASSERT_EQUAL((void*)((size_t)allocations[0] + LINE_SIZE), reused);
+}
+
+void MatureSpaceTest::testEvacuateSparseBlocks() {
+    MatureSpace space;
+
+    vector<void*> allocations;
+    for (size_t i = 0; i < 1000; i += 1) {
+        allocations.push_back(space.Allocate(LINE_SIZE / 2));
+    }
+
+    // keep one line in each of the first two blocks
+    space.StartCollection();
+    space.Mark(allocations[0], LINE_SIZE / 2);
+    space.Mark(allocations[600], LINE_SIZE / 2);
+    space.Sweep();
+
+    space.StartCollection();
+    CPPUNIT_ASSERT(space.ShouldEvacuate(allocations[0], LINE_SIZE / 2));
+    CPPUNIT_ASSERT(space.ShouldEvacuate(allocations[600], LINE_SIZE / 2));
+
+    // during a collection, allocations go into free blocks
+    void* first = space.Allocate(LINE_SIZE / 2);
+    void* second = space.Allocate(LINE_SIZE / 2);
+    CPPUNIT_ASSERT(!space.ShouldEvacuate(first, LINE_SIZE / 2));
+    CPPUNIT_ASSERT_EQUAL((void*)((size_t)first + (LINE_SIZE / 2)), second);
+
+    space.Mark(first, LINE_SIZE / 2);
+    space.Mark(second, LINE_SIZE / 2);
+    space.Sweep();
+
+    CPPUNIT_ASSERT_EQUAL((size_t)LINE_SIZE, space.GetSize());
+}
+
+void MatureSpaceTest::testLargeObjects() {
+    MatureSpace space;
+
+    size_t const size = LARGE_OBJECT_SIZE + sizeof(void*);
+    void* large = space.Allocate(size);
+    space.Allocate(size);
+
+    space.StartCollection();
+    CPPUNIT_ASSERT(!space.ShouldEvacuate(large, size));
+    CPPUNIT_ASSERT(space.Mark(large, size));
+    CPPUNIT_ASSERT(!space.Mark(large, size));
+    space.Sweep();
+
+    CPPUNIT_ASSERT_EQUAL(sizeof(LargeObject) + size, space.GetSize());
+}
+
+void MatureSpaceTest::testAllocators() {
+    MatureSpace space(2);
+
+    // each allocator bumps through a block of its own
+    void* first = space.Allocate(LINE_SIZE / 2, 0);
+    void* second = space.Allocate(LINE_SIZE / 2, 1);
+    CPPUNIT_ASSERT(((size_t)first >> BLOCK_SHIFT) !=
+                   ((size_t)second >> BLOCK_SHIFT));
+    CPPUNIT_ASSERT_EQUAL((void*)((size_t)first + (LINE_SIZE / 2)),
+                         space.Allocate(LINE_SIZE / 2, 0));
+    CPPUNIT_ASSERT_EQUAL((size_t)3 * (LINE_SIZE / 2), space.GetSize());
+
+    space.StartCollection();
+    space.Mark(first, LINE_SIZE / 2);
+    space.Mark(second, LINE_SIZE / 2);
+    space.Sweep();
+
+    CPPUNIT_ASSERT_EQUAL((size_t)2 * LINE_SIZE, space.GetSize());
+}
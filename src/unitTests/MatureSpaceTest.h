@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cppunit/extensions/HelperMacros.h>
+
+using namespace std;
+
+class MatureSpaceTest : public CPPUNIT_NS::TestCase {
+    CPPUNIT_TEST_SUITE(MatureSpaceTest);  // NOLINT(misc-const-correctness)
+    CPPUNIT_TEST(testRecycleLines);
+    CPPUNIT_TEST(testEvacuateSparseBlocks);
+    CPPUNIT_TEST(testLargeObjects);
+    CPPUNIT_TEST(testAllocators);
+    CPPUNIT_TEST_SUITE_END();
+
+private:
+    static void testRecycleLines();
+    static void testEvacuateSparseBlocks();
+    static void testLargeObjects();
+    static void testAllocators();
+};
@@ -160,6 +160,19 @@ void TestWithParsing::check(std::vector<uint8_t> actual,
                 CPPUNIT_ASSERT_EQUAL_MESSAGE(msg, expectedBc.arg2,
                                              actual.at(bci + 2));
             }
+
+            if (bcLength > 3) {
+                (void)snprintf(
+                    msg, 1000,
+                    "Bytecode %zu (%s), arg3 expected %hhu but got %hhu", i,
+                    Bytecode::GetBytecodeName(expectedBc.bytecode),
+                    expectedBc.arg3, actual.at(bci + 3));
+                if (expectedBc.arg3 != actual.at(bci + 3)) {
+                    dump(toDump);
+                }
+                CPPUNIT_ASSERT_EQUAL_MESSAGE(msg, expectedBc.arg3,
+                                             actual.at(bci + 3));
+            }
         }
 
         i += 1;
@@ -8,17 +8,22 @@
 class BC {
 public:
     // NOLINTNEXTLINE(google-explicit-constructor,hicpp-explicit-conversions)
-    BC(uint8_t bytecode) : bytecode(bytecode), arg1(0), arg2(0), size(1) {}
+    BC(uint8_t bytecode)
+        : bytecode(bytecode), arg1(0), arg2(0), arg3(0), size(1) {}
 
     BC(uint8_t bytecode, uint8_t arg1)
-        : bytecode(bytecode), arg1(arg1), arg2(0), size(2) {}
+        : bytecode(bytecode), arg1(arg1), arg2(0), arg3(0), size(2) {}
 
     BC(uint8_t bytecode, uint8_t arg1, uint8_t arg2)
-        : bytecode(bytecode), arg1(arg1), arg2(arg2), size(3) {}
+        : bytecode(bytecode), arg1(arg1), arg2(arg2), arg3(0), size(3) {}
+
+    BC(uint8_t bytecode, uint8_t arg1, uint8_t arg2, uint8_t arg3)
+        : bytecode(bytecode), arg1(arg1), arg2(arg2), arg3(arg3), size(4) {}
 
     uint8_t bytecode;
     uint8_t arg1;
     uint8_t arg2;
+    uint8_t arg3;
 
     size_t size;
 };
@@ -13,13 +13,20 @@
 
 #include "../compiler/LexicalScope.h"
 #include "../compiler/Variable.h"
+#include "../interpreter/FramePool.h"
+#include "../interpreter/FrameStack.h"
+#include "../interpreter/InlineCache.h"
+#include "../interpreter/MethodCache.h"
+#include "../interpreter/bytecodes.h"
 #include "../memory/Heap.h"
 #include "../misc/defs.h"
 #include "../vm/Globals.h"
 #include "../vm/Symbols.h"
 #include "../vm/Universe.h"
+#include "../vmobjects/DispatchTable.h"
 #include "../vmobjects/ObjectFormats.h"
 #include "../vmobjects/VMArray.h"
+#include "../vmobjects/VMAssociation.h"
 #include "../vmobjects/VMBlock.h"
 #include "../vmobjects/VMClass.h"
 #include "../vmobjects/VMDouble.h"
@@ -39,7 +46,7 @@ static const size_t NoOfFields_Array = NoOfFields_Object;
 static const size_t NoOfFields_Invokable = 2;
 static const size_t NoOfFields_Method = NoOfFields_Invokable;
 static const size_t NoOfFields_Class = 4 + NoOfFields_Object;
-static const size_t NoOfFields_Frame = 3 + NoOfFields_Array;
+static const size_t NoOfFields_Frame = 4 + NoOfFields_Array;
 static const size_t NoOfFields_Block = 2 + NoOfFields_Object;
 static const size_t NoOfFields_Primitive = NoOfFields_Invokable;
 static const size_t NoOfFields_EvaluationPrimitive = NoOfFields_Invokable;
@@ -156,12 +163,15 @@ void WalkObjectsTest::testWalkFrame() {
     VMFrame* prev = Universe::NewFrame(nullptr, method);
     VMFrame* frame = Universe::NewFrame(prev, method);
     frame->SetContext(frame->CloneForMovingGC());
+    CPPUNIT_ASSERT_EQUAL(frame->GetContext(), frame->GetOuterContext());
+    CPPUNIT_ASSERT_EQUAL(prev, prev->GetOuterContext());
     VMInteger* dummyArg = Universe::NewInteger(1111);
     frame->SetArgument(0, 0, dummyArg);
     frame->WalkObjects(collectMembers);
 
     CPPUNIT_ASSERT(WalkerHasFound(tmp_ptr(frame->GetPreviousFrame())));
     CPPUNIT_ASSERT(WalkerHasFound(tmp_ptr(frame->GetContext())));
+    CPPUNIT_ASSERT(WalkerHasFound(tmp_ptr(frame->GetOuterContext())));
     CPPUNIT_ASSERT(WalkerHasFound(tmp_ptr(frame->GetMethod())));
     // CPPUNIT_ASSERT(WalkerHasFound(frame->bytecodeIndex));
     CPPUNIT_ASSERT(WalkerHasFound(tmp_ptr(dummyArg)));
@@ -171,6 +181,69 @@ void WalkObjectsTest::testWalkFrame() {
             1);  // + 1 for the class field that's still in there
 }
 
+void WalkObjectsTest::testWalkFrameStack() {
+    walkedObjects.clear();
+    VMSymbol* methodSymbol = NewSymbol("frameMethod");
+
+    vector<BackJump> inlinedLoops;
+    VMMethod* method =
+        Universe::NewMethod(methodSymbol, 0, 0, 0, 0,
+                            new LexicalScope(nullptr, {}, {}), inlinedLoops);
+
+    VMFrame* heapFrame = Universe::NewFrame(nullptr, method);
+    VMFrame* prev = FrameStack::NewFrame(heapFrame, method);
+    VMFrame* frame = FrameStack::NewFrame(prev, method);
+    CPPUNIT_ASSERT(FrameStack::Contains(frame));
+    CPPUNIT_ASSERT(!FrameStack::Contains(heapFrame));
+
+    VMInteger* dummyArg = Universe::NewInteger(1111);
+    frame->SetArgument(0, 0, dummyArg);
+
+    // the frames on the frame stack are walked in place, and are not walked
+    // as objects themselves
+    frame->WalkObjects(collectMembers);
+    CPPUNIT_ASSERT(!WalkerHasFound(tmp_ptr(prev)));
+
+    walkedObjects.clear();
+    FrameStack::WalkFrames(collectMembers);
+    CPPUNIT_ASSERT(WalkerHasFound(tmp_ptr(heapFrame)));
+    CPPUNIT_ASSERT(WalkerHasFound(tmp_ptr(dummyArg)));
+    CPPUNIT_ASSERT(!WalkerHasFound(tmp_ptr(prev)));
+    CPPUNIT_ASSERT(!WalkerHasFound(tmp_ptr(frame)));
+
+    FrameStack::Release(prev);
+    walkedObjects.clear();
+    FrameStack::WalkFrames(collectMembers);
+    CPPUNIT_ASSERT(!WalkerHasFound(tmp_ptr(heapFrame)));
+    CPPUNIT_ASSERT(!WalkerHasFound(tmp_ptr(dummyArg)));
+}
+
+void WalkObjectsTest::testFramePool() {
+    VMSymbol* methodSymbol = NewSymbol("pooledFrameMethod");
+
+    vector<BackJump> inlinedLoops;
+    VMMethod* method =
+        Universe::NewMethod(methodSymbol, 0, 0, 1, 2,
+                            new LexicalScope(nullptr, {}, {}), inlinedLoops);
+
+    VMFrame* frame = Universe::NewFrame(nullptr, method);
+    frame->SetLocal(0, Universe::NewInteger(1111));
+    frame->Push(Universe::NewInteger(2222));
+    FramePool::Free(frame);
+
+    // reused for a method with the same number of slots, with fresh locals
+    VMFrame* reused = Universe::NewFrame(nullptr, method);
+    CPPUNIT_ASSERT_EQUAL(frame, reused);
+    CPPUNIT_ASSERT_EQUAL(load_ptr(nilObject),
+                         reused->GetLocalInCurrentContext(0));
+    CPPUNIT_ASSERT_EQUAL((size_t)2, reused->RemainingStackSize());
+
+    // the GC drops the pooled frames
+    FramePool::Free(reused);
+    FramePool::Clear();
+    CPPUNIT_ASSERT(FramePool::Allocate(3) == nullptr);
+}
+
 static Variable makeVar(const char* const name, bool isArgument) {
     std::string n = name;
     return {n, 0, isArgument, {0, 0}};
@@ -217,6 +290,111 @@ void WalkObjectsTest::testWalkMethod() {
     CPPUNIT_ASSERT_EQUAL(expectedNumberOfObjects, walkedObjects.size());
 }
 
+void WalkObjectsTest::testWalkMethodWithInlineCache() {
+    walkedObjects.clear();
+
+    VMSymbol* methodSymbol = NewSymbol("methodWithSend");
+
+    vector<BackJump> inlinedLoops;
+    VMMethod* method =
+        Universe::NewMethod(methodSymbol, 2, 0, 0, 0,
+                            new LexicalScope(nullptr, {}, {}), inlinedLoops);
+    method->SetHolder(load_ptr(symbolClass));
+
+    VMClass* cls = load_ptr(objectClass);
+    InlineCache* cache = method->GetInlineCache(0);
+    VMInvokable* invokable =
+        cache->LookupAndCache(cls, SymbolFor("=="), method);
+    CPPUNIT_ASSERT(invokable != nullptr);
+    CPPUNIT_ASSERT_EQUAL(invokable, cache->Lookup(cls));
+
+    method->WalkObjects(collectMembers);
+
+    CPPUNIT_ASSERT(WalkerHasFound(tmp_ptr(cls)));
+    CPPUNIT_ASSERT(WalkerHasFound(tmp_ptr(invokable)));
+    CPPUNIT_ASSERT_EQUAL(NoOfFields_Method + 2, walkedObjects.size());
+}
+
+void WalkObjectsTest::testWalkMethodCache() {
+    walkedObjects.clear();
+
+    VMClass* cls = load_ptr(integerClass);
+    VMSymbol* selector = SymbolFor("hashcode");
+    VMInvokable* invokable = cls->LookupInvokable(selector);
+    CPPUNIT_ASSERT(invokable != nullptr);
+
+    // cached for the receiver class, independent of where it was found
+    CPPUNIT_ASSERT_EQUAL(invokable, MethodCache::Lookup(cls, selector));
+
+    MethodCache::WalkObjects(collectMembers);
+
+    CPPUNIT_ASSERT(WalkerHasFound(tmp_ptr(cls)));
+    CPPUNIT_ASSERT(WalkerHasFound(tmp_ptr(selector)));
+    CPPUNIT_ASSERT(WalkerHasFound(tmp_ptr(invokable)));
+    CPPUNIT_ASSERT_EQUAL(invokable, MethodCache::Lookup(cls, selector));
+
+    MethodCache::Invalidate(selector);
+    CPPUNIT_ASSERT(MethodCache::Lookup(cls, selector) == nullptr);
+}
+
+void WalkObjectsTest::testWalkDispatchTable() {
+    walkedObjects.clear();
+
+    VMClass* objClass = load_ptr(objectClass);
+    VMClass* intClass = load_ptr(integerClass);
+    DispatchTable const objTable(objClass, nullptr);
+    DispatchTable intTable(intClass, &objTable);
+
+    // inherited from Object
+    VMSymbol* inherited = SymbolFor("isNil");
+    CPPUNIT_ASSERT(intTable.Lookup(inherited) != nullptr);
+    CPPUNIT_ASSERT_EQUAL(objClass->LookupInvokable(inherited),
+                         intTable.Lookup(inherited));
+
+    // defined by Integer itself
+    VMSymbol* own = SymbolFor("+");
+    CPPUNIT_ASSERT_EQUAL(intClass->LookupInvokable(own), intTable.Lookup(own));
+
+    CPPUNIT_ASSERT(intTable.Lookup(SymbolFor("notUnderstood")) == nullptr);
+
+    intTable.WalkObjects(collectMembers);
+    CPPUNIT_ASSERT(WalkerHasFound(tmp_ptr(inherited)));
+    CPPUNIT_ASSERT(WalkerHasFound(tmp_ptr(intTable.Lookup(own))));
+}
+
+static gc_oop_t movedLiteral;
+
+/*
+ * Moves all objects to movedLiteral, like a moving GC would
+ */
+static gc_oop_t moveToLiteral(gc_oop_t /*unused*/) {
+    return movedLiteral;
+}
+
+void WalkObjectsTest::testWalkMethodWithDecodedBytecodes() {
+    VMSymbol* methodSymbol = NewSymbol("methodWithLiteral");
+
+    vector<BackJump> inlinedLoops;
+    VMMethod* method =
+        Universe::NewMethod(methodSymbol, 2, 1, 0, 1,
+                            new LexicalScope(nullptr, {}, {}), inlinedLoops);
+    method->SetHolder(load_ptr(symbolClass));
+    method->SetBytecode(0, BC_PUSH_CONSTANT_0);
+    method->SetBytecode(1, BC_RETURN_LOCAL);
+    method->SetIndexableField(0, NewSymbol("literal"));
+
+    vector<void const*> const handlers(256, nullptr);
+    DecodedBytecode* decoded = method->GetDecodedBytecodes(handlers.data());
+    CPPUNIT_ASSERT_EQUAL(method->GetIndexableField(0),
+                         load_ptr(decoded[0].literal));
+
+    movedLiteral = tmp_ptr(NewSymbol("moved"));
+    method->WalkObjects(moveToLiteral);
+
+    CPPUNIT_ASSERT_EQUAL(load_ptr(movedLiteral), method->GetIndexableField(0));
+    CPPUNIT_ASSERT_EQUAL(load_ptr(movedLiteral), load_ptr(decoded[0].literal));
+}
+
 void WalkObjectsTest::testWalkBlock() {
     walkedObjects.clear();
     VMSymbol* methodSymbol = NewSymbol("someMethod");
@@ -249,3 +427,23 @@ void WalkObjectsTest::testWalkArray() {
     CPPUNIT_ASSERT(WalkerHasFound(tmp_ptr(str1)));
     CPPUNIT_ASSERT(WalkerHasFound(tmp_ptr(int1)));
 }
+
+void WalkObjectsTest::testWalkAssociation() {
+    walkedObjects.clear();
+    VMSymbol* key = SymbolFor("UnboundGlobalForWalk");
+    VMAssociation* association = Universe::GetGlobalAssociation(key);
+    association->WalkObjects(collectMembers);
+
+    // an unbound association only has its key
+    CPPUNIT_ASSERT_EQUAL((size_t)1, walkedObjects.size());
+    CPPUNIT_ASSERT(WalkerHasFound(tmp_ptr(key)));
+
+    walkedObjects.clear();
+    VMInteger* int1 = Universe::NewInteger(42);
+    Universe::SetGlobal(key, int1);
+    association->WalkObjects(collectMembers);
+
+    CPPUNIT_ASSERT_EQUAL((size_t)2, walkedObjects.size());
+    CPPUNIT_ASSERT(WalkerHasFound(tmp_ptr(key)));
+    CPPUNIT_ASSERT(WalkerHasFound(tmp_ptr(int1)));
+}
@@ -24,14 +24,21 @@ using namespace std;
 class WalkObjectsTest : public CPPUNIT_NS::TestCase {
     CPPUNIT_TEST_SUITE(WalkObjectsTest);  // NOLINT(misc-const-correctness)
     CPPUNIT_TEST(testWalkArray);
+    CPPUNIT_TEST(testWalkAssociation);
     CPPUNIT_TEST(testWalkBlock);
     CPPUNIT_TEST(testWalkClass);
     CPPUNIT_TEST(testWalkDouble);
     CPPUNIT_TEST(testWalkEvaluationPrimitive);
     CPPUNIT_TEST(testWalkFrame);
+    CPPUNIT_TEST(testWalkFrameStack);
+    CPPUNIT_TEST(testFramePool);
     CPPUNIT_TEST(testWalkInteger);
     CPPUNIT_TEST(testWalkString);
     CPPUNIT_TEST(testWalkMethod);
+    CPPUNIT_TEST(testWalkMethodWithInlineCache);
+    CPPUNIT_TEST(testWalkMethodCache);
+    CPPUNIT_TEST(testWalkDispatchTable);
+    CPPUNIT_TEST(testWalkMethodWithDecodedBytecodes);
     CPPUNIT_TEST(testWalkObject);
     CPPUNIT_TEST(testWalkPrimitive);
     CPPUNIT_TEST(testWalkSymbol);
@@ -43,14 +50,21 @@ public:
 
 private:
     static void testWalkArray();
+    static void testWalkAssociation();
     static void testWalkBlock();
     static void testWalkClass();
     static void testWalkDouble();
     static void testWalkEvaluationPrimitive();
     static void testWalkFrame();
+    static void testWalkFrameStack();
+    static void testFramePool();
     static void testWalkInteger();
     static void testWalkString();
     static void testWalkMethod();
+    static void testWalkMethodWithInlineCache();
+    static void testWalkMethodCache();
+    static void testWalkDispatchTable();
+    static void testWalkMethodWithDecodedBytecodes();
     static void testWalkObject();
     static void testWalkPrimitive();
     static void testWalkSymbol();
@@ -0,0 +1,94 @@
+#include "WorkStealingDequeTest.h"
+
+#include <atomic>
+#include <cppunit/TestAssert.h>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+#include "../memory/WorkStealingDeque.h"
+
+void WorkStealingDequeTest::testPushPop() {
+    WorkStealingDeque<size_t> deque(4);
+    size_t elements[3] = {0, 1, 2};
+
+    CPPUNIT_ASSERT(deque.IsEmpty());
+    CPPUNIT_ASSERT(deque.Pop() == nullptr);
+    CPPUNIT_ASSERT(deque.Steal() == nullptr);
+
+    deque.Push(&elements[0]);
+    deque.Push(&elements[1]);
+    deque.Push(&elements[2]);
+    CPPUNIT_ASSERT(!deque.IsEmpty());
+
+    // the owner takes the newest element, thieves take the oldest one
+    CPPUNIT_ASSERT_EQUAL(&elements[2], deque.Pop());
+    CPPUNIT_ASSERT_EQUAL(&elements[0], deque.Steal());
+    CPPUNIT_ASSERT_EQUAL(&elements[1], deque.Pop());
+    CPPUNIT_ASSERT(deque.Pop() == nullptr);
+    CPPUNIT_ASSERT(deque.IsEmpty());
+}
+
+void WorkStealingDequeTest::testGrow() {
+    WorkStealingDeque<size_t> deque(4);
+    vector<size_t> elements(100);
+
+    for (size_t& element : elements) {
+        deque.Push(&element);
+    }
+    for (size_t i = 0; i < 50; i += 1) {
+        CPPUNIT_ASSERT_EQUAL(&elements[i], deque.Steal());
+    }
+    for (size_t i = 99; i >= 50; i -= 1) {
+        CPPUNIT_ASSERT_EQUAL(&elements[i], deque.Pop());
+    }
+    CPPUNIT_ASSERT(deque.IsEmpty());
+}
+
+void WorkStealingDequeTest::testConcurrentSteal() {
+    WorkStealingDeque<size_t> deque(4);
+    size_t const numberOfElements = 100000;
+    vector<size_t> elements(numberOfElements, 0);
+
+    // each element must be taken exactly once, either by the owner or by
+    // one of the thieves
+    std::atomic<size_t> taken{0};
+    std::atomic<bool> done{false};
+    vector<std::thread> thieves;
+    for (size_t i = 0; i < 3; i += 1) {
+        thieves.emplace_back([&deque, &taken, &done] {
+            while (!done || !deque.IsEmpty()) {
+                size_t* element = deque.Steal();
+                if (element != nullptr) {
+                    *element += 1;
+                    taken += 1;
+                }
+            }
+        });
+    }
+
+    for (size_t i = 0; i < numberOfElements; i += 1) {
+        deque.Push(&elements[i]);
+        if (i % 3 == 0) {
+            size_t* element = deque.Pop();
+            if (element != nullptr) {
+                *element += 1;
+                taken += 1;
+            }
+        }
+    }
+    while (size_t* element = deque.Pop()) {
+        *element += 1;
+        taken += 1;
+    }
+
+    done = true;
+    for (std::thread& thief : thieves) {
+        thief.join();
+    }
+
+    CPPUNIT_ASSERT_EQUAL(numberOfElements, taken.load());
+    for (size_t const element : elements) {
+        CPPUNIT_ASSERT_EQUAL((size_t)1, element);
+    }
+}
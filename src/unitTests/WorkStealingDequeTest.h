@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cppunit/extensions/HelperMacros.h>
+
+using namespace std;
+
+class WorkStealingDequeTest : public CPPUNIT_NS::TestCase {
+    CPPUNIT_TEST_SUITE(WorkStealingDequeTest);
+    CPPUNIT_TEST(testPushPop);
+    CPPUNIT_TEST(testGrow);
+    CPPUNIT_TEST(testConcurrentSteal);
+    CPPUNIT_TEST_SUITE_END();
+
+private:
+    static void testPushPop();
+    static void testGrow();
+    static void testConcurrentSteal();
+};
@@ -3,6 +3,8 @@
 #if GC_TYPE == GENERATIONAL
 
   #include <cppunit/TestAssert.h>
+  #include <cstddef>
+  #include <cstdint>
   #include <utility>
   #include <vector>
 
@@ -68,6 +70,23 @@ void WriteBarrierTest::testWriteArray() {
                    load_ptr(nilObject));
 }
 
+void WriteBarrierTest::testCardMarking() {
+    // an array that is too big for the nursery is allocated as old object
+    size_t const size =
+        GetHeap<HEAP_CLS>()->GetMaxNurseryObjectSize() / sizeof(gc_oop_t);
+    VMArray* arr = Universe::NewArray(size);
+    VMString* young = Universe::NewString("young");
+
+    size_t const index = size - 1;
+    arr->SetIndexableField(index, young);
+
+    void* slot = SHIFTED_PTR(arr, sizeof(VMArray) + (index * sizeof(gc_oop_t)));
+    CPPUNIT_ASSERT_EQUAL((uint8_t)CARD_DIRTY,
+                         *GenerationalHeap::CardFor(arr, slot));
+    CPPUNIT_ASSERT_EQUAL((uint8_t)CARD_CLEAN,
+                         *GenerationalHeap::CardFor(arr, arr));
+}
+
 void WriteBarrierTest::testWriteBlock() {
     if (!DEBUG) {
         CPPUNIT_FAIL(
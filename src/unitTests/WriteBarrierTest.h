@@ -9,6 +9,7 @@ using namespace std;
 class WriteBarrierTest : public CPPUNIT_NS::TestCase {
     CPPUNIT_TEST_SUITE(WriteBarrierTest);  // NOLINT(misc-const-correctness)
     CPPUNIT_TEST(testWriteArray);
+    CPPUNIT_TEST(testCardMarking);
     CPPUNIT_TEST(testWriteClass);
     CPPUNIT_TEST(testWriteBlock);
     CPPUNIT_TEST(testWriteFrame);
@@ -22,6 +23,7 @@ public:
 
 private:
     static void testWriteArray();
+    static void testCardMarking();
     static void testWriteClass();
     static void testWriteBlock();
     static void testWriteFrame();
@@ -23,8 +23,10 @@
 #include "CloneObjectsTest.h"
 #include "HashingTest.h"
 #include "InfIntTests.h"
+#include "MatureSpaceTest.h"
 #include "TrivialMethodTest.h"
 #include "WalkObjectsTest.h"
+#include "WorkStealingDequeTest.h"
 
 #if GC_TYPE == GENERATIONAL
   #include "WriteBarrierTest.h"
@@ -40,6 +42,8 @@ CPPUNIT_TEST_SUITE_REGISTRATION(BytecodeGenerationTest);
 CPPUNIT_TEST_SUITE_REGISTRATION(TrivialMethodTest);
 CPPUNIT_TEST_SUITE_REGISTRATION(BasicInterpreterTests);
 CPPUNIT_TEST_SUITE_REGISTRATION(HashingTest);
+CPPUNIT_TEST_SUITE_REGISTRATION(MatureSpaceTest);
+CPPUNIT_TEST_SUITE_REGISTRATION(WorkStealingDequeTest);
 
 int32_t main(int32_t ac, char** av) {
     Universe::Start(ac, av);
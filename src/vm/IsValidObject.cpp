@@ -9,6 +9,7 @@
 #include "../vmobjects/AbstractObject.h"
 #include "../vmobjects/ObjectFormats.h"
 #include "../vmobjects/VMArray.h"
+#include "../vmobjects/VMAssociation.h"
 #include "../vmobjects/VMBigInteger.h"
 #include "../vmobjects/VMBlock.h"
 #include "../vmobjects/VMClass.h"  // NOLINT(misc-include-cleaner) it's required to make the types complete
@@ -26,6 +27,7 @@
 #include "Globals.h"
 
 static void* vt_array;
+static void* vt_association;
 static void* vt_vector;
 static void* vt_block;
 static void* vt_class;
@@ -79,7 +81,7 @@ bool IsValidObject(vm_oop_t obj) {
              vt == vt_safe_ter_primitive || vt == vt_string ||
              vt == vt_symbol || vt == vt_literal_return ||
              vt == vt_global_return || vt == vt_getter || vt == vt_setter ||
-             vt == vt_vector;
+             vt == vt_vector || vt == vt_association;
     if (!b) {
         assert(b && "Expected vtable to be one of the known ones.");
         return false;
@@ -106,6 +108,7 @@ bool IsValidObject(vm_oop_t obj) {
 
 void set_vt_to_null() {
     vt_array = nullptr;
+    vt_association = nullptr;
     vt_vector = nullptr;
     vt_block = nullptr;
     vt_class = nullptr;
@@ -211,7 +214,7 @@ void obtain_vtables_of_known_classes(VMSymbol* someValidSymbol) {
     vt_big_integer = get_vtable(bi);
 
     auto* mth = new (GetHeap<HEAP_CLS>(), 0)
-        VMMethod(nullptr, 0, 0, 0, 0, nullptr, nullptr);
+        VMMethod(nullptr, 0, 0, 0, 0, nullptr, nullptr, 0);
     vt_method = get_vtable(mth);
     vt_object = get_vtable(load_ptr(nilObject));
 
@@ -239,8 +242,11 @@ void obtain_vtables_of_known_classes(VMSymbol* someValidSymbol) {
         VMLiteralReturn(someValidSymbol, v, someValidSymbol);
     vt_literal_return = get_vtable(lr);
 
+    auto* assoc = new (GetHeap<HEAP_CLS>(), 0) VMAssociation(someValidSymbol);
+    vt_association = get_vtable(assoc);
+
     auto* gr = new (GetHeap<HEAP_CLS>(), 0)
-        VMGlobalReturn(someValidSymbol, v, someValidSymbol);
+        VMGlobalReturn(someValidSymbol, v, assoc);
     vt_global_return = get_vtable(gr);
 
     auto* get = new (GetHeap<HEAP_CLS>(), 0) VMGetter(someValidSymbol, v, 0);
@@ -31,8 +31,10 @@
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <fstream>
 #include <iostream>
 #include <map>
+#include <set>
 #include <sstream>
 #include <string>
 #include <utility>
@@ -41,6 +43,8 @@
 #include "../compiler/Disassembler.h"
 #include "../compiler/LexicalScope.h"
 #include "../compiler/SourcecodeCompiler.h"
+#include "../interpreter/FramePool.h"
+#include "../interpreter/MethodCache.h"
 #include "../interpreter/bytecodes.h"
 #include "../lib/InfInt.h"
 #include "../memory/Heap.h"
@@ -48,6 +52,7 @@
 #include "../vmobjects/IntegerBox.h"
 #include "../vmobjects/ObjectFormats.h"
 #include "../vmobjects/VMArray.h"
+#include "../vmobjects/VMAssociation.h"
 #include "../vmobjects/VMBigInteger.h"
 #include "../vmobjects/VMBlock.h"
 #include "../vmobjects/VMClass.h"
@@ -77,13 +82,14 @@ static gc_oop_t prebuildInts[INT_CACHE_MAX_VALUE - INT_CACHE_MIN_VALUE + 1];
 
 uint8_t dumpBytecodes;
 uint8_t gcVerbosity;
+size_t gcThreads = 1;
 bool abortOnCoreLibHashMismatch = false;
 
 static std::string bm_name;
 
 static map<int64_t, int64_t> integerHist;
 
-map<GCSymbol*, gc_oop_t> Universe::globals;
+map<GCSymbol*, GCAssociation*> Universe::globals;
 map<uint8_t, GCClass*> Universe::blockClassesByNoOfArgs;
 vector<std::string> Universe::classPath;
 size_t Universe::heapSize;
@@ -121,6 +127,45 @@ void Universe::Shutdown() {
     }
 #endif
 
+#ifdef BYTECODE_HEATMAP
+    std::string file_name_sequences = std::string(bm_name);
+    file_name_sequences.append("_bytecode_sequences.csv");
+    fstream sequences_csv(file_name_sequences.c_str(), ios::out);
+
+    map<vector<uint8_t>, uint64_t> sequences;
+    set<VMClass*> seenClasses;
+    for (auto& g : globals) {
+        vm_oop_t value = load_ptr(g.second)->GetValue();
+        if (value == nullptr || IS_TAGGED(value)) {
+            continue;
+        }
+        auto* cls = dynamic_cast<VMClass*>(AS_OBJ(value));
+        if (cls == nullptr || !seenClasses.insert(cls).second) {
+            continue;
+        }
+        for (VMClass* c : {cls, cls->GetClass()}) {
+            size_t const numInvokables = c->GetNumberOfInstanceInvokables();
+            for (size_t i = 0; i < numInvokables; i++) {
+                auto* method =
+                    dynamic_cast<VMMethod*>(c->GetInstanceInvokable(i));
+                if (method != nullptr) {
+                    method->CountBytecodeSequences(sequences);
+                }
+            }
+        }
+    }
+
+    for (auto& [sequence, count] : sequences) {
+        std::string names;
+        for (uint8_t const bc : sequence) {
+            std::string name = Bytecode::GetBytecodeName(bc);
+            name.erase(name.find_last_not_of(' ') + 1);
+            names += names.empty() ? name : " " + name;
+        }
+        sequences_csv << names << ", " << count << endl;
+    }
+#endif
+
 #ifdef LOG_RECEIVER_TYPES
     std::string file_name_receivers = std::string(bm_name);
     file_name_receivers.append("_receivers.csv");
@@ -202,6 +247,14 @@ vector<std::string> Universe::handleArguments(int32_t argc, char** argv) {
             ++dumpBytecodes;
         } else if (!sawOtherArgs && strncmp(argv[i], "-cfg", 4) == 0) {
             printVmConfig();
+        } else if (!sawOtherArgs && strcmp(argv[i], "-gcthreads") == 0) {
+            if (argc == i + 1) {
+                printUsageAndExit(argv[0]);
+            }
+            // NOLINTNEXTLINE (cert-err34-c)
+            if (sscanf(argv[++i], "%zu", &gcThreads) != 1 || gcThreads == 0) {
+                printUsageAndExit(argv[0]);
+            }
         } else if (!sawOtherArgs && strncmp(argv[i], "-g", 2) == 0) {
             ++gcVerbosity;
         } else if (!sawOtherArgs && strncmp(argv[i], "-H", 2) == 0) {
@@ -304,6 +357,8 @@ void Universe::printUsageAndExit(char* executable) {
         << "         2x - print statistics upon each collection\n"
         << "         3x - print statistics and dump heap upon each collection\n"
         << "\n";
+    cout << "    -gcthreads N use N threads for garbage collection "
+            "(default: 1)\n";
     cout << "    -HxMB set the heap size to x MB (default: 1 MB)\n";
     cout << "    -HxKB set the heap size to x KB (default: 1 MB)\n";
     cout << "    -h|--help show this help\n";
@@ -422,8 +477,8 @@ void Universe::initialize(int32_t _argc, char** _argv) {
 #ifdef BYTECODE_HEATMAP
     if (dumpBytecodes != 0) {
         for (auto& g : globals) {
-            auto* cls =
-                dynamic_cast<VMClass*>((AbstractVMObject*)load_ptr(g.second));
+            auto* cls = dynamic_cast<VMClass*>(
+                (AbstractVMObject*)load_ptr(g.second)->GetValue());
             if (cls != nullptr) {
                 Disassembler::Dump(cls);
             }
@@ -570,12 +625,23 @@ vm_oop_t Universe::GetGlobal(VMSymbol* name) {
     if (it == globals.end()) {
         return nullptr;
     }
-    return load_ptr(it->second);
+    return load_ptr(it->second)->GetValue();
 }
 
 bool Universe::HasGlobal(VMSymbol* name) {
+    return GetGlobal(name) != nullptr;
+}
+
+VMAssociation* Universe::GetGlobalAssociation(VMSymbol* name) {
     auto it = globals.find(tmp_ptr(name));
-    return it != globals.end();
+    if (it != globals.end()) {
+        return load_ptr(it->second);
+    }
+
+    LOG_ALLOCATION("VMAssociation", sizeof(VMAssociation));
+    auto* association = new (GetHeap<HEAP_CLS>(), 0) VMAssociation(name);
+    globals[store_root(name)] = store_root(association);
+    return association;
 }
 
 void Universe::InitializeSystemClass(VMClass* systemClass, VMClass* superClass,
@@ -805,10 +871,11 @@ VMClass* Universe::NewClass(VMClass* classOfClass) {
 
     if (numFields != 0U) {
         size_t const additionalBytes = numFields * sizeof(VMObject*);
-        result = new (GetHeap<HEAP_CLS>(), additionalBytes)
+        result = new (GetHeap<HEAP_CLS>(),
+                      additionalBytes + DISPATCH_TABLE_SLOT)
             VMClass(numFields, additionalBytes);
     } else {
-        result = new (GetHeap<HEAP_CLS>(), 0) VMClass;
+        result = new (GetHeap<HEAP_CLS>(), DISPATCH_TABLE_SLOT) VMClass;
     }
 
     result->SetClass(classOfClass);
@@ -823,18 +890,16 @@ VMDouble* Universe::NewDouble(double value) {
 }
 
 VMFrame* Universe::NewFrame(VMFrame* previousFrame, VMMethod* method) {
-    VMFrame* result = nullptr;
-#ifdef UNSAFE_FRAME_OPTIMIZATION
-    result = load_ptr(method->GetCachedFrame());
+    size_t const length = method->GetNumberOfArguments() +
+                          method->GetNumberOfLocals() +
+                          method->GetMaximumNumberOfStackElements() +
+                          method->GetNumberOfLoopSlots();
+
+    VMFrame* result = FramePool::Allocate(length);
     if (result != nullptr) {
-        method->SetCachedFrame(nullptr);
-        result->SetPreviousFrameOnReuse(previousFrame);
+        result->Reinitialize(method, previousFrame);
         return result;
     }
-#endif
-    size_t const length = method->GetNumberOfArguments() +
-                          method->GetNumberOfLocals() +
-                          method->GetMaximumNumberOfStackElements();
 
     size_t const additionalBytes = length * sizeof(VMObject*);
     result = new (GetHeap<HEAP_CLS>(), additionalBytes)
@@ -895,8 +960,8 @@ VMBigInteger* Universe::NewBigIntegerFromInt(int64_t value) {
 }
 
 VMClass* Universe::NewMetaclassClass() {
-    auto* result = new (GetHeap<HEAP_CLS>(), 0) VMClass;
-    auto* mclass = new (GetHeap<HEAP_CLS>(), 0) VMClass;
+    auto* result = new (GetHeap<HEAP_CLS>(), DISPATCH_TABLE_SLOT) VMClass;
+    auto* mclass = new (GetHeap<HEAP_CLS>(), DISPATCH_TABLE_SLOT) VMClass;
     result->SetClass(mclass);
     mclass->SetClass(result);
 
@@ -932,6 +997,8 @@ void Universe::WalkGlobals(walk_heap_fn walk) {
     trueClass = static_cast<GCClass*>(walk(trueClass));
     falseClass = static_cast<GCClass*>(walk(falseClass));
 
+    MethodCache::WalkObjects(walk);
+
 #if CACHE_INTEGER
     for (size_t i = 0; i < (INT_CACHE_MAX_VALUE - INT_CACHE_MIN_VALUE); i++) {
   #if USE_TAGGING
@@ -942,16 +1009,16 @@ void Universe::WalkGlobals(walk_heap_fn walk) {
     }
 #endif
 
-    // walk all entries in globals map
-    map<GCSymbol*, gc_oop_t> globs = globals;
+    // walk all entries in globals map, the associations walk their values
+    map<GCSymbol*, GCAssociation*> globs = globals;
     globals.clear();
-    map<GCSymbol*, gc_oop_t>::iterator iter;
+    map<GCSymbol*, GCAssociation*>::iterator iter;
     for (iter = globs.begin(); iter != globs.end(); iter++) {
         assert(iter->second != nullptr);
 
         auto* key = static_cast<GCSymbol*>(walk(iter->first));
-        gc_oop_t val = walk(iter->second);
-        globals[key] = val;
+        auto* association = static_cast<GCAssociation*>(walk(iter->second));
+        globals[key] = association;
     }
 
     WalkSymbols(walk);
@@ -969,7 +1036,8 @@ void Universe::WalkGlobals(walk_heap_fn walk) {
 VMMethod* Universe::NewMethod(VMSymbol* signature, size_t numberOfBytecodes,
                               size_t numberOfConstants, size_t numLocals,
                               size_t maxStackDepth, LexicalScope* lexicalScope,
-                              vector<BackJump>& inlinedLoops) {
+                              vector<BackJump>& inlinedLoops,
+                              size_t numberOfLoopSlots) {
     assert(lexicalScope != nullptr &&
            "A method is expected to have a lexical scope");
 
@@ -992,7 +1060,8 @@ VMMethod* Universe::NewMethod(VMSymbol* signature, size_t numberOfBytecodes,
         numberOfBytecodes + (numberOfConstants * sizeof(VMObject*)));
     auto* result = new (GetHeap<HEAP_CLS>(), additionalBytes)
         VMMethod(signature, numberOfBytecodes, numberOfConstants, numLocals,
-                 maxStackDepth, lexicalScope, inlinedLoopsArr);
+                 maxStackDepth, lexicalScope, inlinedLoopsArr,
+                 numberOfLoopSlots);
 
     LOG_ALLOCATION("VMMethod", result->GetObjectSize());
     return result;
@@ -1011,8 +1080,9 @@ VMString* Universe::NewString(const size_t length, const char* str) {
 }
 
 VMClass* Universe::NewSystemClass() {
-    auto* systemClass = new (GetHeap<HEAP_CLS>(), 0) VMClass();
-    auto* mclass = new (GetHeap<HEAP_CLS>(), 0) VMClass();
+    auto* systemClass =
+        new (GetHeap<HEAP_CLS>(), DISPATCH_TABLE_SLOT) VMClass();
+    auto* mclass = new (GetHeap<HEAP_CLS>(), DISPATCH_TABLE_SLOT) VMClass();
 
     systemClass->SetClass(mclass);
     mclass->SetClass(load_ptr(metaClassClass));
@@ -1022,5 +1092,6 @@ VMClass* Universe::NewSystemClass() {
 }
 
 void Universe::SetGlobal(VMSymbol* name, vm_oop_t val) {
-    globals[store_root(name)] = store_root(val);
+    // the association is updated in place, methods refer to it
+    GetGlobalAssociation(name)->SetValue(val);
 }
@@ -42,6 +42,7 @@ class SourcecodeCompiler;
 // for runtime debug
 extern uint8_t dumpBytecodes;
 extern uint8_t gcVerbosity;
+extern size_t gcThreads;
 extern bool abortOnCoreLibHashMismatch;
 
 using namespace std;
@@ -81,7 +82,8 @@ public:
                                size_t numberOfConstants, size_t numLocals,
                                size_t maxStackDepth,
                                LexicalScope* /*lexicalScope*/,
-                               vector<BackJump>& inlinedLoops);
+                               vector<BackJump>& inlinedLoops,
+                               size_t numberOfLoopSlots = 0);
     static VMObject* NewInstance(VMClass* /*classOfInstance*/);
     static VMObject* NewInstanceWithoutFields();
     static VMInteger* NewInteger(int64_t /*value*/);
@@ -102,9 +104,13 @@ public:
                                       VMClass* /*superClass*/,
                                       const char* /*name*/);
 
+    /// @return the value of the global, or nullptr if it is not defined
     static vm_oop_t GetGlobal(VMSymbol* /*name*/);
     static void SetGlobal(VMSymbol* name, vm_oop_t val);
     static bool HasGlobal(VMSymbol* /*name*/);
+    /// Get the cell that holds the value of the global, which is created
+    /// unbound if the global is not defined yet.
+    static VMAssociation* GetGlobalAssociation(VMSymbol* name);
     static VMObject* InitializeGlobals();
     static VMClass* GetBlockClass();
     static VMClass* GetBlockClassWithArgs(uint8_t numberOfArguments);
@@ -146,7 +152,7 @@ private:
     static void initialize(int32_t _argc, char** _argv);
 
     static size_t heapSize;
-    static map<GCSymbol*, gc_oop_t> globals;
+    static map<GCSymbol*, GCAssociation*> globals;
 
     static map<uint8_t, GCClass*> blockClassesByNoOfArgs;
     static vector<std::string> classPath;
@@ -56,6 +56,14 @@ public:
 
     virtual void WalkObjects(walk_heap_fn /*walk*/) {}
 
+    /// Walk the references stored in [from, to), which is used to scan the
+    /// dirty cards of mature objects. Objects that do not know where their
+    /// references are walk all of them.
+    virtual void WalkObjectsInRange(walk_heap_fn walk, void* /*from*/,
+                                    void* /*to*/) {
+        WalkObjects(walk);
+    }
+
     [[nodiscard]] inline virtual VMSymbol* GetFieldName(
         size_t /*index*/) const {
         ErrorPrint("this object doesn't support GetFieldName\n");
@@ -0,0 +1,98 @@
+#include "DispatchTable.h"
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "../memory/Heap.h"
+#include "../misc/defs.h"
+#include "../vm/Globals.h"
+#include "ObjectFormats.h"
+#include "VMClass.h"
+#include "VMInvokable.h"
+#include "VMSymbol.h"
+
+size_t DispatchTable::globalEpoch = 0;
+
+DispatchTable::DispatchTable(VMClass* cls, const DispatchTable* superTable)
+    : epoch(globalEpoch) {
+    if (superTable != nullptr) {
+        numEntries = superTable->numEntries;
+        entries = superTable->entries;
+    } else {
+        entries.resize(8);
+    }
+
+    vm_oop_t nil = load_ptr(nilObject);
+    size_t const numInvokables = cls->GetNumberOfInstanceInvokables();
+    for (size_t i = 0; i < numInvokables; i += 1) {
+        VMInvokable* invokable = cls->GetInstanceInvokable(i);
+        if (invokable != nil) {
+            insert(invokable->GetSignature(), invokable);
+        }
+    }
+
+    // the table is part of the class as far as the GC is concerned
+    for (Entry const& entry : entries) {
+        if (entry.selector != nullptr) {
+            write_barrier(cls, load_ptr(entry.selector));
+            write_barrier(cls, load_ptr(entry.invokable));
+        }
+    }
+}
+
+VMInvokable* DispatchTable::Lookup(VMSymbol* selector) const {
+    size_t const mask = entries.size() - 1;
+    size_t i = (size_t)selector->GetHash() & mask;
+    while (entries[i].selector != nullptr) {
+        if (load_ptr(entries[i].selector) == selector) {
+            return load_ptr(entries[i].invokable);
+        }
+        i = (i + 1) & mask;
+    }
+    return nullptr;
+}
+
+void DispatchTable::insert(VMSymbol* selector, VMInvokable* invokable) {
+    if ((numEntries + 1) * 2 > entries.size()) {
+        grow();
+    }
+
+    size_t const mask = entries.size() - 1;
+    size_t i = (size_t)selector->GetHash() & mask;
+    while (entries[i].selector != nullptr) {
+        if (load_ptr(entries[i].selector) == selector) {
+            // overrides the inherited invokable
+            entries[i].invokable = store_root(invokable);
+            return;
+        }
+        i = (i + 1) & mask;
+    }
+
+    entries[i].selector = store_root(selector);
+    entries[i].invokable = store_root(invokable);
+    numEntries += 1;
+}
+
+void DispatchTable::grow() {
+    std::vector<Entry> old = std::move(entries);
+    entries = std::vector<Entry>(old.size() * 2);
+    numEntries = 0;
+
+    for (Entry const& entry : old) {
+        if (entry.selector != nullptr) {
+            insert(load_ptr(entry.selector), load_ptr(entry.invokable));
+        }
+    }
+}
+
+void DispatchTable::WalkObjects(walk_heap_fn walk) {
+    // the hashes are stored in the symbols, and thus the indexes do not
+    // change when the GC moves the symbols
+    for (Entry& entry : entries) {
+        if (entry.selector != nullptr) {
+            entry.selector = static_cast<GCSymbol*>(walk(entry.selector));
+            entry.invokable = static_cast<GCInvokable*>(walk(entry.invokable));
+        }
+    }
+}
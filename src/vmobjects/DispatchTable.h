@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "../misc/defs.h"
+#include "ObjectFormats.h"
+
+/**
+ * A flattened method dictionary of a class, which maps selectors to the
+ * invokables the class understands, including the inherited ones. It is an
+ * open-addressed hash table, indexed by the hash that is stored in the symbols,
+ * so that a lookup never needs to walk the superclasses.
+ *
+ * The tables are built when a class is assembled. When the methods of any
+ * class change, all tables become stale, and each is rebuilt from the table of
+ * its superclass on its next use, see VMClass::GetDispatchTable().
+ */
+class DispatchTable {
+public:
+    /// Build the table of the class, from the table of its superclass, if it
+    /// has one, and the class' own invokables.
+    DispatchTable(VMClass* cls, const DispatchTable* superTable);
+
+    [[nodiscard]] VMInvokable* Lookup(VMSymbol* selector) const;
+
+    [[nodiscard]] inline bool IsValid() const { return epoch == globalEpoch; }
+
+    void WalkObjects(walk_heap_fn walk);
+
+    /// Needs to be called whenever the methods of a class change.
+    static void InvalidateAll() { globalEpoch += 1; }
+
+private:
+    struct Entry {
+        GCSymbol* selector;
+        GCInvokable* invokable;
+    };
+
+    void insert(VMSymbol* selector, VMInvokable* invokable);
+    void grow();
+
+    static size_t globalEpoch;
+
+    size_t epoch;
+    size_t numEntries{0};
+
+    // the size is a power of two, and at least twice the number of entries
+    std::vector<Entry> entries;
+};
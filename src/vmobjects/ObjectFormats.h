@@ -106,6 +106,7 @@ __attribute__((always_inline)) inline bool VMTAGGED_INTEGER_WITHIN_RANGE_CHECK(
 // Forward definitions of VM object classes
 class AbstractVMObject;
 class VMArray;
+class VMAssociation;
 class VMVector;
 class VMBlock;
 class VMClass;
@@ -176,6 +177,7 @@ class GCObject         : public GCAbstractObject { public: typedef VMObject
 class GCFrame          : public GCAbstractObject { public: typedef VMFrame          Loaded; };
 class GCClass          : public GCObject         { public: typedef VMClass          Loaded; };
 class GCArray          : public GCObject         { public: typedef VMArray          Loaded; };
+class GCAssociation    : public GCAbstractObject { public: typedef VMAssociation    Loaded; };
 class GCVector         : public GCObject         { public: typedef VMVector         Loaded; };
 class GCBlock          : public GCObject         { public: typedef VMBlock          Loaded; };
 class GCDouble         : public GCAbstractObject { public: typedef VMDouble         Loaded; };
@@ -230,6 +232,6 @@ inline typename T::Stored* store_with_separate_barrier(T* vm_val) {
 /** Standard assignment of pointer to field, including write barrier. */
 #define store_ptr(field, val)                 \
     field = store_with_separate_barrier(val); \
-    write_barrier(this, val)
+    write_barrier_at(this, &(field), val)
 
 typedef gc_oop_t (*walk_heap_fn)(gc_oop_t);
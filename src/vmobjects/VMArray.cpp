@@ -26,6 +26,7 @@
 
 #include "../vmobjects/VMArray.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cstddef>
 #include <cstring>
@@ -69,6 +70,18 @@ VMArray* VMArray::CloneForMovingGC() const {
     return clone;
 }
 
+void VMArray::WalkObjectsInRange(walk_heap_fn walk, void* from, void* to) {
+    // the class and the indexable fields are consecutive slots
+    auto* const first = (gc_oop_t*)&clazz;
+    auto* const end = FIELDS + GetNumberOfIndexableFields();
+
+    gc_oop_t* slot = std::max(first, (gc_oop_t*)from);
+    gc_oop_t* const last = std::min(end, (gc_oop_t*)to);
+    for (; slot < last; ++slot) {
+        *slot = walk(*slot);
+    }
+}
+
 void VMArray::IndexOutOfBounds(size_t idx) const {
     ErrorExit(("Array index out of bounds: Accessing " + to_string(idx) +
                ", but array size is only " + to_string(numberOfFields) + "\n")
@@ -59,6 +59,8 @@ public:
     // VMArray doesn't need to customize `void WalkObjects(walk_heap_fn)`,
     // because it doesn't need anything special.
 
+    void WalkObjectsInRange(walk_heap_fn walk, void* from, void* to) override;
+
     [[nodiscard]] inline size_t GetNumberOfIndexableFields() const {
         return numberOfFields;
     }
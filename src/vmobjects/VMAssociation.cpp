@@ -0,0 +1,48 @@
+#include "VMAssociation.h"
+
+#include <cstdint>
+#include <string>
+
+#include "../memory/Heap.h"
+#include "../misc/defs.h"
+#include "../vm/Globals.h"
+#include "ObjectFormats.h"
+#include "VMClass.h"
+#include "VMSymbol.h"
+
+VMAssociation::VMAssociation(VMSymbol* key)
+    : key(store_with_separate_barrier(key)) {
+    write_barrier(this, key);
+}
+
+VMAssociation* VMAssociation::CloneForMovingGC() const {
+    return new (GetHeap<HEAP_CLS>(), 0 ALLOC_MATURE) VMAssociation(*this);
+}
+
+VMClass* VMAssociation::GetClass() const {
+    // never asked for by SOM code, see the class comment
+    return load_ptr(objectClass);
+}
+
+int64_t VMAssociation::GetHash() const {
+    return GetKey()->GetHash();
+}
+
+void VMAssociation::WalkObjects(walk_heap_fn walk) {
+    key = static_cast<GCSymbol*>(walk(key));
+    if (value != nullptr) {
+        value = walk(value);
+    }
+}
+
+void VMAssociation::MarkObjectAsInvalid() {
+    key = (GCSymbol*)INVALID_GC_POINTER;
+}
+
+bool VMAssociation::IsMarkedInvalid() const {
+    return key == (GCSymbol*)INVALID_GC_POINTER;
+}
+
+std::string VMAssociation::AsDebugString() const {
+    return "Association(" + GetKey()->GetStdString() + ")";
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "../misc/defs.h"
+#include "AbstractObject.h"
+#include "ObjectFormats.h"
+
+/**
+ * The cell that holds the value of a global. Methods refer to the association
+ * of a global instead of its name, so that reading a global does not need to
+ * look it up, and see when System>>#global:put: changes its value.
+ *
+ * An association exists as soon as a method refers to the global, but stays
+ * unbound, i.e., without a value, until the global is defined. Associations
+ * are internal to the VM, and do not reach SOM code.
+ */
+class VMAssociation : public AbstractVMObject {
+public:
+    typedef GCAssociation Stored;
+
+    explicit VMAssociation(VMSymbol* key);
+
+    [[nodiscard]] inline VMSymbol* GetKey() const { return load_ptr(key); }
+
+    /// @return the value of the global, or nullptr if it is not defined
+    [[nodiscard]] inline vm_oop_t GetValue() const { return load_ptr(value); }
+
+    inline void SetValue(vm_oop_t val) { store_ptr(value, val); }
+
+    [[nodiscard]] VMAssociation* CloneForMovingGC() const override;
+    [[nodiscard]] VMClass* GetClass() const override;
+
+    [[nodiscard]] inline size_t GetObjectSize() const override {
+        return sizeof(VMAssociation);
+    }
+
+    [[nodiscard]] int64_t GetHash() const override;
+
+    void WalkObjects(walk_heap_fn walk) override;
+
+    void MarkObjectAsInvalid() override;
+    [[nodiscard]] bool IsMarkedInvalid() const override;
+
+    [[nodiscard]] std::string AsDebugString() const override;
+
+private:
+    make_testable(public);
+
+    friend class JitCompiler;
+
+    GCSymbol* key;
+    gc_oop_t value{nullptr};
+};
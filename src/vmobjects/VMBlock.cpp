@@ -28,6 +28,7 @@
 
 #include <string>
 
+#include "../interpreter/FrameStack.h"
 #include "../memory/Heap.h"
 #include "../misc/defs.h"
 #include "ObjectFormats.h"
@@ -50,6 +51,16 @@ VMBlock* VMBlock::CloneForMovingGC() const {
     return clone;
 }
 
+void VMBlock::WalkObjects(walk_heap_fn walk) {
+    clazz = static_cast<GCClass*>(walk(clazz));
+    blockMethod = static_cast<GCInvokable*>(walk(blockMethod));
+
+    // the frames on the frame stack are walked as roots, see FrameStack
+    if (!FrameStack::Contains(load_ptr(context))) {
+        context = static_cast<GCFrame*>(walk(context));
+    }
+}
+
 VMInvokable* VMBlock::GetMethod() const {
     return load_ptr(blockMethod);
 }
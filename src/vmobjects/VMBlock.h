@@ -43,6 +43,8 @@ public:
 
     [[nodiscard]] VMBlock* CloneForMovingGC() const override;
 
+    void WalkObjects(walk_heap_fn walk) override;
+
     [[nodiscard]] std::string AsDebugString() const override;
 
     static VMEvaluationPrimitive* GetEvaluationPrimitive(
@@ -32,12 +32,15 @@
 #include <iostream>
 #include <string>
 
+#include "../interpreter/InlineCache.h"
+#include "../interpreter/MethodCache.h"
 #include "../memory/Heap.h"
 #include "../misc/defs.h"
 #include "../primitivesCore/PrimitiveLoader.h"
 #include "../vm/Globals.h"
 #include "../vm/IsValidObject.h"
 #include "../vm/Print.h"
+#include "DispatchTable.h"
 #include "ObjectFormats.h"
 #include "VMArray.h"
 #include "VMInvokable.h"
@@ -48,7 +51,12 @@
 const size_t VMClass::VMClassNumberOfFields = 4;
 
 // NOLINTNEXTLINE(cppcoreguidelines-pro-type-member-init, hicpp-member-init)
-VMClass::VMClass() : VMObject(VMClassNumberOfFields, sizeof(VMClass)) {}
+VMClass::VMClass()
+    : VMObject(VMClassNumberOfFields, sizeof(VMClass) + DISPATCH_TABLE_SLOT) {
+#ifdef DISPATCH_TABLES
+    dispatchTable() = nullptr;
+#endif
+}
 
 VMClass* VMClass::CloneForMovingGC() const {
     auto* clone =
@@ -63,7 +71,11 @@ VMClass* VMClass::CloneForMovingGC() const {
 // NOLINTNEXTLINE(cppcoreguidelines-pro-type-member-init, hicpp-member-init)
 VMClass::VMClass(size_t numberOfFields, size_t additionalBytes)
     : VMObject(numberOfFields + VMClassNumberOfFields,
-               additionalBytes + sizeof(VMClass)) {}
+               additionalBytes + sizeof(VMClass) + DISPATCH_TABLE_SLOT) {
+#ifdef DISPATCH_TABLES
+    dispatchTable() = nullptr;
+#endif
+}
 
 PrimInstallResult VMClass::InstallPrimitive(VMInvokable* invokable,
                                             size_t bytecodeHash,
@@ -136,6 +148,11 @@ PrimInstallResult VMClass::InstallPrimitive(VMInvokable* invokable,
     // it's a new invokable so we need to expand the invokables array.
     store_ptr(instanceInvokables,
               instInvokables->CopyAndExtendWith((vm_oop_t)invokable));
+    InlineCache::InvalidateAll();
+    MethodCache::Invalidate(invokable->GetSignature());
+#ifdef DISPATCH_TABLES
+    DispatchTable::InvalidateAll();
+#endif
 
     // set holder, since we don't call SetInstanceInvokable, which does it
     // NOLINTNEXTLINE (cppcoreguidelines-pro-type-reinterpret-cast)
@@ -158,6 +175,11 @@ VMSymbol* VMClass::GetInstanceFieldName(size_t index) const {
 
 void VMClass::SetInstanceInvokables(VMArray* invokables) {
     store_ptr(instanceInvokables, invokables);
+    InlineCache::InvalidateAll();
+    MethodCache::Flush();
+#ifdef DISPATCH_TABLES
+    DispatchTable::InvalidateAll();
+#endif
     vm_oop_t nil = load_ptr(nilObject);
 
     size_t const numInvokables = GetNumberOfInstanceInvokables();
@@ -183,38 +205,82 @@ VMInvokable* VMClass::GetInstanceInvokable(size_t index) const {
 
 void VMClass::SetInstanceInvokable(size_t index, VMInvokable* invokable) {
     load_ptr(instanceInvokables)->SetIndexableField(index, invokable);
+    InlineCache::InvalidateAll();
+#ifdef DISPATCH_TABLES
+    DispatchTable::InvalidateAll();
+#endif
 
     // NOLINTNEXTLINE (cppcoreguidelines-pro-type-reinterpret-cast)
     if (invokable != reinterpret_cast<VMInvokable*>(load_ptr(nilObject))) {
         invokable->SetHolder(this);
+        MethodCache::Invalidate(invokable->GetSignature());
+    } else {
+        MethodCache::Flush();
     }
 }
 
 VMInvokable* VMClass::LookupInvokable(VMSymbol* name) {
     assert(IsValidObject(this));
 
-    VMInvokable* invokable = name->GetCachedInvokable(this);
+    VMInvokable* invokable = MethodCache::Lookup(this, name);
     if (invokable != nullptr) {
         return invokable;
     }
 
-    size_t const numInvokables = GetNumberOfInstanceInvokables();
-    for (size_t i = 0; i < numInvokables; ++i) {
-        invokable = GetInstanceInvokable(i);
-        if (invokable->GetSignature() == name) {
-            name->UpdateCachedInvokable(this, invokable);
-            return invokable;
-        }
+#ifdef DISPATCH_TABLES
+    invokable = GetDispatchTable()->Lookup(name);
+    if (invokable != nullptr) {
+        MethodCache::Insert(this, name, invokable);
     }
+    return invokable;
+#else
+    VMClass const* cls = this;
+    while (true) {
+        size_t const numInvokables = cls->GetNumberOfInstanceInvokables();
+        for (size_t i = 0; i < numInvokables; ++i) {
+            invokable = cls->GetInstanceInvokable(i);
+            if (invokable->GetSignature() == name) {
+                // cache it for the receiver class, where the lookup started
+                MethodCache::Insert(this, name, invokable);
+                return invokable;
+            }
+        }
 
-    // look in super class
-    if (HasSuperClass()) {
-        return ((VMClass*)load_ptr(superClass))->LookupInvokable(name);
+        // look in super class
+        if (!cls->HasSuperClass()) {
+            break;
+        }
+        cls = (VMClass*)load_ptr(cls->superClass);
     }
 
     // invokable not found
     return nullptr;
+#endif
+}
+
+#ifdef DISPATCH_TABLES
+DispatchTable* VMClass::GetDispatchTable() {
+    DispatchTable*& table = dispatchTable();
+    if (table == nullptr || !table->IsValid()) {
+        DispatchTable const* superTable = nullptr;
+        if (HasSuperClass()) {
+            superTable = ((VMClass*)load_ptr(superClass))->GetDispatchTable();
+        }
+        delete table;
+        table = new DispatchTable(this, superTable);
+    }
+    return table;
+}
+
+void VMClass::WalkObjects(walk_heap_fn walk) {
+    VMObject::WalkObjects(walk);
+
+    DispatchTable* table = dispatchTable();
+    if (table != nullptr) {
+        table->WalkObjects(walk);
+    }
 }
+#endif
 
 int64_t VMClass::LookupFieldIndex(VMSymbol* name) const {
     size_t const numInstanceFields = GetNumberOfInstanceFields();
@@ -40,6 +40,14 @@
 #endif
 
 class ClassGenerationContext;
+class DispatchTable;
+
+#ifdef DISPATCH_TABLES
+  // the dispatch table is stored after the fields of a class
+  #define DISPATCH_TABLE_SLOT sizeof(DispatchTable*)
+#else
+  #define DISPATCH_TABLE_SLOT 0
+#endif
 
 enum PrimInstallResult : uint8_t {
     NULL_ARG,
@@ -79,9 +87,24 @@ public:
     void LoadPrimitives(bool showWarning);
     [[nodiscard]] VMClass* CloneForMovingGC() const override;
 
+#ifdef DISPATCH_TABLES
+    /// @return the class' dispatch table, which is rebuilt if it is stale
+    DispatchTable* GetDispatchTable();
+
+    void WalkObjects(walk_heap_fn walk) override;
+#endif
+
     [[nodiscard]] std::string AsDebugString() const override;
 
 private:
+#ifdef DISPATCH_TABLES
+    // not a field, so that the GC does not treat it as an object
+    [[nodiscard]] inline DispatchTable*& dispatchTable() {
+        return *(DispatchTable**)SHIFTED_PTR(
+            this, totalObjectSize - sizeof(DispatchTable*));
+    }
+#endif
+
     static bool hasPrimitivesFor(const std::string& cl);
     void setPrimitives(const std::string& cname, bool classSide);
     [[nodiscard]] size_t numberOfSuperInstanceFields() const;
@@ -119,6 +119,32 @@ VMFrame* VMEvaluationPrimitive::Invoke1(VMFrame* frm) {
     return nullptr;
 }
 
+VMFrame* VMEvaluationPrimitive::Invoke2(VMFrame* frm) {
+    assert(numberOfArguments == 2);
+    auto* block = static_cast<VMBlock*>(frm->GetStackElement(1));
+
+    VMFrame* context = block->GetContext();
+    VMFrame* newFrame = block->GetMethod()->Invoke2(frm);
+
+    if (newFrame != nullptr) {
+        newFrame->SetContext(context);
+    }
+    return nullptr;
+}
+
+VMFrame* VMEvaluationPrimitive::Invoke3(VMFrame* frm) {
+    assert(numberOfArguments == 3);
+    auto* block = static_cast<VMBlock*>(frm->GetStackElement(2));
+
+    VMFrame* context = block->GetContext();
+    VMFrame* newFrame = block->GetMethod()->Invoke3(frm);
+
+    if (newFrame != nullptr) {
+        newFrame->SetContext(context);
+    }
+    return nullptr;
+}
+
 std::string VMEvaluationPrimitive::AsDebugString() const {
     return "VMEvaluationPrimitive(" + to_string(numberOfArguments) + ")";
 }
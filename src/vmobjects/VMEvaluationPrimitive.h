@@ -51,6 +51,8 @@ public:
 
     VMFrame* Invoke(VMFrame* frm) override;
     VMFrame* Invoke1(VMFrame* frm) override;
+    VMFrame* Invoke2(VMFrame* frm) override;
+    VMFrame* Invoke3(VMFrame* frm) override;
     void InlineInto(MethodGenerationContext& mgenc, const Parser& parser,
                     bool mergeScope = true) final;
 
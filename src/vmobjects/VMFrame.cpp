@@ -32,12 +32,15 @@
 #include <string>
 
 #include "../compiler/Disassembler.h"
+#include "../interpreter/FrameStack.h"
 #include "../interpreter/Interpreter.h"
 #include "../memory/Heap.h"
 #include "../misc/defs.h"
 #include "../vm/Globals.h"
 #include "../vm/Print.h"
+#include "../vm/Universe.h"
 #include "ObjectFormats.h"
+#include "VMBlock.h"
 #include "VMClass.h"
 #include "VMMethod.h"
 #include "VMObject.h"
@@ -49,14 +52,19 @@
 // depth is calculated. In that case this method is called.
 VMFrame* VMFrame::EmergencyFrameFrom(VMFrame* from, size_t extraLength) {
     VMMethod* method = from->GetMethod();
+    size_t const loopSlots = method->GetNumberOfLoopSlots();
     size_t const length =
         method->GetNumberOfArguments() + method->GetNumberOfLocals() +
-        method->GetMaximumNumberOfStackElements() + extraLength;
+        method->GetMaximumNumberOfStackElements() + extraLength + loopSlots;
 
     size_t const additionalBytes = length * sizeof(VMObject*);
     auto* result = new (GetHeap<HEAP_CLS>(), additionalBytes)
         VMFrame(additionalBytes, method, from->GetPreviousFrame());
 
+    // the copy replaces a frame that is captured, or that may be captured by
+    // the unplanned send it is made for
+    result->MarkAsCaptured();
+
     // set Frame members
     result->SetContext(from->GetContext());
     result->stack_ptr =
@@ -68,8 +76,10 @@ VMFrame* VMFrame::EmergencyFrameFrom(VMFrame* from, size_t extraLength) {
 
     // all other fields are indexable via arguments
     // --> until end of Frame
-    auto* from_end = (gc_oop_t*)SHIFTED_PTR(from, from->GetObjectSize());
-    auto* result_end = (gc_oop_t*)SHIFTED_PTR(result, result->GetObjectSize());
+    auto* from_end =
+        (gc_oop_t*)SHIFTED_PTR(from, from->GetObjectSize()) - loopSlots;
+    auto* result_end =
+        (gc_oop_t*)SHIFTED_PTR(result, result->GetObjectSize()) - loopSlots;
 
     size_t i = 0;
 
@@ -83,9 +93,44 @@ VMFrame* VMFrame::EmergencyFrameFrom(VMFrame* from, size_t extraLength) {
         result->arguments[i] = nilObject;
         i++;
     }
+
+    for (size_t slot = 0; slot < loopSlots; slot += 1) {
+        *result->GetLoopSlot(slot) = *from->GetLoopSlot(slot);
+    }
     return result;
 }
 
+void VMFrame::CopyBlocksToHeap(VMFrame const* from) {
+    for (gc_oop_t* slot = arguments; slot <= stack_ptr; slot += 1) {
+        vm_oop_t value = load_ptr(*slot);
+        if (!FrameStack::Contains(value)) {
+            continue;
+        }
+
+        auto* block = static_cast<VMBlock*>(value);
+        if (block->GetContext() == from) {
+            VMInvokable* method = block->GetMethod();
+            store_ptr(*slot, Universe::NewBlock(
+                                 method, this, method->GetNumberOfArguments()));
+        }
+    }
+}
+
+void VMFrame::Reinitialize(VMMethod* meth, VMFrame* previous) {
+    // the frame may be old already, and needs the write barrier
+    store_ptr(previousFrame, previous);
+    context = nullptr;
+    outerContext = nullptr;
+    store_ptr(method, meth);
+    bytecodeIndex = 0;
+    locals = arguments + meth->GetNumberOfArguments();
+    stack_ptr = locals + meth->GetNumberOfLocals() - 1;
+
+    for (gc_oop_t* local = locals; local <= stack_ptr; local += 1) {
+        *local = nilObject;
+    }
+}
+
 VMFrame* VMFrame::CloneForMovingGC() const {
     size_t const addSpace = totalObjectSize - sizeof(VMFrame);
     auto* clone =
@@ -103,7 +148,9 @@ VMFrame* VMFrame::CloneForMovingGC() const {
 
 #if GC_TYPE == GENERATIONAL || GC_TYPE == COPYING || GC_TYPE == DEBUG_COPYING
     VMMethod const* meth = load_ptr(method);
-    if (meth->GetGCField() != 0 && meth->GetGCField() != MASK_OBJECT_IS_OLD) {
+    // the GC field may hold mark bits, for instance when the method was seen
+    // by the write barrier, only larger values are forwarding pointers
+    if (meth->GetGCField() > MASK_BITS_ALL) {
         meth = (VMMethod*)meth->GetGCField();
     }
 //    int64_t numArgs =
@@ -130,31 +177,29 @@ VMFrame* VMFrame::GetContextLevel(uint8_t lvl) {
     return current;
 }
 
-VMFrame* VMFrame::GetOuterContext() {
-    VMFrame* current = this;
-    while (current->HasContext()) {
-        current = current->GetContext();
-    }
-    return current;
-}
-
 void VMFrame::WalkObjects(walk_heap_fn walk) {
     // VMFrame is not a proper SOM object any longer, we don't have a class for
     // it. clazz = (VMClass*) walk(clazz);
 
-    if (previousFrame != nullptr) {
+    // the frames on the frame stack are walked as roots, see FrameStack
+    if (previousFrame != nullptr &&
+        !FrameStack::Contains(load_ptr(previousFrame))) {
         previousFrame = static_cast<GCFrame*>(walk(previousFrame));
     }
-    if (context != nullptr) {
+    if (context != nullptr && !FrameStack::Contains(load_ptr(context))) {
         context = static_cast<GCFrame*>(walk(context));
     }
+    if (outerContext != nullptr &&
+        !FrameStack::Contains(load_ptr(outerContext))) {
+        outerContext = static_cast<GCFrame*>(walk(outerContext));
+    }
     method = static_cast<GCMethod*>(walk(method));
 
     // all other fields are indexable via arguments array
     // --> until end of Frame
     size_t i = 0;
     while (arguments + i <= stack_ptr) {
-        if (arguments[i] != nullptr) {
+        if (arguments[i] != nullptr && !FrameStack::Contains(arguments[i])) {
             arguments[i] = walk(arguments[i]);
         }
         i++;
@@ -206,7 +251,8 @@ void VMFrame::PrintStack() const {
         print_oop(locals[local_offset + i]);
     }
 
-    auto* end = (gc_oop_t*)SHIFTED_PTR(this, totalObjectSize);
+    auto* end = (gc_oop_t*)SHIFTED_PTR(this, totalObjectSize) -
+                GetMethod()->GetNumberOfLoopSlots();
     size_t i = 0;
     while (&locals[local_offset + max + i] < end) {
         if (stack_ptr == &locals[local_offset + max + i]) {
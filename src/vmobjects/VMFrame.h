@@ -35,8 +35,10 @@
 class Universe;
 
 class VMFrame : public AbstractVMObject {
+    friend class FramePool;
     friend class Universe;
     friend class Interpreter;
+    friend class JitCompiler;
     friend class Shell;
     friend class VMMethod;
 
@@ -88,8 +90,13 @@ public:
     [[nodiscard]] inline VMFrame* GetContext() const;
     inline void SetContext(VMFrame* /*frm*/);
     [[nodiscard]] inline bool HasContext() const;
+    inline void MarkAsCaptured() { captured = true; }
+    [[nodiscard]] inline bool IsCaptured() const { return captured; }
     VMFrame* GetContextLevel(uint8_t lvl);
-    VMFrame* GetOuterContext();
+
+    /// @return the frame of the method the frame's block is defined in, or
+    ///         the frame itself if it is a method's frame
+    [[nodiscard]] inline VMFrame* GetOuterContext() const;
     [[nodiscard]] inline VMMethod* GetMethod() const;
 
     inline vm_oop_t Pop() {
@@ -110,7 +117,7 @@ public:
         return result;
     }
 
-    inline void SetTop(gc_oop_t val) { *stack_ptr = val; }
+    inline void SetTop(vm_oop_t val) { store_ptr(*stack_ptr, val); }
 
     inline void Push(vm_oop_t obj) {
         assert(RemainingStackSize() > 0);
@@ -156,6 +163,10 @@ public:
     void PrintStackTrace() const;
     void CopyArgumentsFrom(VMFrame* frame);
 
+    /// Replace the blocks on the frame stack whose context is the given frame
+    /// with copies on the heap, whose context is this frame.
+    void CopyBlocksToHeap(VMFrame const* from);
+
     inline void SetArgument(size_t argIdx, vm_oop_t value) {
         store_ptr(arguments[argIdx], value);
     }
@@ -172,7 +183,14 @@ public:
         size_t const size =
             ((size_t)this + totalObjectSize - size_t(stack_ptr)) /
             sizeof(VMObject*);
-        return size - 1;
+        return size - 1 - GetMethod()->GetNumberOfLoopSlots();
+    }
+
+    /// The unboxed counter, limit, and step of counted loops are kept at the
+    /// end of the frame, behind the stack. The GC does not see them, because
+    /// it walks the frame only up to the stack pointer.
+    [[nodiscard]] inline int64_t* GetLoopSlot(uint8_t index) {
+        return (int64_t*)SHIFTED_PTR(this, totalObjectSize) - 1 - index;
     }
 
     [[nodiscard]] std::string AsDebugString() const override;
@@ -182,6 +200,11 @@ public:
     size_t bytecodeIndex{0};
     size_t totalObjectSize;
 
+    /// Whether something else than the frame chain may refer to this frame,
+    /// for instance a block that has it as its context. Only frames that
+    /// were not captured are recycled, see FramePool.
+    bool captured{false};
+
     void ResetStackPointer() {
         VMMethod const* meth = GetMethod();
         // Set the stack pointer to its initial value thereby clearing the stack
@@ -190,15 +213,18 @@ public:
 
     void ResetBytecodeIndex();
 
-#ifdef UNSAFE_FRAME_OPTIMIZATION
-    void SetPreviousFrameOnReuse(VMFrame* previousFrame) {
-        this->previousFrame = store_root(previousFrame);
-    }
-#endif
+    /// Prepare a frame of the FramePool for a new activation of a method with
+    /// the same frame size. Only the locals are set to nil, the arguments are
+    /// copied in still, and the stack is only read up to the stack pointer.
+    void Reinitialize(VMMethod* meth, VMFrame* previous);
 
 private:
     GCFrame* previousFrame;
     GCFrame* context{nullptr};
+
+    // the end of the context chain, or nullptr for the frame itself, so that
+    // accessing self and non-local returns do not need to walk the chain
+    GCFrame* outerContext{nullptr};
     GCMethod* method;
     gc_oop_t* arguments;
     gc_oop_t* locals;
@@ -226,7 +252,22 @@ VMFrame* VMFrame::GetContext() const {
 }
 
 void VMFrame::SetContext(VMFrame* frm) {
+    if (frm == nullptr) {
+        context = nullptr;
+        outerContext = nullptr;
+        return;
+    }
+
+    frm->MarkAsCaptured();
     store_ptr(context, frm);
+    store_ptr(outerContext, frm->GetOuterContext());
+}
+
+VMFrame* VMFrame::GetOuterContext() const {
+    if (outerContext == nullptr) {
+        return const_cast<VMFrame*>(this);
+    }
+    return load_ptr(outerContext);
 }
 
 VMFrame* VMFrame::GetPreviousFrame() const {
@@ -32,6 +32,14 @@
 #include "ObjectFormats.h"
 #include "VMClass.h"
 
+VMFrame* VMInvokable::Invoke2(VMFrame* frame) {
+    return Invoke(frame);
+}
+
+VMFrame* VMInvokable::Invoke3(VMFrame* frame) {
+    return Invoke(frame);
+}
+
 bool VMInvokable::IsPrimitive() const {
     return false;
 }
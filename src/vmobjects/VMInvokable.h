@@ -35,6 +35,14 @@ class Variable;
 class VMFrame;
 class Parser;
 
+/// The core classes for which a block literal is known not to escape from the
+/// send it is passed to, see MethodGenerationContext::MarkNonEscapingBlocks().
+enum NonEscapingReceiver : uint8_t {
+    RECEIVER_ARRAY = 1,
+    RECEIVER_VECTOR = 2,
+    RECEIVER_INTEGER = 4
+};
+
 class VMInvokable : public AbstractVMObject {
 public:
     typedef GCInvokable Stored;
@@ -46,6 +54,12 @@ public:
 
     virtual VMFrame* Invoke(VMFrame*) = 0;
     virtual VMFrame* Invoke1(VMFrame*) = 0;
+
+    /// Specialized for binary and ternary sends, so that arguments can be
+    /// copied directly. Default to the generic Invoke().
+    virtual VMFrame* Invoke2(VMFrame* frame);
+    virtual VMFrame* Invoke3(VMFrame* frame);
+
     virtual void InlineInto(MethodGenerationContext& mgenc,
                             const Parser& parser, bool mergeScope = true) = 0;
     virtual void MergeScopeInto(
@@ -58,6 +72,12 @@ public:
             mgencWithInlined) { /* NOOP for everything but VMMethods */ }
     virtual const Variable* GetArgument(size_t /*unused*/, size_t /*unused*/);
 
+    /// @return whether the argument with the given index is read, directly or
+    ///         by a block
+    [[nodiscard]] virtual bool ReadsArgument(uint8_t /*unused*/) const {
+        return false; /* trivial methods do not read their arguments */
+    }
+
     [[nodiscard]] virtual uint8_t GetNumberOfArguments() const = 0;
 
     [[nodiscard]] virtual bool IsPrimitive() const;
@@ -70,6 +90,23 @@ public:
 
     virtual void SetHolder(VMClass* hld);
 
+    /// Mark this block as not escaping from the send it is the argument with
+    /// the given index of, when the receiver is one of the given classes.
+    inline void SetNonEscaping(uint8_t receivers, uint8_t argumentIndex) {
+        nonEscapingReceivers = receivers;
+        argumentIndexInSend = argumentIndex;
+    }
+
+    /// @return a combination of NonEscapingReceiver, or 0 if the block may
+    ///         escape
+    [[nodiscard]] inline uint8_t GetNonEscapingReceivers() const {
+        return nonEscapingReceivers;
+    }
+
+    [[nodiscard]] inline uint8_t GetArgumentIndexInSend() const {
+        return argumentIndexInSend;
+    }
+
     void WalkObjects(walk_heap_fn /*unused*/) override;
 
     void MarkObjectAsInvalid() override {
@@ -86,4 +123,8 @@ protected:
 
     GCSymbol* signature;
     GCClass* holder{nullptr};
+
+    // see SetNonEscaping()
+    uint8_t nonEscapingReceivers{0};
+    uint8_t argumentIndexInSend{0};
 };
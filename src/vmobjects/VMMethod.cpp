@@ -32,6 +32,7 @@
 #include <cstring>
 #include <queue>
 #include <string>
+#include <vector>
 
 #include "../compiler/BytecodeGenerator.h"
 #include "../compiler/Disassembler.h"
@@ -48,6 +49,7 @@
 #include "../vm/Universe.h"  // NOLINT(misc-include-cleaner) it's required to make the types complete
 #include "ObjectFormats.h"
 #include "Signature.h"
+#include "VMAssociation.h"
 #include "VMClass.h"
 #include "VMFrame.h"
 #include "VMObject.h"
@@ -56,18 +58,15 @@
 VMMethod::VMMethod(VMSymbol* signature, size_t bcCount,
                    size_t numberOfConstants, size_t numLocals,
                    size_t maxStackDepth, LexicalScope* lexicalScope,
-                   BackJump* inlinedLoops)
+                   BackJump* inlinedLoops, size_t numLoopSlots)
     : VMInvokable(signature), numberOfLocals(numLocals),
-      maximumNumberOfStackElements(maxStackDepth), bcLength(bcCount),
+      maximumNumberOfStackElements(maxStackDepth),
+      numberOfLoopSlots(numLoopSlots), bcLength(bcCount),
       numberOfArguments(signature == nullptr
                             ? 0
                             : Signature::GetNumberOfArguments(signature)),
       numberOfConstants(numberOfConstants), lexicalScope(lexicalScope),
-      inlinedLoops(inlinedLoops) {
-#ifdef UNSAFE_FRAME_OPTIMIZATION
-    cachedFrame = nullptr;
-#endif
-
+      inlinedLoops(inlinedLoops), inlineCaches(nullptr) {
     indexableFields = (gc_oop_t*)(&indexableFields + 2);
     for (size_t i = 0; i < numberOfConstants; ++i) {
         indexableFields[i] = nilObject;
@@ -102,35 +101,121 @@ VMMethod* VMMethod::CloneForMovingGC() const {
 void VMMethod::WalkObjects(walk_heap_fn walk) {
     VMInvokable::WalkObjects(walk);
 
-#ifdef UNSAFE_FRAME_OPTIMIZATION
-    if (cachedFrame != nullptr) {
-        cachedFrame = static_cast<GCFrame*>(walk(cachedFrame));
-    }
-#endif
-
     size_t const numIndexableFields = GetNumberOfIndexableFields();
     for (size_t i = 0; i < numIndexableFields; ++i) {
         if (indexableFields[i] != nullptr) {
             indexableFields[i] = walk(indexableFields[i]);
         }
     }
+
+    if (inlineCaches != nullptr) {
+        for (size_t i = 0; i < bcLength; ++i) {
+            if (inlineCaches[i] != nullptr) {
+                inlineCaches[i]->WalkObjects(walk);
+            }
+        }
+    }
+
+    if (decodedBytecodes != nullptr) {
+        updateDecodedLiterals();
+    }
 }
 
-#ifdef UNSAFE_FRAME_OPTIMIZATION
-GCFrame* VMMethod::GetCachedFrame() const {
-    return cachedFrame;
+/// @return the index of the literal the bytecode pushes, or the association
+///         BC_PUSH_GLOBAL reads, or -1 if it does not push a literal
+static inline int32_t pushedLiteral(const uint8_t* bytecodes,
+                                    size_t bytecodeIndex) {
+    switch (BaseBytecode(bytecodes[bytecodeIndex])) {
+        case BC_PUSH_CONSTANT:
+        case BC_PUSH_GLOBAL:
+            return bytecodes[bytecodeIndex + 1];
+        case BC_PUSH_CONSTANT_0:
+            return 0;
+        case BC_PUSH_CONSTANT_1:
+            return 1;
+        case BC_PUSH_CONSTANT_2:
+            return 2;
+        default:
+            return -1;
+    }
 }
 
-void VMMethod::SetCachedFrame(VMFrame* frame) {
-    cachedFrame = store_with_separate_barrier(frame);
-    if (frame != nullptr) {
-        frame->SetContext(nullptr);
-        frame->SetBytecodeIndex(0);
-        frame->ResetStackPointer();
-        write_barrier(this, cachedFrame);
+void VMMethod::decodeBytecodes(void const* const* handlers) {
+    decodedBytecodes = new DecodedBytecode[bcLength]();
+
+    // the bytecodes combined by a superinstruction after the first one remain
+    // in place, and are decoded like all others
+    for (size_t i = 0; i < bcLength;
+         i += Bytecode::GetBytecodeLength(bytecodes[i])) {
+        DecodeBytecode(i, handlers);
+    }
+}
+
+void VMMethod::DecodeBytecode(size_t bytecodeIndex,
+                              void const* const* handlers) {
+    if (decodedBytecodes == nullptr) {
+        // not run yet, it is decoded with all others
+        return;
+    }
+
+    uint8_t const bytecode = bytecodes[bytecodeIndex];
+    DecodedBytecode& decoded = decodedBytecodes[bytecodeIndex];
+    decoded.handler = handlers[bytecode];
+
+    // a superinstruction has the operands of its first bytecode
+    uint8_t const base = BaseBytecode(bytecode);
+
+    if (IsJumpBytecode(base)) {
+        size_t const offset =
+            base >= BC_JUMP2 ? ComputeOffset(bytecodes[bytecodeIndex + 1],
+                                             bytecodes[bytecodeIndex + 2])
+                             : bytecodes[bytecodeIndex + 1];
+        decoded.jumpTarget =
+            decodedBytecodes + (IsBackwardJumpBytecode(base)
+                                    ? bytecodeIndex - offset
+                                    : bytecodeIndex + offset);
+        if (base == BC_LOOP_START || base == BC_LOOP_NEXT) {
+            decodedBytecodes[bytecodeIndex + 3].variable.index =
+                bytecodes[bytecodeIndex + 3];
+        }
+        return;
+    }
+
+    switch (base) {
+        case BC_PUSH_LOCAL:
+        case BC_PUSH_ARGUMENT:
+        case BC_POP_LOCAL:
+        case BC_POP_ARGUMENT:
+            decoded.variable.index = bytecodes[bytecodeIndex + 1];
+            decoded.variable.contextLevel = bytecodes[bytecodeIndex + 2];
+            break;
+        case BC_PUSH_FIELD:
+        case BC_POP_FIELD:
+        case BC_INC_FIELD:
+        case BC_INC_FIELD_PUSH:
+        case BC_LOOP_COUNTER:
+            decoded.variable.index = bytecodes[bytecodeIndex + 1];
+            break;
+        default: {
+            int32_t const literal = pushedLiteral(bytecodes, bytecodeIndex);
+            if (literal >= 0) {
+                assert((size_t)literal < GetNumberOfIndexableFields());
+                decoded.literal = indexableFields[literal];
+            }
+            break;
+        }
+    }
+}
+
+void VMMethod::updateDecodedLiterals() {
+    for (size_t i = 0; i < bcLength;
+         i += Bytecode::GetBytecodeLength(bytecodes[i])) {
+        int32_t const literal = pushedLiteral(bytecodes, i);
+        if (literal >= 0) {
+            decodedBytecodes[i].literal = indexableFields[literal];
+        }
     }
 }
-#endif
 
 VMFrame* VMMethod::Invoke(VMFrame* frame) {
     // since an invokable is able to change/use the frame, we have to write
@@ -152,8 +237,30 @@ VMFrame* VMMethod::Invoke1(VMFrame* frame) {
     return frm;
 }
 
+VMFrame* VMMethod::Invoke2(VMFrame* frame) {
+    frame->SetBytecodeIndex(Interpreter::GetBytecodeIndex());
+
+    VMFrame* frm = Interpreter::PushNewFrame(this);
+    frm->SetArgument(0, frame->GetStackElement(1));
+    frm->SetArgument(1, frame->Top());
+    return frm;
+}
+
+VMFrame* VMMethod::Invoke3(VMFrame* frame) {
+    frame->SetBytecodeIndex(Interpreter::GetBytecodeIndex());
+
+    VMFrame* frm = Interpreter::PushNewFrame(this);
+    frm->SetArgument(0, frame->GetStackElement(2));
+    frm->SetArgument(1, frame->GetStackElement(1));
+    frm->SetArgument(2, frame->Top());
+    return frm;
+}
+
 void VMMethod::SetHolder(VMClass* hld) {
     VMInvokable::SetHolder(hld);
+    // the targets of super sends depend on the holder, and are invokables of
+    // the superclasses, which SetHolderAll() must not see
+    resetSuperSendTargets();
     SetHolderAll(hld);
 }
 
@@ -170,6 +277,86 @@ void VMMethod::SetHolderAll(VMClass* hld) const {
     }
 }
 
+#ifdef BYTECODE_HEATMAP
+/// The bytecode as the compiler emitted it, i.e., without superinstructions
+/// and quickening.
+static uint8_t unoptimizedBytecode(const VMMethod* method, size_t bcIdx) {
+    uint8_t const bc = BaseBytecode(method->GetBytecode(bcIdx));
+    switch (bc) {
+        case BC_SEND_PRIM_UNARY:
+        case BC_SEND_PRIM_BINARY:
+        case BC_SEND_GETTER:
+        case BC_SEND_SETTER:
+        case BC_SEND_METHOD: {
+            auto* signature =
+                static_cast<VMSymbol*>(method->GetConstant(bcIdx));
+            return SendBytecodeForArguments(
+                Signature::GetNumberOfArguments(signature));
+        }
+        default:
+            return bc;
+    }
+}
+
+static bool endsBytecodeSequence(uint8_t bc) {
+    switch (bc) {
+        case BC_HALT:
+        case BC_RETURN_LOCAL:
+        case BC_RETURN_NON_LOCAL:
+        case BC_RETURN_SELF:
+        case BC_RETURN_FIELD_0:
+        case BC_RETURN_FIELD_1:
+        case BC_RETURN_FIELD_2:
+            return true;
+        default:
+            return false;
+    }
+}
+
+void VMMethod::CountBytecodeSequences(
+    std::map<std::vector<uint8_t>, uint64_t>& counts) const {
+    std::vector<bool> const isJumpTarget =
+        GetJumpTargets(bytecodes, bcLength);
+
+    for (size_t i = 0; i < bcLength;
+         i += Bytecode::GetBytecodeLength(bytecodes[i])) {
+        // each execution of a bytecode that is not a jump target continues
+        // the sequence of bytecodes before it, so its count in the heatmap
+        // is also the count of the sequence
+        std::vector<uint8_t> sequence;
+        size_t bcIdx = i;
+        while (sequence.size() < 3 && bcIdx < bcLength &&
+               (sequence.empty() || !isJumpTarget[bcIdx])) {
+            uint8_t const bc = unoptimizedBytecode(this, bcIdx);
+            if (IsJumpBytecode(bc)) {
+                break;
+            }
+
+            sequence.push_back(bc);
+            if (sequence.size() > 1 && heatmap[bcIdx] > 0) {
+                counts[sequence] += heatmap[bcIdx];
+            }
+            if (endsBytecodeSequence(bc)) {
+                break;
+            }
+            bcIdx += Bytecode::GetBytecodeLength(bc);
+        }
+    }
+
+    size_t const numIndexableFields = GetNumberOfIndexableFields();
+    for (size_t i = 0; i < numIndexableFields; ++i) {
+        vm_oop_t o = GetIndexableField(i);
+        if (!IS_TAGGED(o)) {
+            auto* block = dynamic_cast<VMMethod*>(AS_OBJ(o));
+            // the targets of super sends belong to other classes
+            if (block != nullptr && block->GetHolder() == GetHolder()) {
+                block->CountBytecodeSequences(counts);
+            }
+        }
+    }
+}
+#endif
+
 void VMMethod::Dump(const char* indent, bool printObjects) {
     Disassembler::DumpMethod(this, indent, printObjects);
 }
@@ -213,13 +400,20 @@ void VMMethod::inlineInto(MethodGenerationContext& mgenc,
     std::priority_queue<BackJump> backJumps = createBackJumpHeap();
     std::priority_queue<BackJumpPatch> backJumpsToPatch;
 
+    // the counted loops of the block get their own slots in the outer method
+    const uint8_t loopSlotBase =
+        numberOfLoopSlots == 0
+            ? 0
+            : mgenc.ReserveLoopSlots(parser, numberOfLoopSlots);
+
     size_t i = 0;
     const size_t numBytecodes = GetNumberOfBytecodes();
     while (i < numBytecodes) {
         prepareBackJumpToCurrentAddress(backJumps, backJumpsToPatch, i, mgenc);
         patchJumpToCurrentAddress(i, jumps, mgenc);
 
-        const uint8_t bytecode = bytecodes[i];
+        // superinstructions are inlined as the bytecodes they combine
+        const uint8_t bytecode = BaseBytecode(bytecodes[i]);
         const uint8_t bcLength = Bytecode::GetBytecodeLength(bytecode);
 
         switch (bytecode) {
@@ -384,7 +578,7 @@ void VMMethod::inlineInto(MethodGenerationContext& mgenc,
                 break;
             }
             case BC_PUSH_GLOBAL: {
-                auto* const sym = (VMSymbol*)GetConstant(i);
+                auto* const sym = ((VMAssociation*)GetConstant(i))->GetKey();
                 EmitPUSHGLOBAL(mgenc, parser, sym);
                 break;
             }
@@ -392,7 +586,12 @@ void VMMethod::inlineInto(MethodGenerationContext& mgenc,
             case BC_SEND_1:
             case BC_SEND_2:
             case BC_SEND_3:
-            case BC_SEND_N: {
+            case BC_SEND_N:
+            case BC_SEND_PRIM_UNARY:
+            case BC_SEND_PRIM_BINARY:
+            case BC_SEND_GETTER:
+            case BC_SEND_SETTER:
+            case BC_SEND_METHOD: {
                 auto* const sym = (VMSymbol*)GetConstant(i);
                 EmitSEND(mgenc, parser, sym);
                 break;
@@ -402,6 +601,19 @@ void VMMethod::inlineInto(MethodGenerationContext& mgenc,
                 EmitSUPERSEND(mgenc, parser, sym);
                 break;
             }
+            case BC_ADD:
+            case BC_SUB:
+            case BC_MUL:
+            case BC_LT:
+            case BC_GT:
+            case BC_LE:
+            case BC_GE:
+            case BC_EQ:
+            case BC_EQ_EQ: {
+                auto* const sym = (VMSymbol*)GetConstant(i);
+                EmitSpecialSEND(mgenc, parser, bytecode, sym);
+                break;
+            }
             case BC_RETURN_LOCAL: {
                 // NO OP, doesn't need to be translated
                 break;
@@ -434,7 +646,9 @@ void VMMethod::inlineInto(MethodGenerationContext& mgenc,
             case BC_JUMP2_ON_NOT_NIL_TOP_TOP:
             case BC_JUMP2_ON_NIL_TOP_TOP:
             case BC_JUMP_IF_GREATER:
-            case BC_JUMP2_IF_GREATER: {
+            case BC_JUMP_IF_LESS:
+            case BC_JUMP2_IF_GREATER:
+            case BC_JUMP2_IF_LESS: {
                 // emit the jump, but instead of the offset, emit a dummy
                 const size_t idx = Emit3WithDummy(mgenc, bytecode, 0);
                 const size_t offset =
@@ -468,6 +682,28 @@ void VMMethod::inlineInto(MethodGenerationContext& mgenc,
                 mgenc.EmitBackwardsJumpOffsetToTarget(loopBeginIdx);
                 break;
             }
+            case BC_LOOP_START: {
+                const size_t idx = EmitLoopStartWithDummyOffset(
+                    mgenc, loopSlotBase + bytecodes[i + 3]);
+                const size_t offset =
+                    ComputeOffset(bytecodes[i + 1], bytecodes[i + 2]);
+                jumps.emplace(i + offset, bytecode, idx);
+                break;
+            }
+            case BC_LOOP_NEXT: {
+                const size_t loopBeginIdx = backJumpsToPatch.top().loopBeginIdx;
+                assert(backJumpsToPatch.top().backwardsJumpIdx == i &&
+                       "the jump should match with the jump instructions");
+
+                backJumpsToPatch.pop();
+                mgenc.EmitLoopNextToTarget(loopBeginIdx,
+                                           loopSlotBase + bytecodes[i + 3]);
+                break;
+            }
+            case BC_LOOP_COUNTER: {
+                EmitLoopCounter(mgenc, loopSlotBase + bytecodes[i + 1]);
+                break;
+            }
 
             case BC_HALT:
             case BC_PUSH_SELF:
@@ -538,7 +774,7 @@ void VMMethod::AdaptAfterOuterInlined(
     size_t const numBytecodes = GetNumberOfBytecodes();
 
     while (i < numBytecodes) {
-        uint8_t const bytecode = bytecodes[i];
+        uint8_t const bytecode = BaseBytecode(bytecodes[i]);
         size_t const bcLength = Bytecode::GetBytecodeLength(bytecode);
 
         switch (bytecode) {
@@ -559,6 +795,21 @@ void VMMethod::AdaptAfterOuterInlined(
             case BC_SEND_1:
             case BC_SEND_2:
             case BC_SEND_3:
+            case BC_SEND_N:
+            case BC_ADD:
+            case BC_SUB:
+            case BC_MUL:
+            case BC_LT:
+            case BC_GT:
+            case BC_LE:
+            case BC_GE:
+            case BC_EQ:
+            case BC_EQ_EQ:
+            case BC_SEND_PRIM_UNARY:
+            case BC_SEND_PRIM_BINARY:
+            case BC_SEND_GETTER:
+            case BC_SEND_SETTER:
+            case BC_SEND_METHOD:
             case BC_SUPER_SEND:
             case BC_RETURN_LOCAL:
             case BC_RETURN_NON_LOCAL:
@@ -577,6 +828,8 @@ void VMMethod::AdaptAfterOuterInlined(
             case BC_JUMP_ON_NIL_TOP_TOP:
             case BC_JUMP_ON_NOT_NIL_POP:
             case BC_JUMP_ON_NIL_POP:
+            case BC_JUMP_IF_GREATER:
+            case BC_JUMP_IF_LESS:
             case BC_JUMP_BACKWARD:
             case BC_JUMP2:
             case BC_JUMP2_ON_TRUE_TOP_NIL:
@@ -587,7 +840,12 @@ void VMMethod::AdaptAfterOuterInlined(
             case BC_JUMP2_ON_NIL_TOP_TOP:
             case BC_JUMP2_ON_NOT_NIL_POP:
             case BC_JUMP2_ON_NIL_POP:
-            case BC_JUMP2_BACKWARD: {
+            case BC_JUMP2_IF_GREATER:
+            case BC_JUMP2_IF_LESS:
+            case BC_JUMP2_BACKWARD:
+            case BC_LOOP_START:  // the loop slots are in the block's own frame
+            case BC_LOOP_NEXT:
+            case BC_LOOP_COUNTER: {
                 // these bytecodes do not use context and don't need to be
                 // adapted
                 break;
@@ -717,5 +975,79 @@ void VMMethod::MergeScopeInto(MethodGenerationContext& mgenc) {
 }
 
 size_t VMMethod::GetBytecodeHash() const {
-    return murmur3_32(bytecodes, bcLength, 0x00000000);
+    // the hash does not depend on which superinstructions were generated
+    std::vector<uint8_t> baseBytecodes(bytecodes, bytecodes + bcLength);
+    for (uint8_t& bc : baseBytecodes) {
+        bc = BaseBytecode(bc);
+    }
+    return murmur3_32(baseBytecodes.data(), bcLength, 0x00000000);
+}
+
+VMInvokable* VMMethod::resolveSuperSend(size_t bytecodeIndex) {
+    if (superSendEpoch != InlineCache::GetGlobalEpoch()) {
+        resetSuperSendTargets();
+        superSendEpoch = InlineCache::GetGlobalEpoch();
+    }
+
+    auto* signature = static_cast<VMSymbol*>(GetConstant(bytecodeIndex));
+    VMClass const* const holder = GetHolder();
+    assert(holder->HasSuperClass());
+    auto* super = (VMClass*)holder->GetSuperClass();
+
+    VMInvokable* target = super->LookupInvokable(signature);
+    if (target != nullptr) {
+        SetIndexableField(bytecodes[bytecodeIndex + 2], target);
+    }
+    return target;
+}
+
+void VMMethod::resetSuperSendTargets() {
+    vm_oop_t const nil = load_ptr(nilObject);
+    size_t i = 0;
+    while (i < bcLength) {
+        uint8_t const bc = BaseBytecode(bytecodes[i]);
+        if (bc == BC_SUPER_SEND) {
+            SetIndexableField(bytecodes[i + 2], nil);
+        }
+        i += Bytecode::GetBytecodeLength(bc);
+    }
+}
+
+bool VMMethod::PushesBlocks() const {
+    size_t i = 0;
+    while (i < bcLength) {
+        uint8_t const bc = BaseBytecode(bytecodes[i]);
+        if (bc == BC_PUSH_BLOCK) {
+            return true;
+        }
+        i += Bytecode::GetBytecodeLength(bc);
+    }
+    return false;
+}
+
+bool VMMethod::ReadsArgument(uint8_t index) const {
+    size_t i = 0;
+    while (i < bcLength) {
+        uint8_t const bc = BaseBytecode(bytecodes[i]);
+        switch (bc) {
+            case BC_PUSH_BLOCK:
+                // the block may read the argument from its context
+                return true;
+            case BC_PUSH_ARG_1:
+            case BC_PUSH_ARG_2:
+                if (index == bc - BC_PUSH_ARG_1 + 1) {
+                    return true;
+                }
+                break;
+            case BC_PUSH_ARGUMENT:
+                if (bytecodes[i + 1] == index && bytecodes[i + 2] == 0) {
+                    return true;
+                }
+                break;
+            default:
+                break;
+        }
+        i += Bytecode::GetBytecodeLength(bc);
+    }
+    return false;
 }
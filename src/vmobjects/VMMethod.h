@@ -27,14 +27,21 @@
  */
 
 #include <iostream>
+#include <map>
 #include <queue>
+#include <vector>
 
 #include "../compiler/LexicalScope.h"
+#include "../interpreter/InlineCache.h"
 #include "../vm/Globals.h"
 #include "../vm/Print.h"
 #include "VMInteger.h"
 #include "VMInvokable.h"
 
+#ifdef JIT
+  #include "../jit/JitCompiler.h"
+#endif
+
 class MethodGenerationContext;
 class Interpreter;
 class Parser;
@@ -85,16 +92,42 @@ public:
 
 bool operator<(const BackJumpPatch& a, const BackJumpPatch& b);
 
+/// A bytecode with its operands decoded, as the interpreter runs it. The
+/// decoded bytecodes of a method have an entry for each byte of its bytecodes,
+/// so that both are indexed by bytecode index, but only the entry of the first
+/// byte of each bytecode is used. Only the loop bytecodes, which are jumps
+/// with a slot, keep the slot in the entry of their last byte.
+struct DecodedBytecode {
+    // the interpreter's handler of the bytecode
+    void const* handler;
+
+    union {
+        // the index and context level of a local, an argument, or a field
+        struct {
+            uint8_t index;
+            uint8_t contextLevel;
+        } variable;
+
+        // the literal pushed by BC_PUSH_CONSTANT*, or the association read by
+        // BC_PUSH_GLOBAL, kept up to date by the GC
+        gc_oop_t literal;
+
+        // the bytecode a jump continues at when it is taken
+        DecodedBytecode* jumpTarget;
+    };
+};
+
 class VMMethod : public VMInvokable {
     friend class Interpreter;
     friend class Disassembler;
+    friend class JitCompiler;
 
 public:
     typedef GCMethod Stored;
 
     VMMethod(VMSymbol* signature, size_t bcCount, size_t numberOfConstants,
              size_t numLocals, size_t maxStackDepth, LexicalScope* lexicalScope,
-             BackJump* inlinedLoops);
+             BackJump* inlinedLoops, size_t numLoopSlots);
 
     ~VMMethod() override { delete lexicalScope; }
 
@@ -116,6 +149,12 @@ public:
         return maximumNumberOfStackElements;
     }
 
+    /// The number of raw slots the counted loops of the method keep in its
+    /// frames, see VMFrame::GetLoopSlot().
+    [[nodiscard]] size_t GetNumberOfLoopSlots() const {
+        return numberOfLoopSlots;
+    }
+
     [[nodiscard]] inline uint8_t GetNumberOfArguments() const final {
         return numberOfArguments;
     }
@@ -142,10 +181,56 @@ public:
 
     inline void SetBytecode(size_t indx, uint8_t val) { bytecodes[indx] = val; }
 
-#ifdef UNSAFE_FRAME_OPTIMIZATION
-    void SetCachedFrame(VMFrame* frame);
-    GCFrame* GetCachedFrame() const;
-#endif
+    /// Get the invokable the super send at the given index binds to. It is
+    /// looked up in the superclass of the holder on first execution, and kept
+    /// in the literal that is the send's second operand. Once the methods of
+    /// any class changed, the targets of all super sends are looked up again.
+    /// @return nullptr if the superclass does not understand the selector
+    [[nodiscard]] inline VMInvokable* GetSuperSendTarget(size_t bytecodeIndex) {
+        if (likely(superSendEpoch == InlineCache::GetGlobalEpoch())) {
+            vm_oop_t const target =
+                GetIndexableField(bytecodes[bytecodeIndex + 2]);
+            if (likely(target != load_ptr(nilObject))) {
+                return static_cast<VMInvokable*>(target);
+            }
+        }
+        return resolveSuperSend(bytecodeIndex);
+    }
+
+    /// @return whether the method creates blocks, which are not inlined
+    [[nodiscard]] bool PushesBlocks() const;
+
+    [[nodiscard]] bool ReadsArgument(uint8_t index) const override;
+
+    /// Get the inline cache for the send bytecode at the given index.
+    /// The caches are allocated lazily, on first execution of a send.
+    [[nodiscard]] inline InlineCache* GetInlineCache(size_t bytecodeIndex) {
+        if (unlikely(inlineCaches == nullptr)) {
+            inlineCaches = new InlineCache*[bcLength]();
+        }
+
+        InlineCache* cache = inlineCaches[bytecodeIndex];
+        if (unlikely(cache == nullptr)) {
+            cache = new InlineCache();
+            inlineCaches[bytecodeIndex] = cache;
+        }
+        return cache;
+    }
+
+    /// Get the decoded form of the bytecodes, which the interpreter runs.
+    /// It is created lazily, when the interpreter first runs the method, with
+    /// the interpreter's handler for each bytecode. The bytecodes themselves
+    /// stay the canonical form, and a bytecode that is changed later needs to
+    /// be decoded again with DecodeBytecode().
+    [[nodiscard]] inline DecodedBytecode* GetDecodedBytecodes(
+        void const* const* handlers) {
+        if (unlikely(decodedBytecodes == nullptr)) {
+            decodeBytecodes(handlers);
+        }
+        return decodedBytecodes;
+    }
+
+    void DecodeBytecode(size_t bytecodeIndex, void const* const* handlers);
 
     void WalkObjects(walk_heap_fn /*unused*/) override;
 
@@ -159,8 +244,10 @@ public:
         store_ptr(indexableFields[idx], item);
     }
 
-    VMFrame* Invoke(VMFrame* frame) override;
-    VMFrame* Invoke1(VMFrame* frame) override;
+    VMFrame* Invoke(VMFrame* frame) final;
+    VMFrame* Invoke1(VMFrame* frame) final;
+    VMFrame* Invoke2(VMFrame* frame) final;
+    VMFrame* Invoke3(VMFrame* frame) final;
 
     void MarkObjectAsInvalid() override {
         VMInvokable::MarkObjectAsInvalid();
@@ -189,6 +276,30 @@ public:
 
     [[nodiscard]] inline uint8_t* GetBytecodes() const { return bytecodes; }
 
+#ifdef JIT
+    /// Count an invocation or a loop iteration, and compile the method once
+    /// it is hot.
+    inline void CountHotness() {
+        if (hotness < JIT_COMPILE_THRESHOLD) {
+            hotness += 1;
+            if (hotness == JIT_COMPILE_THRESHOLD) {
+                JitCompiler::Compile(this);
+            }
+        }
+    }
+
+    /// @return the entry point of the compiled code for each bytecode index,
+    ///         or nullptr if the method is not compiled
+    [[nodiscard]] inline void** GetJitEntries() const { return jitEntries; }
+#endif
+
+#ifdef BYTECODE_HEATMAP
+    /// Add how often each sequence of two and three bytecodes was executed
+    /// in this method and its blocks, as recorded in the heatmap.
+    void CountBytecodeSequences(
+        std::map<std::vector<uint8_t>, uint64_t>& counts) const;
+#endif
+
 private:
     void inlineInto(MethodGenerationContext& mgenc, const Parser& parser);
     std::priority_queue<BackJump> createBackJumpHeap();
@@ -204,12 +315,19 @@ private:
 
     make_testable(public);
 
+    void decodeBytecodes(void const* const* handlers);
+    void updateDecodedLiterals();
+
+    VMInvokable* resolveSuperSend(size_t bytecodeIndex);
+    void resetSuperSendTargets();
+
     [[nodiscard]] inline vm_oop_t GetIndexableField(size_t idx) const {
         return load_ptr(indexableFields[idx]);
     }
 
     const size_t numberOfLocals;
     const size_t maximumNumberOfStackElements;
+    const size_t numberOfLoopSlots;
     const size_t bcLength;
     const uint8_t numberOfArguments;
     const size_t numberOfConstants;
@@ -218,8 +336,18 @@ private:
     LexicalScope* lexicalScope;
     BackJump* inlinedLoops;
 
-#ifdef UNSAFE_FRAME_OPTIMIZATION
-    GCFrame* cachedFrame;
+    // indexed by bytecode index, only send bytecodes have a cache
+    InlineCache** inlineCaches;
+
+    // indexed by bytecode index, see GetDecodedBytecodes()
+    DecodedBytecode* decodedBytecodes{nullptr};
+
+    // the epoch of InlineCache in which the super sends were bound
+    size_t superSendEpoch{0};
+
+#ifdef JIT
+    uint32_t hotness{0};
+    void** jitEntries{nullptr};
 #endif
 
 #ifdef BYTECODE_HEATMAP
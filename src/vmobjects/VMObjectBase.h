@@ -15,6 +15,13 @@ protected:
 public:
     [[nodiscard]] inline size_t GetGCField() const;
     inline void SetGCField(size_t /*val*/);
+
+    /// Replace the GC field atomically, if it still has the expected value.
+    /// Otherwise, the current value is stored in expected.
+    inline bool CompareAndSwapGCField(size_t& expected, size_t val) {
+        return __atomic_compare_exchange_n(&gcfield, &expected, val, false,
+                                           __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+    }
     VMObjectBase() : VMOop() {}
     ~VMObjectBase() override = default;
 };
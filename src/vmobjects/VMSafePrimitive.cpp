@@ -46,6 +46,14 @@ VMFrame* VMSafeBinaryPrimitive::Invoke(VMFrame* frame) {
     return nullptr;
 }
 
+VMFrame* VMSafeBinaryPrimitive::Invoke2(VMFrame* frame) {
+    vm_oop_t rightObj = frame->Pop();
+    vm_oop_t leftObj = frame->Top();
+
+    frame->SetTop(prim.pointer(leftObj, rightObj));
+    return nullptr;
+}
+
 VMFrame* VMSafeBinaryPrimitive::Invoke1(VMFrame* /*frame*/) {
     ErrorExit("Unary invoke on binary primitive");
 }
@@ -64,6 +72,15 @@ VMFrame* VMSafeTernaryPrimitive::Invoke(VMFrame* frame) {
     return nullptr;
 }
 
+VMFrame* VMSafeTernaryPrimitive::Invoke3(VMFrame* frame) {
+    vm_oop_t arg2 = frame->Pop();
+    vm_oop_t arg1 = frame->Pop();
+    vm_oop_t self = frame->Top();
+
+    frame->SetTop(prim.pointer(self, arg1, arg2));
+    return nullptr;
+}
+
 VMFrame* VMSafeTernaryPrimitive::Invoke1(VMFrame* /*frame*/) {
     ErrorExit("Unary invoke on binary primitive");
 }
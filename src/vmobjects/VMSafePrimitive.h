@@ -48,6 +48,11 @@ public:
     VMFrame* Invoke(VMFrame* /*frame*/) override;
     VMFrame* Invoke1(VMFrame* /*frame*/) override;
 
+    /// Call the primitive directly, without going through a frame.
+    [[nodiscard]] inline vm_oop_t Call(vm_oop_t receiver) const {
+        return prim.pointer(receiver);
+    }
+
     [[nodiscard]] AbstractVMObject* CloneForMovingGC() const final;
 
     void MarkObjectAsInvalid() final {
@@ -76,6 +81,12 @@ public:
 
     VMFrame* Invoke(VMFrame* /*frame*/) override;
     VMFrame* Invoke1(VMFrame* /*unused*/) override;
+    VMFrame* Invoke2(VMFrame* /*frame*/) override;
+
+    /// Call the primitive directly, without going through a frame.
+    [[nodiscard]] inline vm_oop_t Call(vm_oop_t left, vm_oop_t right) const {
+        return prim.pointer(left, right);
+    }
 
     [[nodiscard]] AbstractVMObject* CloneForMovingGC() const final;
 
@@ -105,6 +116,7 @@ public:
 
     VMFrame* Invoke(VMFrame* /*frame*/) override;
     VMFrame* Invoke1(VMFrame* /*unused*/) override;
+    VMFrame* Invoke3(VMFrame* /*frame*/) override;
 
     [[nodiscard]] AbstractVMObject* CloneForMovingGC() const final;
 
@@ -36,19 +36,19 @@
 #include "ObjectFormats.h"
 #include "Signature.h"
 #include "VMClass.h"
-#include "VMInvokable.h"
 #include "VMString.h"
 
 VMSymbol::VMSymbol(const size_t length, const char* const str)
     :  // set the chars-pointer to point at the position of the first character
-      VMString((char*)((intptr_t)&cachedInvokable + (3 * sizeof(VMInvokable*))),
-               length),
+      VMString((char*)((intptr_t)&hash + sizeof(hash)), length),
       numberOfArgumentsOfSignature(
-          Signature::DetermineNumberOfArguments(str, length)) {
+          Signature::DetermineNumberOfArguments(str, length)),
+      hash(0) {
     size_t i = 0;
     for (; i < length; ++i) {
         chars[i] = str[i];
     }
+    hash = VMString::GetHash();
 }
 
 size_t VMSymbol::GetObjectSize() const {
@@ -66,21 +66,6 @@ VMClass* VMSymbol::GetClass() const {
     return load_ptr(symbolClass);
 }
 
-void VMSymbol::WalkObjects(walk_heap_fn walk) {
-    for (size_t i = 0; i < nextCachePos; i++) {
-        cachedClass_invokable[i] =
-            static_cast<GCClass*>(walk(cachedClass_invokable[i]));
-        cachedInvokable[i] =
-            static_cast<GCInvokable*>(walk(cachedInvokable[i]));
-    }
-}
-
 std::string VMSymbol::AsDebugString() const {
     return "Symbol(" + GetStdString() + ")";
 }
-
-void VMSymbol::UpdateCachedInvokable(VMClass* cls, VMInvokable* invo) {
-    store_ptr(cachedInvokable[nextCachePos], invo);
-    store_ptr(cachedClass_invokable[nextCachePos], cls);
-    nextCachePos = (nextCachePos + 1) % 3;
-}
@@ -45,33 +45,15 @@ public:
 
     [[nodiscard]] std::string AsDebugString() const override;
 
+    /// The hash of a symbol is computed once, from its characters, and is
+    /// used for the method cache, see MethodCache.
+    [[nodiscard]] inline int64_t GetHash() const final { return hash; }
+
 private:
     const uint8_t numberOfArgumentsOfSignature;
-    GCClass* cachedClass_invokable[3]{};
-    size_t nextCachePos{0};
-    GCInvokable* cachedInvokable[3]{};
-
-    inline VMInvokable* GetCachedInvokable(const VMClass* cls) const {
-        if (cls == load_ptr(cachedClass_invokable[0])) {
-            return load_ptr(cachedInvokable[0]);
-        }
-
-        if (cls == load_ptr(cachedClass_invokable[1])) {
-            return load_ptr(cachedInvokable[1]);
-        }
-
-        if (cls == load_ptr(cachedClass_invokable[2])) {
-            return load_ptr(cachedInvokable[2]);
-        }
-        return nullptr;
-    }
-
-    void UpdateCachedInvokable(VMClass* cls, VMInvokable* invo);
+    int64_t hash;
 
     friend class Signature;
-    friend class VMClass;
 
     make_testable(public);
-
-    void WalkObjects(walk_heap_fn /*unused*/) override;
 };
@@ -28,9 +28,9 @@ VMTrivialMethod* MakeLiteralReturn(VMSymbol* sig, vector<Variable>& arguments,
 }
 
 VMTrivialMethod* MakeGlobalReturn(VMSymbol* sig, vector<Variable>& arguments,
-                                  VMSymbol* globalName) {
+                                  VMAssociation* global) {
     auto* result =
-        new (GetHeap<HEAP_CLS>(), 0) VMGlobalReturn(sig, arguments, globalName);
+        new (GetHeap<HEAP_CLS>(), 0) VMGlobalReturn(sig, arguments, global);
     LOG_ALLOCATION("VMGlobalReturn", result->GetObjectSize());
     return result;
 }
@@ -92,11 +92,11 @@ VMFrame* VMGlobalReturn::Invoke(VMFrame* frame) {
         frame->Pop();
     }
 
-    vm_oop_t value = Universe::GetGlobal(load_ptr(globalName));
+    vm_oop_t value = load_ptr(global)->GetValue();
     if (value != nullptr) {
         frame->Push(value);
     } else {
-        Interpreter::SendUnknownGlobal(load_ptr(globalName));
+        Interpreter::SendUnknownGlobal(load_ptr(global)->GetKey());
     }
 
     return nullptr;
@@ -106,11 +106,11 @@ VMFrame* VMGlobalReturn::Invoke1(VMFrame* frame) {
     assert(numberOfArguments == 1);
     frame->Pop();
 
-    vm_oop_t value = Universe::GetGlobal(load_ptr(globalName));
+    vm_oop_t value = load_ptr(global)->GetValue();
     if (value != nullptr) {
         frame->Push(value);
     } else {
-        Interpreter::SendUnknownGlobal(load_ptr(globalName));
+        Interpreter::SendUnknownGlobal(load_ptr(global)->GetKey());
     }
 
     return nullptr;
@@ -118,17 +118,16 @@ VMFrame* VMGlobalReturn::Invoke1(VMFrame* frame) {
 
 void VMGlobalReturn::InlineInto(MethodGenerationContext& mgenc,
                                 const Parser& parser, bool /*mergeScope*/) {
-    EmitPUSHGLOBAL(mgenc, parser, load_ptr(globalName));
+    EmitPUSHGLOBAL(mgenc, parser, load_ptr(global)->GetKey());
 }
 
 void VMGlobalReturn::WalkObjects(walk_heap_fn walk) {
     VMInvokable::WalkObjects(walk);
-    globalName = (GCSymbol*)walk(globalName);
+    global = (GCAssociation*)walk(global);
 }
 
 std::string VMGlobalReturn::AsDebugString() const {
-    return "VMGlobalReturn(" + AS_OBJ(load_ptr(globalName))->AsDebugString() +
-           ")";
+    return "VMGlobalReturn(" + load_ptr(global)->AsDebugString() + ")";
 }
 
 AbstractVMObject* VMGlobalReturn::CloneForMovingGC() const {
@@ -4,6 +4,7 @@
 #include "../vm/Globals.h"
 #include "ObjectFormats.h"
 #include "Signature.h"
+#include "VMAssociation.h"
 #include "VMInvokable.h"
 #include "VMSymbol.h"
 
@@ -47,7 +48,7 @@ private:
 VMTrivialMethod* MakeLiteralReturn(VMSymbol* sig, vector<Variable>& arguments,
                                    vm_oop_t literal);
 VMTrivialMethod* MakeGlobalReturn(VMSymbol* sig, vector<Variable>& arguments,
-                                  VMSymbol* globalName);
+                                  VMAssociation* global);
 VMTrivialMethod* MakeGetter(VMSymbol* sig, vector<Variable>& arguments,
                             size_t fieldIndex);
 VMTrivialMethod* MakeSetter(VMSymbol* sig, vector<Variable>& arguments,
@@ -101,12 +102,12 @@ public:
     typedef GCGlobalReturn Stored;
 
     VMGlobalReturn(VMSymbol* sig, vector<Variable>& arguments,
-                   VMSymbol* globalName)
+                   VMAssociation* global)
         : VMTrivialMethod(sig, arguments),
-          globalName(store_with_separate_barrier(globalName)),
+          global(store_with_separate_barrier(global)),
           numberOfArguments(Signature::GetNumberOfArguments(sig)) {
         write_barrier(this, sig);
-        write_barrier(this, globalName);
+        write_barrier(this, global);
     }
 
     [[nodiscard]] inline size_t GetObjectSize() const override {
@@ -123,19 +124,19 @@ public:
 
     void MarkObjectAsInvalid() final {
         VMTrivialMethod::MarkObjectAsInvalid();
-        globalName = (GCSymbol*)INVALID_GC_POINTER;
+        global = (GCAssociation*)INVALID_GC_POINTER;
     }
 
     void WalkObjects(walk_heap_fn /*walk*/) override;
 
     [[nodiscard]] bool IsMarkedInvalid() const final {
-        return globalName == (GCSymbol*)INVALID_GC_POINTER;
+        return global == (GCAssociation*)INVALID_GC_POINTER;
     }
 
     [[nodiscard]] std::string AsDebugString() const final;
 
 private:
-    GCSymbol* globalName;
+    GCAssociation* global;
     uint8_t numberOfArguments;
 };
 
@@ -153,6 +154,8 @@ public:
         return sizeof(VMGetter);
     }
 
+    [[nodiscard]] inline size_t GetFieldIndex() const { return fieldIndex; }
+
     VMFrame* Invoke(VMFrame* /*frame*/) override;
     VMFrame* Invoke1(VMFrame* /*frame*/) override;
 
@@ -192,6 +195,9 @@ public:
         return sizeof(VMSetter);
     }
 
+    [[nodiscard]] inline size_t GetFieldIndex() const { return fieldIndex; }
+    [[nodiscard]] inline size_t GetArgIndex() const { return argIndex; }
+
     VMFrame* Invoke(VMFrame* /*frame*/) override;
     VMFrame* Invoke1(VMFrame* /*unused*/) override;
 